@@ -2,13 +2,56 @@ from __future__ import annotations
 import atlas_internal.core
 import numpy
 import typing
-__all__ = ['ABS', 'ADD', 'AND', 'ASTNode', 'ATRNode', 'AllocationBaseNode', 'AllocationNode', 'AllocationType', 'AllocationWeightNode', 'AssetCompNode', 'AssetCompType', 'AssetFunctionNode', 'AssetFunctionType', 'AssetIfNode', 'AssetMedianNode', 'AssetObserverNode', 'AssetOpNode', 'AssetOpType', 'AssetReadNode', 'AssetScalerNode', 'CONDITIONAL_SPLIT', 'CovarianceNode', 'CovarianceNodeBase', 'CovarianceObserverNode', 'CovarianceType', 'DIVIDE', 'DummyNode', 'EQUAL', 'EVRankNode', 'EVRankType', 'ExchangeViewFilter', 'ExchangeViewFilterType', 'ExchangeViewNode', 'FULL', 'FixedAllocationNode', 'GREATER', 'GREATER_EQUAL', 'GREATER_THAN', 'GridDimension', 'GridDimensionLimit', 'GridDimensionObserver', 'GridType', 'INCREMENTAL', 'IncrementalCovarianceNode', 'InvVolWeight', 'LESS', 'LESS_EQUAL', 'LESS_THAN', 'LOG', 'LOWER_TRIANGULAR', 'LagNode', 'LogicalType', 'MULTIPLY', 'MaxObserverNode', 'MeanObserverNode', 'NEXTREME', 'NLARGEST', 'NLV', 'NOT_EQUAL', 'NSMALLEST', 'OR', 'ORDERS_EAGER', 'POWER', 'PeriodicTriggerNode', 'SIGN', 'STOP_LOSS', 'SUBTRACT', 'SkewnessObserverNode', 'StrategyBufferOpNode', 'StrategyGrid', 'StrategyMonthlyRunnerNode', 'StrategyNode', 'SumObserverNode', 'TAKE_PROFIT', 'Tracer', 'TracerType', 'TradeLimitNode', 'TradeLimitType', 'TriggerNode', 'TsArgMaxObserverNode', 'UNIFORM', 'UPPER_TRIANGULAR', 'VOLATILITY', 'VarianceObserverNode', 'WEIGHTS']
+__all__ = ['ABS', 'ADD', 'ADX', 'ADXOutputType', 'ALPHA', 'AND', 'ASTNode', 'ATRNode', 'AdxObserverNode', 'AllocationBaseNode', 'AllocationNode', 'AllocationType', 'AllocationWeightNode', 'AssetCompNode', 'AssetCompType', 'AssetFunctionNode', 'AssetFunctionType', 'AssetIfNode', 'AssetMedianNode', 'AssetObserverNode', 'AssetObserverType', 'AssetOpNode', 'AssetOpType', 'AssetReadNode', 'AssetScalerNode', 'BETA', 'BollingerObserverNode', 'BollingerOutputType', 'CONDITIONAL_SPLIT', 'CovarianceNode', 'CovarianceNodeBase', 'CovarianceObserverNode', 'CovarianceType', 'CrossSectionOutputType', 'CrossSectionRegressionNode', 'DEMEAN', 'DIVIDE', 'DummyNode', 'EWMA', 'EWMACovarianceNode', 'EWMACovarianceObserverNode', 'EWMAMeanObserverNode', 'EWMAParamType', 'EWMAVarianceObserverNode', 'EWMAVolatilityObserverNode', 'EWMAZScoreObserverNode', 'EQUAL', 'EVRankNode', 'EVRankType', 'ExchangeViewFilter', 'ExchangeViewFilterType', 'ExchangeViewNode', 'FACTOR_RETURN', 'FITTED', 'FULL', 'FixedAllocationNode', 'GREATER', 'GREATER_EQUAL', 'GREATER_THAN', 'GridDimension', 'GridDimensionLimit', 'GridDimensionObserver', 'GridType', 'GroupNormalizeNode', 'GroupOpType', 'HALF_LIFE', 'HISTOGRAM', 'INCREMENTAL', 'IncrementalCovarianceNode', 'InvVolWeight', 'KalmanFilterObserverNode', 'KalmanModelType', 'KalmanOutputType', 'KurtosisObserverNode', 'LESS', 'LESS_EQUAL', 'LESS_THAN', 'LEVEL', 'LINE', 'LOCAL_LEVEL', 'LOCAL_TREND', 'LOG', 'LOWER', 'LOWER_TRIANGULAR', 'LagNode', 'LogicalType', 'MACDOutputType', 'MEAN', 'MINUS_DI', 'MULTIPLY', 'MacdObserverNode', 'MaxObserverNode', 'MeanObserverNode', 'MedianObserverNode', 'MinObserverNode', 'MultiWindowObserverNode', 'NEXTREME', 'NLARGEST', 'NLV', 'NOT_EQUAL', 'NSMALLEST', 'OR', 'ORDERS_EAGER', 'PERCENT_B', 'PLUS_DI', 'POWER', 'PeriodicTriggerNode', 'QuantileObserverNode', 'RANK', 'RESIDUAL', 'RESIDUAL_VOLATILITY', 'R_SQUARED', 'RegressionOutputType', 'RollingRegressionObserverNode', 'RsiObserverNode', 'SIGN', 'SIGNAL', 'SLOPE', 'SPAN', 'STOP_LOSS', 'SUBTRACT', 'SUM', 'SkewnessObserverNode', 'StochasticObserverNode', 'StrategyBufferOpNode', 'StrategyGrid', 'StrategyMonthlyRunnerNode', 'StrategyNode', 'SumObserverNode', 'TAKE_PROFIT', 'Tracer', 'TracerType', 'TradeLimitNode', 'TradeLimitType', 'TriggerNode', 'TrueRangeObserverNode', 'TsArgMaxObserverNode', 'TsArgMinObserverNode', 'TsRankObserverNode', 'UNIFORM', 'UPPER', 'UPPER_TRIANGULAR', 'VARIANCE', 'VOLATILITY', 'VarianceObserverNode', 'WEIGHTS', 'WILDER', 'WINSORIZE', 'WindowViewNode', 'ZSCORE']
+class ADXOutputType:
+    """
+    Members:
+    
+      ADX
+    
+      PLUS_DI
+    
+      MINUS_DI
+    """
+    ADX: typing.ClassVar[ADXOutputType]  # value = <ADXOutputType.ADX: 0>
+    MINUS_DI: typing.ClassVar[ADXOutputType]  # value = <ADXOutputType.MINUS_DI: 2>
+    PLUS_DI: typing.ClassVar[ADXOutputType]  # value = <ADXOutputType.PLUS_DI: 1>
+    __members__: typing.ClassVar[dict[str, ADXOutputType]]  # value = {'ADX': <ADXOutputType.ADX: 0>, 'PLUS_DI': <ADXOutputType.PLUS_DI: 1>, 'MINUS_DI': <ADXOutputType.MINUS_DI: 2>}
+    def __eq__(self, other: typing.Any) -> bool:
+        ...
+    def __getstate__(self) -> int:
+        ...
+    def __hash__(self) -> int:
+        ...
+    def __index__(self) -> int:
+        ...
+    def __init__(self, value: int) -> None:
+        ...
+    def __int__(self) -> int:
+        ...
+    def __ne__(self, other: typing.Any) -> bool:
+        ...
+    def __repr__(self) -> str:
+        ...
+    def __setstate__(self, state: int) -> None:
+        ...
+    def __str__(self) -> str:
+        ...
+    @property
+    def name(self) -> str:
+        ...
+    @property
+    def value(self) -> int:
+        ...
 class ASTNode:
     pass
 class ATRNode(StrategyBufferOpNode):
     @staticmethod
     def make(arg0: atlas_internal.core.Exchange, arg1: str, arg2: str, arg3: int) -> ATRNode:
         ...
+class AdxObserverNode(AssetObserverNode):
+    def __init__(self, id: str, high: StrategyBufferOpNode, low: StrategyBufferOpNode, close: StrategyBufferOpNode, period: int, output: ADXOutputType = ADXOutputType.ADX) -> None:
+        ...
 class AllocationBaseNode:
     def getTradeLimitNode(self) -> TradeLimitNode | None:
         ...
@@ -174,6 +217,46 @@ class AssetMedianNode(StrategyBufferOpNode):
         ...
 class AssetObserverNode(StrategyBufferOpNode):
     pass
+class AssetObserverType:
+    """
+    Members:
+    
+      SUM
+    
+      MEAN
+    
+      VARIANCE
+    """
+    MEAN: typing.ClassVar[AssetObserverType]  # value = <AssetObserverType.MEAN: 1>
+    SUM: typing.ClassVar[AssetObserverType]  # value = <AssetObserverType.SUM: 0>
+    VARIANCE: typing.ClassVar[AssetObserverType]  # value = <AssetObserverType.VARIANCE: 5>
+    __members__: typing.ClassVar[dict[str, AssetObserverType]]  # value = {'SUM': <AssetObserverType.SUM: 0>, 'MEAN': <AssetObserverType.MEAN: 1>, 'VARIANCE': <AssetObserverType.VARIANCE: 5>}
+    def __eq__(self, other: typing.Any) -> bool:
+        ...
+    def __getstate__(self) -> int:
+        ...
+    def __hash__(self) -> int:
+        ...
+    def __index__(self) -> int:
+        ...
+    def __init__(self, value: int) -> None:
+        ...
+    def __int__(self) -> int:
+        ...
+    def __ne__(self, other: typing.Any) -> bool:
+        ...
+    def __repr__(self) -> str:
+        ...
+    def __setstate__(self, state: int) -> None:
+        ...
+    def __str__(self) -> str:
+        ...
+    @property
+    def name(self) -> str:
+        ...
+    @property
+    def value(self) -> int:
+        ...
 class AssetOpNode(StrategyBufferOpNode):
     @staticmethod
     def make(arg0: StrategyBufferOpNode, arg1: StrategyBufferOpNode, arg2: AssetOpType) -> AssetOpNode:
@@ -232,6 +315,49 @@ class AssetReadNode(StrategyBufferOpNode):
 class AssetScalerNode(StrategyBufferOpNode):
     def __init__(self, arg0: StrategyBufferOpNode, arg1: AssetOpType, arg2: float) -> None:
         ...
+class BollingerObserverNode(AssetObserverNode):
+    def __init__(self, id: str, parent: StrategyBufferOpNode, window: int, num_std: float = 2.0, output: BollingerOutputType = BollingerOutputType.PERCENT_B) -> None:
+        ...
+class BollingerOutputType:
+    """
+    Members:
+    
+      UPPER
+    
+      LOWER
+    
+      PERCENT_B
+    """
+    LOWER: typing.ClassVar[BollingerOutputType]  # value = <BollingerOutputType.LOWER: 1>
+    PERCENT_B: typing.ClassVar[BollingerOutputType]  # value = <BollingerOutputType.PERCENT_B: 2>
+    UPPER: typing.ClassVar[BollingerOutputType]  # value = <BollingerOutputType.UPPER: 0>
+    __members__: typing.ClassVar[dict[str, BollingerOutputType]]  # value = {'UPPER': <BollingerOutputType.UPPER: 0>, 'LOWER': <BollingerOutputType.LOWER: 1>, 'PERCENT_B': <BollingerOutputType.PERCENT_B: 2>}
+    def __eq__(self, other: typing.Any) -> bool:
+        ...
+    def __getstate__(self) -> int:
+        ...
+    def __hash__(self) -> int:
+        ...
+    def __index__(self) -> int:
+        ...
+    def __init__(self, value: int) -> None:
+        ...
+    def __int__(self) -> int:
+        ...
+    def __ne__(self, other: typing.Any) -> bool:
+        ...
+    def __repr__(self) -> str:
+        ...
+    def __setstate__(self, state: int) -> None:
+        ...
+    def __str__(self) -> str:
+        ...
+    @property
+    def name(self) -> str:
+        ...
+    @property
+    def value(self) -> int:
+        ...
 class CovarianceNode(CovarianceNodeBase):
     pass
 class CovarianceNodeBase:
@@ -247,10 +373,13 @@ class CovarianceType:
       FULL
     
       INCREMENTAL
+    
+      EWMA
     """
+    EWMA: typing.ClassVar[CovarianceType]  # value = <CovarianceType.EWMA: 2>
     FULL: typing.ClassVar[CovarianceType]  # value = <CovarianceType.FULL: 0>
     INCREMENTAL: typing.ClassVar[CovarianceType]  # value = <CovarianceType.INCREMENTAL: 1>
-    __members__: typing.ClassVar[dict[str, CovarianceType]]  # value = {'FULL': <CovarianceType.FULL: 0>, 'INCREMENTAL': <CovarianceType.INCREMENTAL: 1>}
+    __members__: typing.ClassVar[dict[str, CovarianceType]]  # value = {'FULL': <CovarianceType.FULL: 0>, 'INCREMENTAL': <CovarianceType.INCREMENTAL: 1>, 'EWMA': <CovarianceType.EWMA: 2>}
     def __eq__(self, other: typing.Any) -> bool:
         ...
     def __getstate__(self) -> int:
@@ -277,9 +406,118 @@ class CovarianceType:
     @property
     def value(self) -> int:
         ...
+class CrossSectionOutputType:
+    """
+    Members:
+    
+      RESIDUAL
+    
+      FITTED
+    
+      FACTOR_RETURN
+    """
+    FACTOR_RETURN: typing.ClassVar[CrossSectionOutputType]  # value = <CrossSectionOutputType.FACTOR_RETURN: 2>
+    FITTED: typing.ClassVar[CrossSectionOutputType]  # value = <CrossSectionOutputType.FITTED: 1>
+    RESIDUAL: typing.ClassVar[CrossSectionOutputType]  # value = <CrossSectionOutputType.RESIDUAL: 0>
+    __members__: typing.ClassVar[dict[str, CrossSectionOutputType]]  # value = {'RESIDUAL': <CrossSectionOutputType.RESIDUAL: 0>, 'FITTED': <CrossSectionOutputType.FITTED: 1>, 'FACTOR_RETURN': <CrossSectionOutputType.FACTOR_RETURN: 2>}
+    def __eq__(self, other: typing.Any) -> bool:
+        ...
+    def __getstate__(self) -> int:
+        ...
+    def __hash__(self) -> int:
+        ...
+    def __index__(self) -> int:
+        ...
+    def __init__(self, value: int) -> None:
+        ...
+    def __int__(self) -> int:
+        ...
+    def __ne__(self, other: typing.Any) -> bool:
+        ...
+    def __repr__(self) -> str:
+        ...
+    def __setstate__(self, state: int) -> None:
+        ...
+    def __str__(self) -> str:
+        ...
+    @property
+    def name(self) -> str:
+        ...
+    @property
+    def value(self) -> int:
+        ...
+class CrossSectionRegressionNode(StrategyBufferOpNode):
+    @staticmethod
+    def make(parent: StrategyBufferOpNode, factors: list[StrategyBufferOpNode], output: CrossSectionOutputType = CrossSectionOutputType.RESIDUAL, intercept: bool = True, factor: int = 0, weights: StrategyBufferOpNode | None = None) -> CrossSectionRegressionNode:
+        ...
+    def getFactorReturnTStats(self) -> numpy.ndarray[numpy.float64[m, 1]]:
+        ...
+    def getFactorReturns(self) -> numpy.ndarray[numpy.float64[m, 1]]:
+        ...
+    def getFitCount(self) -> int:
+        ...
+    def getMeanFactorReturns(self) -> numpy.ndarray[numpy.float64[m, 1]]:
+        ...
 class DummyNode(StrategyBufferOpNode):
     def __init__(self, arg0: atlas_internal.core.Exchange) -> None:
         ...
+class EWMACovarianceNode(CovarianceNodeBase):
+    pass
+class EWMACovarianceObserverNode(AssetObserverNode):
+    def __init__(self, id: str, left_parent: StrategyBufferOpNode, right_parent: StrategyBufferOpNode, param: float, param_type: EWMAParamType = EWMAParamType.SPAN, benchmark_asset: int | None = None) -> None:
+        ...
+class EWMAMeanObserverNode(AssetObserverNode):
+    def __init__(self, id: str, parent: StrategyBufferOpNode, param: float, param_type: EWMAParamType = EWMAParamType.SPAN) -> None:
+        ...
+class EWMAParamType:
+    """
+    Members:
+    
+      SPAN
+    
+      HALF_LIFE
+    
+      WILDER
+    """
+    HALF_LIFE: typing.ClassVar[EWMAParamType]  # value = <EWMAParamType.HALF_LIFE: 1>
+    SPAN: typing.ClassVar[EWMAParamType]  # value = <EWMAParamType.SPAN: 0>
+    WILDER: typing.ClassVar[EWMAParamType]  # value = <EWMAParamType.WILDER: 2>
+    __members__: typing.ClassVar[dict[str, EWMAParamType]]  # value = {'SPAN': <EWMAParamType.SPAN: 0>, 'HALF_LIFE': <EWMAParamType.HALF_LIFE: 1>, 'WILDER': <EWMAParamType.WILDER: 2>}
+    def __eq__(self, other: typing.Any) -> bool:
+        ...
+    def __getstate__(self) -> int:
+        ...
+    def __hash__(self) -> int:
+        ...
+    def __index__(self) -> int:
+        ...
+    def __init__(self, value: int) -> None:
+        ...
+    def __int__(self) -> int:
+        ...
+    def __ne__(self, other: typing.Any) -> bool:
+        ...
+    def __repr__(self) -> str:
+        ...
+    def __setstate__(self, state: int) -> None:
+        ...
+    def __str__(self) -> str:
+        ...
+    @property
+    def name(self) -> str:
+        ...
+    @property
+    def value(self) -> int:
+        ...
+class EWMAVarianceObserverNode(AssetObserverNode):
+    def __init__(self, id: str, parent: StrategyBufferOpNode, param: float, param_type: EWMAParamType = EWMAParamType.SPAN) -> None:
+        ...
+class EWMAVolatilityObserverNode(AssetObserverNode):
+    def __init__(self, id: str, parent: StrategyBufferOpNode, param: float, param_type: EWMAParamType = EWMAParamType.SPAN) -> None:
+        ...
+class EWMAZScoreObserverNode(AssetObserverNode):
+    def __init__(self, id: str, parent: StrategyBufferOpNode, param: float, param_type: EWMAParamType = EWMAParamType.SPAN) -> None:
+        ...
 class EVRankNode(StrategyBufferOpNode):
     @staticmethod
     def make(ev: ExchangeViewNode, type: EVRankType, count: int) -> EVRankNode:
@@ -419,11 +657,142 @@ class GridType:
     @property
     def value(self) -> int:
         ...
-class IncrementalCovarianceNode(CovarianceNodeBase):
+class GroupNormalizeNode(StrategyBufferOpNode):
+    @staticmethod
+    @typing.overload
+    def make(parent: StrategyBufferOpNode, groups: list[int], op: GroupOpType, param: float = 3.0) -> GroupNormalizeNode:
+        ...
+    @staticmethod
+    @typing.overload
+    def make(parent: StrategyBufferOpNode, group_node: StrategyBufferOpNode, op: GroupOpType, param: float = 3.0) -> GroupNormalizeNode:
+        ...
+class GroupOpType:
+    """
+    Members:
+    
+      DEMEAN
+    
+      ZSCORE
+    
+      RANK
+    
+      WINSORIZE
+    """
+    DEMEAN: typing.ClassVar[GroupOpType]  # value = <GroupOpType.DEMEAN: 0>
+    RANK: typing.ClassVar[GroupOpType]  # value = <GroupOpType.RANK: 2>
+    WINSORIZE: typing.ClassVar[GroupOpType]  # value = <GroupOpType.WINSORIZE: 3>
+    ZSCORE: typing.ClassVar[GroupOpType]  # value = <GroupOpType.ZSCORE: 1>
+    __members__: typing.ClassVar[dict[str, GroupOpType]]  # value = {'DEMEAN': <GroupOpType.DEMEAN: 0>, 'ZSCORE': <GroupOpType.ZSCORE: 1>, 'RANK': <GroupOpType.RANK: 2>, 'WINSORIZE': <GroupOpType.WINSORIZE: 3>}
+    def __eq__(self, other: typing.Any) -> bool:
+        ...
+    def __getstate__(self) -> int:
+        ...
+    def __hash__(self) -> int:
+        ...
+    def __index__(self) -> int:
+        ...
+    def __init__(self, value: int) -> None:
+        ...
+    def __int__(self) -> int:
+        ...
+    def __ne__(self, other: typing.Any) -> bool:
+        ...
+    def __repr__(self) -> str:
+        ...
+    def __setstate__(self, state: int) -> None:
+        ...
+    def __str__(self) -> str:
+        ...
+    @property
+    def name(self) -> str:
+        ...
+    @property
+    def value(self) -> int:
+        ...class IncrementalCovarianceNode(CovarianceNodeBase):
     pass
 class InvVolWeight(AllocationWeightNode):
     def __init__(self, arg0: CovarianceNodeBase, arg1: float | None) -> None:
         ...
+class KalmanFilterObserverNode(AssetObserverNode):
+    def __init__(self, id: str, parent: StrategyBufferOpNode, model: KalmanModelType, process_noise: float, observation_noise: float, slope_noise: float = 0.0, output: KalmanOutputType = KalmanOutputType.LEVEL) -> None:
+        ...
+class KalmanModelType:
+    """
+    Members:
+    
+      LOCAL_LEVEL
+    
+      LOCAL_TREND
+    """
+    LOCAL_LEVEL: typing.ClassVar[KalmanModelType]  # value = <KalmanModelType.LOCAL_LEVEL: 0>
+    LOCAL_TREND: typing.ClassVar[KalmanModelType]  # value = <KalmanModelType.LOCAL_TREND: 1>
+    __members__: typing.ClassVar[dict[str, KalmanModelType]]  # value = {'LOCAL_LEVEL': <KalmanModelType.LOCAL_LEVEL: 0>, 'LOCAL_TREND': <KalmanModelType.LOCAL_TREND: 1>}
+    def __eq__(self, other: typing.Any) -> bool:
+        ...
+    def __getstate__(self) -> int:
+        ...
+    def __hash__(self) -> int:
+        ...
+    def __index__(self) -> int:
+        ...
+    def __init__(self, value: int) -> None:
+        ...
+    def __int__(self) -> int:
+        ...
+    def __ne__(self, other: typing.Any) -> bool:
+        ...
+    def __repr__(self) -> str:
+        ...
+    def __setstate__(self, state: int) -> None:
+        ...
+    def __str__(self) -> str:
+        ...
+    @property
+    def name(self) -> str:
+        ...
+    @property
+    def value(self) -> int:
+        ...
+class KalmanOutputType:
+    """
+    Members:
+    
+      LEVEL
+    
+      SLOPE
+    """
+    LEVEL: typing.ClassVar[KalmanOutputType]  # value = <KalmanOutputType.LEVEL: 0>
+    SLOPE: typing.ClassVar[KalmanOutputType]  # value = <KalmanOutputType.SLOPE: 1>
+    __members__: typing.ClassVar[dict[str, KalmanOutputType]]  # value = {'LEVEL': <KalmanOutputType.LEVEL: 0>, 'SLOPE': <KalmanOutputType.SLOPE: 1>}
+    def __eq__(self, other: typing.Any) -> bool:
+        ...
+    def __getstate__(self) -> int:
+        ...
+    def __hash__(self) -> int:
+        ...
+    def __index__(self) -> int:
+        ...
+    def __init__(self, value: int) -> None:
+        ...
+    def __int__(self) -> int:
+        ...
+    def __ne__(self, other: typing.Any) -> bool:
+        ...
+    def __repr__(self) -> str:
+        ...
+    def __setstate__(self, state: int) -> None:
+        ...
+    def __str__(self) -> str:
+        ...
+    @property
+    def name(self) -> str:
+        ...
+    @property
+    def value(self) -> int:
+        ...
+class KurtosisObserverNode(AssetObserverNode):
+    def __init__(self, arg0: str, arg1: StrategyBufferOpNode, arg2: int) -> None:
+        ...
 class LagNode(StrategyBufferOpNode):
     pass
 class LogicalType:
@@ -463,24 +832,133 @@ class LogicalType:
     @property
     def value(self) -> int:
         ...
+class MACDOutputType:
+    """
+    Members:
+    
+      LINE
+    
+      SIGNAL
+    
+      HISTOGRAM
+    """
+    HISTOGRAM: typing.ClassVar[MACDOutputType]  # value = <MACDOutputType.HISTOGRAM: 2>
+    LINE: typing.ClassVar[MACDOutputType]  # value = <MACDOutputType.LINE: 0>
+    SIGNAL: typing.ClassVar[MACDOutputType]  # value = <MACDOutputType.SIGNAL: 1>
+    __members__: typing.ClassVar[dict[str, MACDOutputType]]  # value = {'LINE': <MACDOutputType.LINE: 0>, 'SIGNAL': <MACDOutputType.SIGNAL: 1>, 'HISTOGRAM': <MACDOutputType.HISTOGRAM: 2>}
+    def __eq__(self, other: typing.Any) -> bool:
+        ...
+    def __getstate__(self) -> int:
+        ...
+    def __hash__(self) -> int:
+        ...
+    def __index__(self) -> int:
+        ...
+    def __init__(self, value: int) -> None:
+        ...
+    def __int__(self) -> int:
+        ...
+    def __ne__(self, other: typing.Any) -> bool:
+        ...
+    def __repr__(self) -> str:
+        ...
+    def __setstate__(self, state: int) -> None:
+        ...
+    def __str__(self) -> str:
+        ...
+    @property
+    def name(self) -> str:
+        ...
+    @property
+    def value(self) -> int:
+        ...
+class MacdObserverNode(AssetObserverNode):
+    def __init__(self, id: str, parent: StrategyBufferOpNode, fast: int, slow: int, signal: int, output: MACDOutputType = MACDOutputType.LINE) -> None:
+        ...
 class MaxObserverNode(AssetObserverNode):
     def __init__(self, arg0: str, arg1: StrategyBufferOpNode, arg2: int) -> None:
         ...
 class MeanObserverNode(AssetObserverNode):
     def __init__(self, arg0: str, arg1: StrategyBufferOpNode, arg2: int) -> None:
         ...
+class MedianObserverNode(AssetObserverNode):
+    def __init__(self, arg0: str, arg1: StrategyBufferOpNode, arg2: int) -> None:
+        ...
+class MinObserverNode(AssetObserverNode):
+    def __init__(self, arg0: str, arg1: StrategyBufferOpNode, arg2: int) -> None:
+        ...
+class MultiWindowObserverNode(AssetObserverNode):
+    def __init__(self, arg0: str, arg1: StrategyBufferOpNode, arg2: int) -> None:
+        ...
 class PeriodicTriggerNode(TriggerNode):
     @staticmethod
     def make(exchange: atlas_internal.core.Exchange, frequency: int) -> TriggerNode:
         ...
+class QuantileObserverNode(AssetObserverNode):
+    def __init__(self, arg0: str, arg1: StrategyBufferOpNode, arg2: int, arg3: float) -> None:
+        ...
+class RegressionOutputType:
+    """
+    Members:
+    
+      BETA
+    
+      ALPHA
+    
+      RESIDUAL_VOLATILITY
+    
+      R_SQUARED
+    """
+    ALPHA: typing.ClassVar[RegressionOutputType]  # value = <RegressionOutputType.ALPHA: 1>
+    BETA: typing.ClassVar[RegressionOutputType]  # value = <RegressionOutputType.BETA: 0>
+    RESIDUAL_VOLATILITY: typing.ClassVar[RegressionOutputType]  # value = <RegressionOutputType.RESIDUAL_VOLATILITY: 2>
+    R_SQUARED: typing.ClassVar[RegressionOutputType]  # value = <RegressionOutputType.R_SQUARED: 3>
+    __members__: typing.ClassVar[dict[str, RegressionOutputType]]  # value = {'BETA': <RegressionOutputType.BETA: 0>, 'ALPHA': <RegressionOutputType.ALPHA: 1>, 'RESIDUAL_VOLATILITY': <RegressionOutputType.RESIDUAL_VOLATILITY: 2>, 'R_SQUARED': <RegressionOutputType.R_SQUARED: 3>}
+    def __eq__(self, other: typing.Any) -> bool:
+        ...
+    def __getstate__(self) -> int:
+        ...
+    def __hash__(self) -> int:
+        ...
+    def __index__(self) -> int:
+        ...
+    def __init__(self, value: int) -> None:
+        ...
+    def __int__(self) -> int:
+        ...
+    def __ne__(self, other: typing.Any) -> bool:
+        ...
+    def __repr__(self) -> str:
+        ...
+    def __setstate__(self, state: int) -> None:
+        ...
+    def __str__(self) -> str:
+        ...
+    @property
+    def name(self) -> str:
+        ...
+    @property
+    def value(self) -> int:
+        ...
+class RollingRegressionObserverNode(AssetObserverNode):
+    def __init__(self, id: str, parent: StrategyBufferOpNode, benchmark: StrategyBufferOpNode, window: int, output: RegressionOutputType = RegressionOutputType.BETA, benchmark_asset: int | None = None) -> None:
+        ...
+class RsiObserverNode(AssetObserverNode):
+    def __init__(self, id: str, parent: StrategyBufferOpNode, period: int) -> None:
+        ...
 class SkewnessObserverNode(AssetObserverNode):
     def __init__(self, arg0: str, arg1: StrategyBufferOpNode, arg2: int) -> None:
         ...
+class StochasticObserverNode(AssetObserverNode):
+    def __init__(self, id: str, high: StrategyBufferOpNode, low: StrategyBufferOpNode, close: StrategyBufferOpNode, window: int) -> None:
+        ...
 class StrategyBufferOpNode(ASTNode):
     def address(self) -> int:
         ...
     def cache(self) -> numpy.ndarray[numpy.float64[m, n]]:
         ...
+    def getEvaluateCount(self) -> int:
+        ...
     def lag(self, arg0: int) -> StrategyBufferOpNode:
         ...
 class StrategyGrid:
@@ -618,28 +1096,57 @@ class TradeLimitType:
 class TriggerNode:
     def getMask(self) -> numpy.ndarray[numpy.int32[m, 1]]:
         ...
+class TrueRangeObserverNode(AssetObserverNode):
+    def __init__(self, id: str, high: StrategyBufferOpNode, low: StrategyBufferOpNode, close: StrategyBufferOpNode) -> None:
+        ...
 class TsArgMaxObserverNode(AssetObserverNode):
     def __init__(self, arg0: str, arg1: StrategyBufferOpNode, arg2: int) -> None:
         ...
+class TsArgMinObserverNode(AssetObserverNode):
+    def __init__(self, arg0: str, arg1: StrategyBufferOpNode, arg2: int) -> None:
+        ...
+class TsRankObserverNode(AssetObserverNode):
+    def __init__(self, arg0: str, arg1: StrategyBufferOpNode, arg2: int) -> None:
+        ...
 class VarianceObserverNode(AssetObserverNode):
     def __init__(self, arg0: str, arg1: StrategyBufferOpNode, arg2: int) -> None:
         ...
+class WindowViewNode(StrategyBufferOpNode):
+    @staticmethod
+    def make(observer: MultiWindowObserverNode, window: int, statistic: AssetObserverType) -> WindowViewNode:
+        ...
 ABS: AssetFunctionType  # value = <AssetFunctionType.ABS: 3>
 ADD: AssetOpType  # value = <AssetOpType.ADD: 0>
+ADX: ADXOutputType  # value = <ADXOutputType.ADX: 0>
+ALPHA: RegressionOutputType  # value = <RegressionOutputType.ALPHA: 1>
 AND: LogicalType  # value = <LogicalType.AND: 0>
+BETA: RegressionOutputType  # value = <RegressionOutputType.BETA: 0>
 CONDITIONAL_SPLIT: AllocationType  # value = <AllocationType.CONDITIONAL_SPLIT: 1>
+DEMEAN: GroupOpType  # value = <GroupOpType.DEMEAN: 0>
 DIVIDE: AssetOpType  # value = <AssetOpType.DIVIDE: 3>
 EQUAL: AssetCompType  # value = <AssetCompType.EQUAL: 0>
+EWMA: CovarianceType  # value = <CovarianceType.EWMA: 2>
+FACTOR_RETURN: CrossSectionOutputType  # value = <CrossSectionOutputType.FACTOR_RETURN: 2>
+FITTED: CrossSectionOutputType  # value = <CrossSectionOutputType.FITTED: 1>
 FULL: CovarianceType  # value = <CovarianceType.FULL: 0>
 GREATER: AssetCompType  # value = <AssetCompType.GREATER: 2>
 GREATER_EQUAL: AssetCompType  # value = <AssetCompType.GREATER_EQUAL: 4>
 GREATER_THAN: ExchangeViewFilterType  # value = <ExchangeViewFilterType.GREATER_THAN: 0>
+HALF_LIFE: EWMAParamType  # value = <EWMAParamType.HALF_LIFE: 1>
+HISTOGRAM: MACDOutputType  # value = <MACDOutputType.HISTOGRAM: 2>
 INCREMENTAL: CovarianceType  # value = <CovarianceType.INCREMENTAL: 1>
 LESS: AssetCompType  # value = <AssetCompType.LESS: 3>
 LESS_EQUAL: AssetCompType  # value = <AssetCompType.LESS_EQUAL: 5>
 LESS_THAN: ExchangeViewFilterType  # value = <ExchangeViewFilterType.LESS_THAN: 1>
+LEVEL: KalmanOutputType  # value = <KalmanOutputType.LEVEL: 0>
+LINE: MACDOutputType  # value = <MACDOutputType.LINE: 0>
+LOCAL_LEVEL: KalmanModelType  # value = <KalmanModelType.LOCAL_LEVEL: 0>
+LOCAL_TREND: KalmanModelType  # value = <KalmanModelType.LOCAL_TREND: 1>
 LOG: AssetFunctionType  # value = <AssetFunctionType.LOG: 4>
+LOWER: BollingerOutputType  # value = <BollingerOutputType.LOWER: 1>
 LOWER_TRIANGULAR: GridType  # value = <GridType.LOWER_TRIANGULAR: 2>
+MEAN: AssetObserverType  # value = <AssetObserverType.MEAN: 1>
+MINUS_DI: ADXOutputType  # value = <ADXOutputType.MINUS_DI: 2>
 MULTIPLY: AssetOpType  # value = <AssetOpType.MULTIPLY: 2>
 NEXTREME: EVRankType  # value = <EVRankType.NEXTREME: 2>
 NLARGEST: EVRankType  # value = <EVRankType.NLARGEST: 0>
@@ -648,12 +1155,27 @@ NOT_EQUAL: AssetCompType  # value = <AssetCompType.NOT_EQUAL: 1>
 NSMALLEST: EVRankType  # value = <EVRankType.NSMALLEST: 1>
 OR: LogicalType  # value = <LogicalType.OR: 1>
 ORDERS_EAGER: TracerType  # value = <TracerType.ORDERS_EAGER: 3>
+PERCENT_B: BollingerOutputType  # value = <BollingerOutputType.PERCENT_B: 2>
+PLUS_DI: ADXOutputType  # value = <ADXOutputType.PLUS_DI: 1>
 POWER: AssetFunctionType  # value = <AssetFunctionType.POWER: 1>
+RANK: GroupOpType  # value = <GroupOpType.RANK: 2>
+RESIDUAL: CrossSectionOutputType  # value = <CrossSectionOutputType.RESIDUAL: 0>
+RESIDUAL_VOLATILITY: RegressionOutputType  # value = <RegressionOutputType.RESIDUAL_VOLATILITY: 2>
+R_SQUARED: RegressionOutputType  # value = <RegressionOutputType.R_SQUARED: 3>
 SIGN: AssetFunctionType  # value = <AssetFunctionType.SIGN: 0>
+SIGNAL: MACDOutputType  # value = <MACDOutputType.SIGNAL: 1>
+SLOPE: KalmanOutputType  # value = <KalmanOutputType.SLOPE: 1>
+SPAN: EWMAParamType  # value = <EWMAParamType.SPAN: 0>
 STOP_LOSS: TradeLimitType  # value = <TradeLimitType.STOP_LOSS: 1>
 SUBTRACT: AssetOpType  # value = <AssetOpType.SUBTRACT: 1>
+SUM: AssetObserverType  # value = <AssetObserverType.SUM: 0>
 TAKE_PROFIT: TradeLimitType  # value = <TradeLimitType.TAKE_PROFIT: 2>
 UNIFORM: AllocationType  # value = <AllocationType.UNIFORM: 0>
+UPPER: BollingerOutputType  # value = <BollingerOutputType.UPPER: 0>
 UPPER_TRIANGULAR: GridType  # value = <GridType.UPPER_TRIANGULAR: 1>
+VARIANCE: AssetObserverType  # value = <AssetObserverType.VARIANCE: 5>
 VOLATILITY: TracerType  # value = <TracerType.VOLATILITY: 1>
 WEIGHTS: TracerType  # value = <TracerType.WEIGHTS: 2>
+WILDER: EWMAParamType  # value = <EWMAParamType.WILDER: 2>
+WINSORIZE: GroupOpType  # value = <GroupOpType.WINSORIZE: 3>
+ZSCORE: GroupOpType  # value = <GroupOpType.ZSCORE: 1>
@@ -37,7 +37,14 @@ class Exchange:
     ) -> None: ...
     def getAssetIndex(self, arg0: str) -> int | None: ...
     def getAssetMap(self) -> dict[str, int]: ...
-    def getCovarianceNode(self, arg0: str, arg1: ..., arg2: int, arg3: ...) -> ...: ...
+    def getCovarianceNode(
+        self,
+        id: str,
+        trigger: ...,
+        lookback: int,
+        type: ...,
+        recompute_interval: int | None = None,
+    ) -> ...: ...
     def getCurrentTimestamp(self) -> int: ...
     def getMarketReturns(
         self, row_offset: int = 0
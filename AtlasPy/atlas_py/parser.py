@@ -80,6 +80,17 @@ class Parser:
 
     def _load_strategy(self, strategy_dir: str, parent: Optional[Strategy]) -> None:
         assert os.path.isdir(strategy_dir)
+
+        # strategies described by a spec are built in C++ in a single call
+        # without importing a module per strategy
+        spec_path = os.path.join(strategy_dir, "Strategies.json")
+        if parent is not None and os.path.isfile(spec_path):
+            with open(spec_path, "r") as f:
+                spec = f.read()
+            strategies = self._hydra.addStrategySpec(spec, parent)
+            self._logger.info(f"Added {len(strategies)} strategies from {spec_path}")
+            return None
+
         strategy_config_path = os.path.join(strategy_dir, "Strategy.toml")
         py_files = [f for f in os.listdir(strategy_dir) if f.endswith(".py")]
         if len(py_files) == 0:
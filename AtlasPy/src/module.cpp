@@ -10,6 +10,8 @@
 #include "ast/AllocationNode.hpp"
 #include "ast/AssetLogical.hpp"
 #include "ast/RankNode.hpp"
+#include "ast/GroupNode.hpp"
+#include "ast/RegressionNode.hpp"
 #include "ast/AssetNode.hpp"
 #include "ast/ExchangeNode.hpp"
 #include "ast/ObserverNode.hpp"
@@ -18,6 +20,7 @@
 #include "ast/RiskNode.hpp"
 #include "ast/Optimize.hpp"
 #include "ast/HelperNodes.hpp"
+#include "ast/IndicatorNode.hpp"
 #include "ast/TradeNode.hpp"
 #include "strategy/Strategy.hpp"
 #include "strategy/MetaStrategy.hpp"
@@ -68,6 +71,8 @@ PYBIND11_MODULE(atlas_internal, m) {
       m_ast, "StrategyBufferOpNode")
       .def("lag", &Atlas::AST::StrategyBufferOpNode::lag)
       .def("address", &Atlas::AST::StrategyBufferOpNode::address)
+      .def("getEvaluateCount",
+           &Atlas::AST::StrategyBufferOpNode::getEvaluateCount)
       .def("cache", &Atlas::AST::StrategyBufferOpNode::cache,
            py::return_value_policy::reference_internal);
 
@@ -79,6 +84,49 @@ PYBIND11_MODULE(atlas_internal, m) {
   py::enum_<Atlas::CovarianceType>(m_ast, "CovarianceType")
       .value("FULL", Atlas::CovarianceType::FULL)
       .value("INCREMENTAL", Atlas::CovarianceType::INCREMENTAL)
+      .value("EWMA", Atlas::CovarianceType::EWMA)
+      .export_values();
+
+  py::enum_<Atlas::EWMAParamType>(m_ast, "EWMAParamType")
+      .value("SPAN", Atlas::EWMAParamType::SPAN)
+      .value("HALF_LIFE", Atlas::EWMAParamType::HALF_LIFE)
+      .value("WILDER", Atlas::EWMAParamType::WILDER)
+      .export_values();
+
+  py::enum_<Atlas::RegressionOutputType>(m_ast, "RegressionOutputType")
+      .value("BETA", Atlas::RegressionOutputType::BETA)
+      .value("ALPHA", Atlas::RegressionOutputType::ALPHA)
+      .value("RESIDUAL_VOLATILITY",
+             Atlas::RegressionOutputType::RESIDUAL_VOLATILITY)
+      .value("R_SQUARED", Atlas::RegressionOutputType::R_SQUARED)
+      .export_values();
+
+  py::enum_<Atlas::KalmanModelType>(m_ast, "KalmanModelType")
+      .value("LOCAL_LEVEL", Atlas::KalmanModelType::LOCAL_LEVEL)
+      .value("LOCAL_TREND", Atlas::KalmanModelType::LOCAL_TREND)
+      .export_values();
+
+  py::enum_<Atlas::KalmanOutputType>(m_ast, "KalmanOutputType")
+      .value("LEVEL", Atlas::KalmanOutputType::LEVEL)
+      .value("SLOPE", Atlas::KalmanOutputType::SLOPE)
+      .export_values();
+
+  py::enum_<Atlas::MACDOutputType>(m_ast, "MACDOutputType")
+      .value("LINE", Atlas::MACDOutputType::LINE)
+      .value("SIGNAL", Atlas::MACDOutputType::SIGNAL)
+      .value("HISTOGRAM", Atlas::MACDOutputType::HISTOGRAM)
+      .export_values();
+
+  py::enum_<Atlas::BollingerOutputType>(m_ast, "BollingerOutputType")
+      .value("UPPER", Atlas::BollingerOutputType::UPPER)
+      .value("LOWER", Atlas::BollingerOutputType::LOWER)
+      .value("PERCENT_B", Atlas::BollingerOutputType::PERCENT_B)
+      .export_values();
+
+  py::enum_<Atlas::ADXOutputType>(m_ast, "ADXOutputType")
+      .value("ADX", Atlas::ADXOutputType::ADX)
+      .value("PLUS_DI", Atlas::ADXOutputType::PLUS_DI)
+      .value("MINUS_DI", Atlas::ADXOutputType::MINUS_DI)
       .export_values();
 
   py::class_<Atlas::AST::AssetObserverNode, Atlas::AST::StrategyBufferOpNode,
@@ -101,6 +149,10 @@ PYBIND11_MODULE(atlas_internal, m) {
              std::shared_ptr<Atlas::AST::IncrementalCovarianceNode>>(
       m_ast, "IncrementalCovarianceNode");
 
+  py::class_<Atlas::AST::EWMACovarianceNode, Atlas::AST::CovarianceNodeBase,
+             std::shared_ptr<Atlas::AST::EWMACovarianceNode>>(
+      m_ast, "EWMACovarianceNode");
+
   py::enum_<Atlas::TracerType>(m_ast, "TracerType")
       .value("NLV", Atlas::TracerType::NLV)
       .value("WEIGHTS", Atlas::TracerType::WEIGHTS)
@@ -129,6 +181,17 @@ PYBIND11_MODULE(atlas_internal, m) {
       .value("NSMALLEST", Atlas::AST::EVRankType::NSMALLEST)
       .value("NEXTREME", Atlas::AST::EVRankType::NEXTREME)
       .export_values();
+  py::enum_<Atlas::AST::GroupOpType>(m_ast, "GroupOpType")
+      .value("DEMEAN", Atlas::AST::GroupOpType::DEMEAN)
+      .value("ZSCORE", Atlas::AST::GroupOpType::ZSCORE)
+      .value("RANK", Atlas::AST::GroupOpType::RANK)
+      .value("WINSORIZE", Atlas::AST::GroupOpType::WINSORIZE)
+      .export_values();
+  py::enum_<Atlas::CrossSectionOutputType>(m_ast, "CrossSectionOutputType")
+      .value("RESIDUAL", Atlas::CrossSectionOutputType::RESIDUAL)
+      .value("FITTED", Atlas::CrossSectionOutputType::FITTED)
+      .value("FACTOR_RETURN", Atlas::CrossSectionOutputType::FACTOR_RETURN)
+      .export_values();
   py::enum_<Atlas::AST::AssetOpType>(m_ast, "AssetOpType")
       .value("ADD", Atlas::AST::AssetOpType::ADD)
       .value("SUBTRACT", Atlas::AST::AssetOpType::SUBTRACT)
@@ -147,6 +210,11 @@ PYBIND11_MODULE(atlas_internal, m) {
       .value("AND", Atlas::LogicalType::AND)
       .value("OR", Atlas::LogicalType::OR)
       .export_values();
+  py::enum_<Atlas::AST::AssetObserverType>(m_ast, "AssetObserverType")
+      .value("SUM", Atlas::AST::AssetObserverType::SUM)
+      .value("MEAN", Atlas::AST::AssetObserverType::MEAN)
+      .value("VARIANCE", Atlas::AST::AssetObserverType::VARIANCE)
+      .export_values();
   py::enum_<Atlas::AST::AssetCompType>(m_ast, "AssetCompType")
       .value("EQUAL", Atlas::AST::AssetCompType::EQUAL)
       .value("NOT_EQUAL", Atlas::AST::AssetCompType::NOT_EQUAL)
@@ -212,13 +280,50 @@ PYBIND11_MODULE(atlas_internal, m) {
       .def_static("make", &Atlas::AST::ExchangeViewNode::make,
                   py::arg("exchange"), py::arg("asset_op_node"),
                   py::arg("filter") = std::nullopt,
-                  py::arg("left_view") = std::nullopt);
+                  py::arg("left_view") = std::nullopt)
+      .def("setAssets", &Atlas::AST::ExchangeViewNode::pySetAssets,
+           py::arg("assets"));
 
   py::class_<Atlas::AST::EVRankNode, Atlas::AST::StrategyBufferOpNode,
              std::shared_ptr<Atlas::AST::EVRankNode>>(m_ast, "EVRankNode")
       .def_static("make", &Atlas::AST::EVRankNode::make, py::arg("ev"),
                   py::arg("type"), py::arg("count"));
 
+  py::class_<Atlas::AST::GroupNormalizeNode, Atlas::AST::StrategyBufferOpNode,
+             std::shared_ptr<Atlas::AST::GroupNormalizeNode>>(
+      m_ast, "GroupNormalizeNode")
+      .def_static("make", &Atlas::AST::GroupNormalizeNode::pyMake,
+                  py::arg("parent"), py::arg("groups"), py::arg("op"),
+                  py::arg("param") = 3.0)
+      .def_static(
+          "make",
+          static_cast<std::shared_ptr<Atlas::AST::GroupNormalizeNode> (*)(
+              std::shared_ptr<Atlas::AST::StrategyBufferOpNode>,
+              std::shared_ptr<Atlas::AST::StrategyBufferOpNode>,
+              Atlas::AST::GroupOpType, double) noexcept>(
+              &Atlas::AST::GroupNormalizeNode::make),
+          py::arg("parent"), py::arg("group_node"), py::arg("op"),
+          py::arg("param") = 3.0);
+
+  py::class_<Atlas::AST::CrossSectionRegressionNode,
+             Atlas::AST::StrategyBufferOpNode,
+             std::shared_ptr<Atlas::AST::CrossSectionRegressionNode>>(
+      m_ast, "CrossSectionRegressionNode")
+      .def_static("make", &Atlas::AST::CrossSectionRegressionNode::pyMake,
+                  py::arg("parent"), py::arg("factors"),
+                  py::arg("output") = Atlas::CrossSectionOutputType::RESIDUAL,
+                  py::arg("intercept") = true, py::arg("factor") = 0,
+                  py::arg("weights") = std::nullopt)
+      .def("getFactorReturns",
+           &Atlas::AST::CrossSectionRegressionNode::getFactorReturns,
+           py::return_value_policy::reference_internal)
+      .def("getMeanFactorReturns",
+           &Atlas::AST::CrossSectionRegressionNode::getMeanFactorReturns)
+      .def("getFactorReturnTStats",
+           &Atlas::AST::CrossSectionRegressionNode::getFactorReturnTStats)
+      .def("getFitCount",
+           &Atlas::AST::CrossSectionRegressionNode::getFitCount);
+
   py::class_<Atlas::AST::TriggerNode, std::shared_ptr<Atlas::AST::TriggerNode>>(
       m_ast, "TriggerNode")
       .def("getMask", &Atlas::AST::TriggerNode::getMask,
@@ -342,6 +447,20 @@ PYBIND11_MODULE(atlas_internal, m) {
                     std::shared_ptr<Atlas::AST::StrategyBufferOpNode>,
                     size_t>());
 
+  py::class_<Atlas::AST::MinObserverNode, Atlas::AST::AssetObserverNode,
+             std::shared_ptr<Atlas::AST::MinObserverNode>>(m_ast,
+                                                           "MinObserverNode")
+      .def(py::init<std::string,
+                    std::shared_ptr<Atlas::AST::StrategyBufferOpNode>,
+                    size_t>());
+
+  py::class_<Atlas::AST::TsArgMinObserverNode, Atlas::AST::AssetObserverNode,
+             std::shared_ptr<Atlas::AST::TsArgMinObserverNode>>(
+      m_ast, "TsArgMinObserverNode")
+      .def(py::init<std::string,
+                    std::shared_ptr<Atlas::AST::StrategyBufferOpNode>,
+                    size_t>());
+
   py::class_<Atlas::AST::CovarianceObserverNode, Atlas::AST::AssetObserverNode,
              std::shared_ptr<Atlas::AST::CovarianceObserverNode>>(
       m_ast, "CovarianceObserverNode")
@@ -363,6 +482,180 @@ PYBIND11_MODULE(atlas_internal, m) {
                     std::shared_ptr<Atlas::AST::StrategyBufferOpNode>,
                     size_t>());
 
+  py::class_<Atlas::AST::KurtosisObserverNode, Atlas::AST::AssetObserverNode,
+             std::shared_ptr<Atlas::AST::KurtosisObserverNode>>(
+      m_ast, "KurtosisObserverNode")
+      .def(py::init<std::string,
+                    std::shared_ptr<Atlas::AST::StrategyBufferOpNode>,
+                    size_t>());
+
+  py::class_<Atlas::AST::QuantileObserverNode, Atlas::AST::AssetObserverNode,
+             std::shared_ptr<Atlas::AST::QuantileObserverNode>>(
+      m_ast, "QuantileObserverNode")
+      .def(py::init<std::string,
+                    std::shared_ptr<Atlas::AST::StrategyBufferOpNode>, size_t,
+                    double>());
+
+  py::class_<Atlas::AST::MedianObserverNode, Atlas::AST::AssetObserverNode,
+             std::shared_ptr<Atlas::AST::MedianObserverNode>>(
+      m_ast, "MedianObserverNode")
+      .def(py::init<std::string,
+                    std::shared_ptr<Atlas::AST::StrategyBufferOpNode>,
+                    size_t>());
+
+  py::class_<Atlas::AST::TsRankObserverNode, Atlas::AST::AssetObserverNode,
+             std::shared_ptr<Atlas::AST::TsRankObserverNode>>(
+      m_ast, "TsRankObserverNode")
+      .def(py::init<std::string,
+                    std::shared_ptr<Atlas::AST::StrategyBufferOpNode>,
+                    size_t>());
+
+  py::class_<Atlas::AST::EWMAMeanObserverNode, Atlas::AST::AssetObserverNode,
+             std::shared_ptr<Atlas::AST::EWMAMeanObserverNode>>(
+      m_ast, "EWMAMeanObserverNode")
+      .def(py::init<std::string,
+                    std::shared_ptr<Atlas::AST::StrategyBufferOpNode>, double,
+                    Atlas::EWMAParamType>(),
+           py::arg("id"), py::arg("parent"), py::arg("param"),
+           py::arg("param_type") = Atlas::EWMAParamType::SPAN);
+
+  py::class_<Atlas::AST::EWMAVarianceObserverNode, Atlas::AST::AssetObserverNode,
+             std::shared_ptr<Atlas::AST::EWMAVarianceObserverNode>>(
+      m_ast, "EWMAVarianceObserverNode")
+      .def(py::init<std::string,
+                    std::shared_ptr<Atlas::AST::StrategyBufferOpNode>, double,
+                    Atlas::EWMAParamType>(),
+           py::arg("id"), py::arg("parent"), py::arg("param"),
+           py::arg("param_type") = Atlas::EWMAParamType::SPAN);
+
+  py::class_<Atlas::AST::EWMAVolatilityObserverNode, Atlas::AST::AssetObserverNode,
+             std::shared_ptr<Atlas::AST::EWMAVolatilityObserverNode>>(
+      m_ast, "EWMAVolatilityObserverNode")
+      .def(py::init<std::string,
+                    std::shared_ptr<Atlas::AST::StrategyBufferOpNode>, double,
+                    Atlas::EWMAParamType>(),
+           py::arg("id"), py::arg("parent"), py::arg("param"),
+           py::arg("param_type") = Atlas::EWMAParamType::SPAN);
+
+  py::class_<Atlas::AST::EWMAZScoreObserverNode, Atlas::AST::AssetObserverNode,
+             std::shared_ptr<Atlas::AST::EWMAZScoreObserverNode>>(
+      m_ast, "EWMAZScoreObserverNode")
+      .def(py::init<std::string,
+                    std::shared_ptr<Atlas::AST::StrategyBufferOpNode>, double,
+                    Atlas::EWMAParamType>(),
+           py::arg("id"), py::arg("parent"), py::arg("param"),
+           py::arg("param_type") = Atlas::EWMAParamType::SPAN);
+
+  py::class_<Atlas::AST::EWMACovarianceObserverNode,
+             Atlas::AST::AssetObserverNode,
+             std::shared_ptr<Atlas::AST::EWMACovarianceObserverNode>>(
+      m_ast, "EWMACovarianceObserverNode")
+      .def(py::init<std::string,
+                    std::shared_ptr<Atlas::AST::StrategyBufferOpNode>,
+                    std::shared_ptr<Atlas::AST::StrategyBufferOpNode>, double,
+                    Atlas::EWMAParamType, std::optional<size_t>>(),
+           py::arg("id"), py::arg("left_parent"), py::arg("right_parent"),
+           py::arg("param"), py::arg("param_type") = Atlas::EWMAParamType::SPAN,
+           py::arg("benchmark_asset") = std::nullopt);
+
+  py::class_<Atlas::AST::RollingRegressionObserverNode,
+             Atlas::AST::AssetObserverNode,
+             std::shared_ptr<Atlas::AST::RollingRegressionObserverNode>>(
+      m_ast, "RollingRegressionObserverNode")
+      .def(py::init<std::string,
+                    std::shared_ptr<Atlas::AST::StrategyBufferOpNode>,
+                    std::shared_ptr<Atlas::AST::StrategyBufferOpNode>, size_t,
+                    Atlas::RegressionOutputType, std::optional<size_t>>(),
+           py::arg("id"), py::arg("parent"), py::arg("benchmark"),
+           py::arg("window"),
+           py::arg("output") = Atlas::RegressionOutputType::BETA,
+           py::arg("benchmark_asset") = std::nullopt);
+
+  py::class_<Atlas::AST::KalmanFilterObserverNode,
+             Atlas::AST::AssetObserverNode,
+             std::shared_ptr<Atlas::AST::KalmanFilterObserverNode>>(
+      m_ast, "KalmanFilterObserverNode")
+      .def(py::init<std::string,
+                    std::shared_ptr<Atlas::AST::StrategyBufferOpNode>,
+                    Atlas::KalmanModelType, double, double, double,
+                    Atlas::KalmanOutputType>(),
+           py::arg("id"), py::arg("parent"), py::arg("model"),
+           py::arg("process_noise"), py::arg("observation_noise"),
+           py::arg("slope_noise") = 0.0,
+           py::arg("output") = Atlas::KalmanOutputType::LEVEL);
+
+  py::class_<Atlas::AST::TrueRangeObserverNode, Atlas::AST::AssetObserverNode,
+             std::shared_ptr<Atlas::AST::TrueRangeObserverNode>>(
+      m_ast, "TrueRangeObserverNode")
+      .def(py::init<std::string,
+                    std::shared_ptr<Atlas::AST::StrategyBufferOpNode>,
+                    std::shared_ptr<Atlas::AST::StrategyBufferOpNode>,
+                    std::shared_ptr<Atlas::AST::StrategyBufferOpNode>>(),
+           py::arg("id"), py::arg("high"), py::arg("low"), py::arg("close"));
+
+  py::class_<Atlas::AST::RsiObserverNode, Atlas::AST::AssetObserverNode,
+             std::shared_ptr<Atlas::AST::RsiObserverNode>>(m_ast,
+                                                           "RsiObserverNode")
+      .def(py::init<std::string,
+                    std::shared_ptr<Atlas::AST::StrategyBufferOpNode>,
+                    size_t>(),
+           py::arg("id"), py::arg("parent"), py::arg("period"));
+
+  py::class_<Atlas::AST::MacdObserverNode, Atlas::AST::AssetObserverNode,
+             std::shared_ptr<Atlas::AST::MacdObserverNode>>(m_ast,
+                                                            "MacdObserverNode")
+      .def(py::init<std::string,
+                    std::shared_ptr<Atlas::AST::StrategyBufferOpNode>, size_t,
+                    size_t, size_t, Atlas::MACDOutputType>(),
+           py::arg("id"), py::arg("parent"), py::arg("fast"), py::arg("slow"),
+           py::arg("signal"), py::arg("output") = Atlas::MACDOutputType::LINE);
+
+  py::class_<Atlas::AST::BollingerObserverNode, Atlas::AST::AssetObserverNode,
+             std::shared_ptr<Atlas::AST::BollingerObserverNode>>(
+      m_ast, "BollingerObserverNode")
+      .def(py::init<std::string,
+                    std::shared_ptr<Atlas::AST::StrategyBufferOpNode>, size_t,
+                    double, Atlas::BollingerOutputType>(),
+           py::arg("id"), py::arg("parent"), py::arg("window"),
+           py::arg("num_std") = 2.0,
+           py::arg("output") = Atlas::BollingerOutputType::PERCENT_B);
+
+  py::class_<Atlas::AST::StochasticObserverNode, Atlas::AST::AssetObserverNode,
+             std::shared_ptr<Atlas::AST::StochasticObserverNode>>(
+      m_ast, "StochasticObserverNode")
+      .def(py::init<std::string,
+                    std::shared_ptr<Atlas::AST::StrategyBufferOpNode>,
+                    std::shared_ptr<Atlas::AST::StrategyBufferOpNode>,
+                    std::shared_ptr<Atlas::AST::StrategyBufferOpNode>, size_t>(),
+           py::arg("id"), py::arg("high"), py::arg("low"), py::arg("close"),
+           py::arg("window"));
+
+  py::class_<Atlas::AST::AdxObserverNode, Atlas::AST::AssetObserverNode,
+             std::shared_ptr<Atlas::AST::AdxObserverNode>>(m_ast,
+                                                           "AdxObserverNode")
+      .def(py::init<std::string,
+                    std::shared_ptr<Atlas::AST::StrategyBufferOpNode>,
+                    std::shared_ptr<Atlas::AST::StrategyBufferOpNode>,
+                    std::shared_ptr<Atlas::AST::StrategyBufferOpNode>, size_t,
+                    Atlas::ADXOutputType>(),
+           py::arg("id"), py::arg("high"), py::arg("low"), py::arg("close"),
+           py::arg("period"), py::arg("output") = Atlas::ADXOutputType::ADX);
+
+  py::class_<Atlas::AST::MultiWindowObserverNode,
+             Atlas::AST::AssetObserverNode,
+             std::shared_ptr<Atlas::AST::MultiWindowObserverNode>>(
+      m_ast, "MultiWindowObserverNode")
+      .def(py::init<std::string,
+                    std::shared_ptr<Atlas::AST::StrategyBufferOpNode>,
+                    size_t>());
+
+  py::class_<Atlas::AST::WindowViewNode, Atlas::AST::StrategyBufferOpNode,
+             std::shared_ptr<Atlas::AST::WindowViewNode>>(m_ast,
+                                                          "WindowViewNode")
+      .def_static("make", &Atlas::AST::WindowViewNode::make,
+                  py::arg("observer"), py::arg("window"),
+                  py::arg("statistic"));
+
   py::class_<Atlas::AST::StrategyGrid,
              std::shared_ptr<Atlas::AST::StrategyGrid>>(m_ast, "StrategyGrid")
       .def("enableTracerHistory",
@@ -397,6 +690,15 @@ PYBIND11_MODULE(atlas_internal, m) {
       .def("setGridDimmensions", &Atlas::Strategy::pySetGridDimmensions,
            py::arg("dimensions"), py::arg("grid_type") = std::nullopt)
       .def("initCommissionManager", &Atlas::Strategy::initCommissionManager)
+      .def("getOptimizerReport", &Atlas::Strategy::getOptimizerReport)
+      .def("generateNative", &Atlas::Strategy::pyGenerateNative)
+      .def("loadNative", &Atlas::Strategy::pyLoadNative,
+           py::arg("library_path"))
+      .def("compileNative", &Atlas::Strategy::pyCompileNative,
+           py::arg("library_path"), py::arg("include_dir"),
+           py::arg("compiler") = std::nullopt,
+           py::arg("flags") = std::nullopt)
+      .def("unloadNative", &Atlas::Strategy::unloadNative)
       .def(py::init<std::string, std::shared_ptr<Atlas::Exchange>,
                     std::shared_ptr<Atlas::Allocator>, double>());
 
@@ -6,6 +6,7 @@
 #include "hydra/Commissions.hpp"
 #include "strategy/Allocator.hpp"
 #include "strategy/MetaStrategy.hpp"
+#include "strategy/Strategy.hpp"
 #include "model/ModelBase.hpp"
 #include "hydra/Hydra.hpp"
 #include "exchange/Exchange.hpp"
@@ -26,6 +27,8 @@ void wrap_base(py::module &m_core) {
       .def("getStrategy", &Atlas::Hydra::getStrategy)
       .def("addStrategy", &Atlas::Hydra::pyAddStrategy, py::arg("strategy"),
            py::arg("replace_if_exists") = false)
+      .def("addStrategySpec", &Atlas::Hydra::pyAddStrategySpec,
+           py::arg("spec"), py::arg("parent"))
       .def(py::init<>());
 
   py::class_<Atlas::CommisionManager, std::shared_ptr<Atlas::CommisionManager>>(
@@ -39,8 +42,16 @@ void wrap_base(py::module &m_core) {
       .def("registerObserver", &Atlas::Exchange::registerObserver)
       .def("getObserver", &Atlas::Exchange::getObserver)
       .def("enableNodeCache", &Atlas::Exchange::enableNodeCache)
+      .def("enableNodeCaches", &Atlas::Exchange::enableNodeCaches,
+           py::arg("nodes"), py::arg("eager") = true)
+      .def("setCacheBudget", &Atlas::Exchange::setCacheBudget)
+      .def("getCacheBudget", &Atlas::Exchange::getCacheBudget)
+      .def("getCacheBudgetRemaining",
+           &Atlas::Exchange::getCacheBudgetRemaining)
       .def("getTimestamps", &Atlas::Exchange::getTimestamps)
-      .def("getCovarianceNode", &Atlas::Exchange::getCovarianceNode)
+      .def("getCovarianceNode", &Atlas::Exchange::getCovarianceNode,
+           py::arg("id"), py::arg("trigger"), py::arg("lookback"),
+           py::arg("type"), py::arg("recompute_interval") = std::nullopt)
       .def("getMarketReturns", &Atlas::Exchange::getMarketReturns,
            py::arg("row_offset") = 0,
            py::return_value_policy::reference_internal)
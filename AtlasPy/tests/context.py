@@ -14,12 +14,18 @@ HYDRA_DIR = "files/hydra1"
 HYDRA_DIR_2 = "files/hydra2"
 HYDRA_DIR_MULTI = "files/hydraMulti"
 HYDRA_DIR_SP500 = "files/hydra_sp500"
+EXCHANGE_DIR_2 = "files/exchange2"
 TEST_FILE_1 = "test_strategy_1.toml"
 PORTFOLIO_ID = "test_portfolio_1"
 STRATEGY_ID = "test_strategy_1"
 EXCHANGE_ID = "test_exchange_1"
 
 
+# include directory holding Eigen, needed to compile native strategies
+EIGEN_INCLUDE_DIR = os.environ.get(
+    "EIGEN_INCLUDE_DIR", r"C:/vcpkg/installed/x64-windows/include"
+)
+
 EXCHANGE_PATH = (
     r"C:/Users/natha/OneDrive/Desktop/C++/Atlas/AtlasPy/tests/files/exchangeVBT"
 )
@@ -63,6 +63,191 @@ class TestObserver(unittest.TestCase):
         self.assertTrue(np.allclose(df["close_max_atlas"], df["close_max_pd"]))
         self.assertTrue(np.allclose(df["close_arg_max_atlas"], df["close_arg_max_pd"]))
 
+    def test_min_observer(self):
+        window = 20
+        close = AssetReadNode.make("Close", 0, self.exchange)
+        close_min = self.exchange.registerObserver(
+            MinObserverNode("min", close, window)
+        )
+        close_arg_min = self.exchange.registerObserver(
+            TsArgMinObserverNode("arg_min", close, window)
+        )
+        self.exchange.enableNodeCache("close_min", close_min, False)
+        self.exchange.enableNodeCache("close_arg_min", close_arg_min, False)
+
+        ev = ExchangeViewNode.make(self.exchange, close)
+        allocation = AllocationNode.make(ev)
+        strategy_node_signal = StrategyNode.make(allocation)
+        strategy = ImmediateStrategy(
+            self.exchange, self.root_strategy, STRATEGY_ID, 1.0, strategy_node_signal
+        )
+        _ = self.root_strategy.addStrategy(strategy, True)
+        self.hydra.run()
+
+        df = self.get_df()
+        btc_idx = self.exchange.getAssetIndex("BTC-USD")
+        df["close_min_atlas"] = close_min.cache()[btc_idx].T
+        df["close_arg_min_atlas"] = close_arg_min.cache()[btc_idx].T
+        df["close_min_pd"] = df["Close"].rolling(window).min()
+        df["close_arg_min_pd"] = df["Close"].rolling(window).apply(np.argmin).add(1)
+        df = df.iloc[window:]
+        self.assertTrue(np.allclose(df["close_min_atlas"], df["close_min_pd"]))
+        self.assertTrue(np.allclose(df["close_arg_min_atlas"], df["close_arg_min_pd"]))
+
+    def test_arg_extremum_ties(self):
+        # the sign of the change only takes a few values so the window is full
+        # of ties, which resolve to the most recent observation
+        window = 5
+        close = AssetReadNode.make("Close", 0, self.exchange)
+        prev_close = AssetReadNode.make("Close", -1, self.exchange)
+        change = AssetOpNode.make(close, prev_close, AssetOpType.SUBTRACT)
+        sign = AssetFunctionNode(change, AssetFunctionType.SIGN, None)
+        arg_max = self.exchange.registerObserver(
+            TsArgMaxObserverNode("sign_arg_max", sign, window)
+        )
+        arg_min = self.exchange.registerObserver(
+            TsArgMinObserverNode("sign_arg_min", sign, window)
+        )
+        self.exchange.enableNodeCache("sign_arg_max", arg_max, False)
+        self.exchange.enableNodeCache("sign_arg_min", arg_min, False)
+
+        ev = ExchangeViewNode.make(self.exchange, close)
+        allocation = AllocationNode.make(ev)
+        strategy_node_signal = StrategyNode.make(allocation)
+        strategy = ImmediateStrategy(
+            self.exchange, self.root_strategy, STRATEGY_ID, 1.0, strategy_node_signal
+        )
+        _ = self.root_strategy.addStrategy(strategy, True)
+        self.hydra.run()
+
+        df = self.get_df()
+        btc_idx = self.exchange.getAssetIndex("BTC-USD")
+        sign_pd = np.sign(df["Close"].diff())
+        newest = lambda f: lambda x: window - f(x[::-1])
+        expected_max = (
+            sign_pd.rolling(window).apply(newest(np.argmax), raw=True).values
+        )
+        expected_min = (
+            sign_pd.rolling(window).apply(newest(np.argmin), raw=True).values
+        )
+        self.assertTrue(
+            np.allclose(arg_max.cache()[btc_idx][window:], expected_max[window:])
+        )
+        self.assertTrue(
+            np.allclose(arg_min.cache()[btc_idx][window:], expected_min[window:])
+        )
+
+    def test_quantile_observer(self):
+        window = 15
+        close = AssetReadNode.make("Close", 0, self.exchange)
+        quantile = self.exchange.registerObserver(
+            QuantileObserverNode("q", close, window, 0.25)
+        )
+        quantile_other = self.exchange.registerObserver(
+            QuantileObserverNode("q_other", close, window, 0.75)
+        )
+        self.assertNotEqual(quantile.address(), quantile_other.address())
+        median = self.exchange.registerObserver(
+            MedianObserverNode("median", close, window)
+        )
+        ts_rank = self.exchange.registerObserver(
+            TsRankObserverNode("ts_rank", close, window)
+        )
+        self.exchange.enableNodeCache("q", quantile, False)
+        self.exchange.enableNodeCache("median", median, False)
+        self.exchange.enableNodeCache("ts_rank", ts_rank, False)
+        ev = ExchangeViewNode.make(self.exchange, close)
+        allocation = AllocationNode.make(ev)
+        strategy_node_signal = StrategyNode.make(allocation)
+        strategy = ImmediateStrategy(
+            self.exchange, self.root_strategy, STRATEGY_ID, 1.0, strategy_node_signal
+        )
+        _ = self.root_strategy.addStrategy(strategy, True)
+        self.hydra.run()
+
+        df = self.get_df()
+        btc_idx = self.exchange.getAssetIndex("BTC-USD")
+        df["q_atlas"] = quantile.cache()[btc_idx].T
+        df["median_atlas"] = median.cache()[btc_idx].T
+        df["ts_rank_atlas"] = ts_rank.cache()[btc_idx].T
+        df["q_pd"] = df["Close"].rolling(window).quantile(0.25)
+        df["median_pd"] = df["Close"].rolling(window).median()
+        df["ts_rank_pd"] = df["Close"].rolling(window).rank(pct=True)
+        df = df.iloc[window:]
+        self.assertTrue(np.allclose(df["q_atlas"], df["q_pd"]))
+        self.assertTrue(np.allclose(df["median_atlas"], df["median_pd"]))
+        self.assertTrue(np.allclose(df["ts_rank_atlas"], df["ts_rank_pd"]))
+
+    def test_shared_history(self):
+        # observers of one parent with different windows share its history
+        close = AssetReadNode.make("Close", 0, self.exchange)
+        sum_node = self.exchange.registerObserver(SumObserverNode("sum", close, 3))
+        max_node = self.exchange.registerObserver(MaxObserverNode("max", close, 9))
+        var_node = self.exchange.registerObserver(
+            VarianceObserverNode("var", close, 6)
+        )
+        for name, node in [("sum", sum_node), ("max", max_node), ("var", var_node)]:
+            self.exchange.enableNodeCache(name, node, False)
+        ev = ExchangeViewNode.make(self.exchange, close)
+        allocation = AllocationNode.make(ev)
+        strategy_node_signal = StrategyNode.make(allocation)
+        strategy = ImmediateStrategy(
+            self.exchange, self.root_strategy, STRATEGY_ID, 1.0, strategy_node_signal
+        )
+        _ = self.root_strategy.addStrategy(strategy, True)
+        self.hydra.run()
+
+        df = self.get_df()
+        btc_idx = self.exchange.getAssetIndex("BTC-USD")
+        df["sum_atlas"] = sum_node.cache()[btc_idx].T
+        df["max_atlas"] = max_node.cache()[btc_idx].T
+        df["var_atlas"] = var_node.cache()[btc_idx].T
+        df["sum_pd"] = df["Close"].rolling(3).sum()
+        df["max_pd"] = df["Close"].rolling(9).max()
+        df["var_pd"] = df["Close"].rolling(6).var(ddof=0)
+        df = df.iloc[9:]
+        self.assertTrue(np.allclose(df["sum_atlas"], df["sum_pd"]))
+        self.assertTrue(np.allclose(df["max_atlas"], df["max_pd"]))
+        self.assertTrue(np.allclose(df["var_atlas"], df["var_pd"]))
+
+    def test_multi_window_observer(self):
+        # every window up to the largest is read from one prefix sum observer
+        close = AssetReadNode.make("Close", 0, self.exchange)
+        windows = self.exchange.registerObserver(
+            MultiWindowObserverNode("windows", close, 30)
+        )
+        sum_view = WindowViewNode.make(windows, 10, AssetObserverType.SUM)
+        mean_view = WindowViewNode.make(windows, 20, AssetObserverType.MEAN)
+        var_view = WindowViewNode.make(windows, 30, AssetObserverType.VARIANCE)
+        for name, node in [("sum", sum_view), ("mean", mean_view), ("var", var_view)]:
+            self.exchange.enableNodeCache(name, node, False)
+        signal = AssetOpNode.make(
+            AssetOpNode.make(sum_view, mean_view, AssetOpType.ADD),
+            var_view,
+            AssetOpType.ADD,
+        )
+        ev = ExchangeViewNode.make(self.exchange, signal)
+        allocation = AllocationNode.make(ev)
+        strategy_node_signal = StrategyNode.make(allocation)
+        strategy = ImmediateStrategy(
+            self.exchange, self.root_strategy, STRATEGY_ID, 1.0, strategy_node_signal
+        )
+        _ = self.root_strategy.addStrategy(strategy, True)
+        self.hydra.run()
+
+        df = self.get_df()
+        btc_idx = self.exchange.getAssetIndex("BTC-USD")
+        df["sum_atlas"] = sum_view.cache()[btc_idx].T
+        df["mean_atlas"] = mean_view.cache()[btc_idx].T
+        df["var_atlas"] = var_view.cache()[btc_idx].T
+        df["sum_pd"] = df["Close"].rolling(10).sum()
+        df["mean_pd"] = df["Close"].rolling(20).mean()
+        df["var_pd"] = df["Close"].rolling(30).var(ddof=0)
+        df = df.iloc[30:]
+        self.assertTrue(np.allclose(df["sum_atlas"], df["sum_pd"]))
+        self.assertTrue(np.allclose(df["mean_atlas"], df["mean_pd"]))
+        self.assertTrue(np.allclose(df["var_atlas"], df["var_pd"]))
+
     def test_sum_observer(self):
         window = 2
         close = AssetReadNode.make("Close", 0, self.exchange)
@@ -153,6 +338,240 @@ class TestObserver(unittest.TestCase):
             np.allclose(df["close_open_cov_atlas"], df["close_open_cov_pd"])
         )
 
+    def test_ewma_observer(self):
+        span = 10
+        close = AssetReadNode.make("Close", 0, self.exchange)
+        open_node = AssetReadNode.make("Open", 0, self.exchange)
+        mean = self.exchange.registerObserver(
+            EWMAMeanObserverNode("ewma_mean", close, span)
+        )
+        vol = self.exchange.registerObserver(
+            EWMAVolatilityObserverNode("ewma_vol", close, span)
+        )
+        cov = self.exchange.registerObserver(
+            EWMACovarianceObserverNode("ewma_cov", close, open_node, span)
+        )
+        half_life = self.exchange.registerObserver(
+            EWMAMeanObserverNode("ewma_hl", close, 5.0, EWMAParamType.HALF_LIFE)
+        )
+        self.assertNotEqual(mean.address(), half_life.address())
+        for name, node in [
+            ("mean", mean),
+            ("vol", vol),
+            ("cov", cov),
+            ("half_life", half_life),
+        ]:
+            self.exchange.enableNodeCache(name, node, False)
+        ev = ExchangeViewNode.make(self.exchange, close)
+        allocation = AllocationNode.make(ev)
+        strategy_node_signal = StrategyNode.make(allocation)
+        strategy = ImmediateStrategy(
+            self.exchange, self.root_strategy, STRATEGY_ID, 1.0, strategy_node_signal
+        )
+        _ = self.root_strategy.addStrategy(strategy, True)
+        self.hydra.run()
+
+        df = self.get_df()
+        btc_idx = self.exchange.getAssetIndex("BTC-USD")
+        ewm = df["Close"].ewm(span=span, adjust=False)
+        self.assertTrue(np.allclose(mean.cache()[btc_idx], ewm.mean()))
+        self.assertTrue(np.allclose(vol.cache()[btc_idx], ewm.std(bias=True)))
+        self.assertTrue(
+            np.allclose(cov.cache()[btc_idx], ewm.cov(df["Open"], bias=True))
+        )
+        ewm_hl = df["Close"].ewm(halflife=5.0, adjust=False)
+        self.assertTrue(np.allclose(half_life.cache()[btc_idx], ewm_hl.mean()))
+
+    def test_regression_observer(self):
+        window = 20
+        close = AssetReadNode.make("Close", 0, self.exchange)
+        open_node = AssetReadNode.make("Open", 0, self.exchange)
+        outputs = {}
+        for name, output in [
+            ("beta", RegressionOutputType.BETA),
+            ("alpha", RegressionOutputType.ALPHA),
+            ("resid_vol", RegressionOutputType.RESIDUAL_VOLATILITY),
+            ("r_squared", RegressionOutputType.R_SQUARED),
+        ]:
+            outputs[name] = self.exchange.registerObserver(
+                RollingRegressionObserverNode(name, close, open_node, window, output)
+            )
+            self.exchange.enableNodeCache(name, outputs[name], False)
+        self.assertNotEqual(outputs["beta"].address(), outputs["alpha"].address())
+        ev = ExchangeViewNode.make(self.exchange, close)
+        allocation = AllocationNode.make(ev)
+        strategy_node_signal = StrategyNode.make(allocation)
+        strategy = ImmediateStrategy(
+            self.exchange, self.root_strategy, STRATEGY_ID, 1.0, strategy_node_signal
+        )
+        _ = self.root_strategy.addStrategy(strategy, True)
+        self.hydra.run()
+
+        df = self.get_df()
+        btc_idx = self.exchange.getAssetIndex("BTC-USD")
+        for name, node in outputs.items():
+            df[f"{name}_atlas"] = node.cache()[btc_idx].T
+        cov = df["Close"].rolling(window).cov(df["Open"], ddof=0)
+        var_x = df["Open"].rolling(window).var(ddof=0)
+        var_y = df["Close"].rolling(window).var(ddof=0)
+        beta = cov / var_x
+        df["beta_pd"] = beta
+        df["alpha_pd"] = (
+            df["Close"].rolling(window).mean() - beta * df["Open"].rolling(window).mean()
+        )
+        df["resid_vol_pd"] = np.sqrt(var_y - beta * cov)
+        df["r_squared_pd"] = df["Close"].rolling(window).corr(df["Open"]) ** 2
+        df = df.iloc[window:]
+        for name in outputs:
+            self.assertTrue(np.allclose(df[f"{name}_atlas"], df[f"{name}_pd"]))
+
+    def test_kalman_observer(self):
+        q, r, q_slope = 10.0, 100.0, 1.0
+        close = AssetReadNode.make("Close", 0, self.exchange)
+        level = self.exchange.registerObserver(
+            KalmanFilterObserverNode("kf_level", close, LOCAL_LEVEL, q, r)
+        )
+        slope = self.exchange.registerObserver(
+            KalmanFilterObserverNode(
+                "kf_slope", close, LOCAL_TREND, q, r, q_slope, KalmanOutputType.SLOPE
+            )
+        )
+        self.exchange.enableNodeCache("kf_level", level, False)
+        self.exchange.enableNodeCache("kf_slope", slope, False)
+        ev = ExchangeViewNode.make(self.exchange, close)
+        allocation = AllocationNode.make(ev)
+        strategy_node_signal = StrategyNode.make(allocation)
+        strategy = ImmediateStrategy(
+            self.exchange, self.root_strategy, STRATEGY_ID, 1.0, strategy_node_signal
+        )
+        _ = self.root_strategy.addStrategy(strategy, True)
+        self.hydra.run()
+
+        df = self.get_df()
+        btc_idx = self.exchange.getAssetIndex("BTC-USD")
+        # scalar reference filters, seeded on the first observation
+        y = df["Close"].values
+        level_ref = np.empty(len(y))
+        slope_ref = np.empty(len(y))
+        l, p = y[0], r
+        x, P = np.array([y[0], 0.0]), np.diag([r, r])
+        F = np.array([[1.0, 1.0], [0.0, 1.0]])
+        Q = np.diag([q, q_slope])
+        for i, obs in enumerate(y):
+            if i > 0:
+                p += q
+                k = p / (p + r)
+                l += k * (obs - l)
+                p *= 1.0 - k
+                x = F @ x
+                P = F @ P @ F.T + Q
+                K = P[:, 0] / (P[0, 0] + r)
+                x = x + K * (obs - x[0])
+                P = P - np.outer(K, P[0, :])
+            level_ref[i] = l
+            slope_ref[i] = x[1]
+        self.assertTrue(np.allclose(level.cache()[btc_idx], level_ref))
+        self.assertTrue(np.allclose(slope.cache()[btc_idx], slope_ref))
+
+    def test_indicator_observer(self):
+        period, window = 14, 20
+        high = AssetReadNode.make("High", 0, self.exchange)
+        low = AssetReadNode.make("Low", 0, self.exchange)
+        close = AssetReadNode.make("Close", 0, self.exchange)
+        nodes = {
+            "rsi": RsiObserverNode("rsi", close, period),
+            "macd": MacdObserverNode("macd", close, 12, 26, 9, HISTOGRAM),
+            "bollinger": BollingerObserverNode("bollinger", close, window),
+            "stochastic": StochasticObserverNode("stochastic", high, low, close, period),
+            "adx": AdxObserverNode("adx", high, low, close, period),
+        }
+        for name, node in nodes.items():
+            nodes[name] = self.exchange.registerObserver(node)
+            self.exchange.enableNodeCache(name, nodes[name], False)
+        ev = ExchangeViewNode.make(self.exchange, close)
+        allocation = AllocationNode.make(ev)
+        strategy_node_signal = StrategyNode.make(allocation)
+        strategy = ImmediateStrategy(
+            self.exchange, self.root_strategy, STRATEGY_ID, 1.0, strategy_node_signal
+        )
+        _ = self.root_strategy.addStrategy(strategy, True)
+        self.hydra.run()
+
+        df = self.get_df()
+        btc_idx = self.exchange.getAssetIndex("BTC-USD")
+        cache = {name: node.cache()[btc_idx] for name, node in nodes.items()}
+
+        # recursive averages start from the first observation like pandas
+        # ewm with adjust=False
+        def wilder(s):
+            return s.ewm(alpha=1.0 / period, adjust=False).mean()
+
+        delta = df["Close"].diff()
+        gain = wilder(delta.clip(lower=0))
+        loss = wilder((-delta).clip(lower=0))
+        rsi = 100 * gain / (gain + loss)
+        self.assertTrue(np.allclose(cache["rsi"][1:], rsi.values[1:]))
+
+        line = (
+            df["Close"].ewm(span=12, adjust=False).mean()
+            - df["Close"].ewm(span=26, adjust=False).mean()
+        )
+        histogram = line - line.ewm(span=9, adjust=False).mean()
+        self.assertTrue(np.allclose(cache["macd"], histogram.values))
+
+        mean = df["Close"].rolling(window).mean()
+        std = df["Close"].rolling(window).std(ddof=0)
+        percent_b = (df["Close"] - (mean - 2 * std)) / (4 * std)
+        self.assertTrue(
+            np.allclose(cache["bollinger"][window:], percent_b.values[window:])
+        )
+
+        highest = df["High"].rolling(period).max()
+        lowest = df["Low"].rolling(period).min()
+        stochastic = 100 * (df["Close"] - lowest) / (highest - lowest)
+        self.assertTrue(
+            np.allclose(cache["stochastic"][period:], stochastic.values[period:])
+        )
+
+        prev_close = df["Close"].shift(1)
+        true_range = np.maximum(df["High"], prev_close) - np.minimum(
+            df["Low"], prev_close
+        )
+        true_range.iloc[0] = df["High"].iloc[0] - df["Low"].iloc[0]
+        up = df["High"].diff()
+        down = -df["Low"].diff()
+        plus_dm = pd.Series(np.where((up > down) & (up > 0), up, 0.0), df.index)
+        minus_dm = pd.Series(np.where((down > up) & (down > 0), down, 0.0), df.index)
+        plus_dm.iloc[0] = minus_dm.iloc[0] = np.nan
+        atr = wilder(true_range)
+        plus_di = 100 * wilder(plus_dm) / atr
+        minus_di = 100 * wilder(minus_dm) / atr
+        adx = wilder(100 * (plus_di - minus_di).abs() / (plus_di + minus_di))
+        self.assertTrue(np.allclose(cache["adx"][1:], adx.values[1:]))
+
+    def test_batch_cache(self):
+        window = 5
+        close = AssetReadNode.make("Close", 0, self.exchange)
+        prev_close = AssetReadNode.make("Close", -1, self.exchange)
+        change = AssetOpNode.make(close, prev_close, AssetOpType.SUBTRACT)
+        mean = self.exchange.registerObserver(
+            MeanObserverNode("change_mean", change, window)
+        )
+        # eager caching of path independent nodes is computed over the full
+        # history without stepping the exchange
+        self.exchange.enableNodeCache("change", change, True)
+        self.exchange.enableNodeCache("change_mean", mean, True)
+
+        df = self.get_df()
+        btc_idx = self.exchange.getAssetIndex("BTC-USD")
+        df["change_atlas"] = change.cache()[btc_idx].T
+        df["change_pd"] = df["Close"].diff()
+        df["change_mean_atlas"] = mean.cache()[btc_idx].T
+        df["change_mean_pd"] = df["Close"].diff().rolling(window).mean()
+        df = df.iloc[window + 1 :]
+        self.assertTrue(np.allclose(df["change_atlas"], df["change_pd"]))
+        self.assertTrue(np.allclose(df["change_mean_atlas"], df["change_mean_pd"]))
+
     def test_observer_cache(self):
         window = 5
         close = AssetReadNode.make("Close", 0, self.exchange)
@@ -203,6 +622,35 @@ class TestObserver(unittest.TestCase):
         df.replace(np.nan, 0, inplace=True)
         self.assertTrue(np.allclose(df["close_skew_atlas"], df["close_skew_pandas"]))
 
+    def test_kurt_observer(self):
+        window = 20
+        close = AssetReadNode.make("Close", 0, self.exchange)
+        kurt = self.exchange.registerObserver(
+            KurtosisObserverNode("kurt", close, window)
+        )
+        skew = self.exchange.registerObserver(
+            SkewnessObserverNode("skew", close, window)
+        )
+        self.exchange.enableNodeCache("kurt", kurt, False)
+        self.exchange.enableNodeCache("skew", skew, False)
+        ev = ExchangeViewNode.make(self.exchange, close)
+        allocation = AllocationNode.make(ev)
+        strategy_node_signal = StrategyNode.make(allocation)
+        strategy = ImmediateStrategy(
+            self.exchange, self.root_strategy, STRATEGY_ID, 1.0, strategy_node_signal
+        )
+        _ = self.root_strategy.addStrategy(strategy, True)
+        self.hydra.run()
+        df = self.get_df()
+        btc_idx = self.exchange.getAssetIndex("BTC-USD")
+        df["close_kurt_atlas"] = kurt.cache()[btc_idx].T
+        df["close_skew_atlas"] = skew.cache()[btc_idx].T
+        df["close_kurt_pd"] = df["Close"].rolling(window).apply(scipy.stats.kurtosis)
+        df["close_skew_pd"] = df["Close"].rolling(window).apply(scipy.stats.skew)
+        df = df.iloc[window:]
+        self.assertTrue(np.allclose(df["close_kurt_atlas"], df["close_kurt_pd"]))
+        self.assertTrue(np.allclose(df["close_skew_atlas"], df["close_skew_pd"]))
+
     def test_lr(self):
         walk_forward_window = 3
         training_window = 5
@@ -67,6 +67,38 @@ class TestRisk(unittest.TestCase):
         # print(matrix_subset)
         self.assertTrue(np.allclose(cov_matrix, matrix_subset, atol=1e-8))
 
+    def testIncrementalCovariance(self):
+        # the rolling covariance matches the full recomputation on the
+        # trigger date well past the first window
+        monthly_trigger_node = StrategyMonthlyRunnerNode.make(self.exchange)
+        covariance_node = self.exchange.getCovarianceNode(
+            "30_PERIOD_INC_COV", monthly_trigger_node, 30, CovarianceType.INCREMENTAL
+        )
+        # recomputing from the window every step gives the same matrix
+        recomputed_node = self.exchange.getCovarianceNode(
+            "30_PERIOD_INC_COV_1",
+            monthly_trigger_node,
+            30,
+            CovarianceType.INCREMENTAL,
+            recompute_interval=1,
+        )
+        self.hydra.build()
+        self.runTo("2010-06-01")
+        self.hydra.step()
+        cov_matrix = covariance_node.getCovarianceMatrix()
+        recomputed_matrix = recomputed_node.getCovarianceMatrix()
+
+        end_idx = self.data.index.get_loc("2010-06-01")
+        start_idx = end_idx - 30
+        matrix_subset = self.data.iloc[start_idx : end_idx + 1, :]
+        ordered_columns = sorted(
+            matrix_subset.columns, key=lambda x: self.exchange.getAssetMap()[x]
+        )
+        matrix_subset = matrix_subset[ordered_columns]
+        matrix_subset = matrix_subset.pct_change().dropna().cov(ddof=1)
+        self.assertTrue(np.allclose(cov_matrix, matrix_subset, atol=1e-8))
+        self.assertTrue(np.allclose(recomputed_matrix, matrix_subset, atol=1e-8))
+
     def testRankNode(self):
         monthly_trigger_node = StrategyMonthlyRunnerNode.make(self.exchange)
 
@@ -118,6 +150,208 @@ class TestRisk(unittest.TestCase):
         allocation = strategy.getAllocationBuffer()
         self.assertTrue(np.allclose(allocation, returns))
 
+    def testNExtremeAllocation(self):
+        # the allocation selects the 2 largest and smallest returns itself,
+        # without a rank node in front of it
+        spec = f"""
+        [{{
+            "name": "{STRATEGY_ID}",
+            "exchange": "{EXCHANGE_ID}",
+            "nodes": {{
+                "close": {{"type": "read", "column": "close"}},
+                "prev": {{"type": "read", "column": "close", "offset": -1}},
+                "spread": {{"type": "op", "op": "divide", "left": "close", "right": "prev"}},
+                "ev": {{"type": "exchange_view", "parent": "spread"}}
+            }},
+            "allocation": {{"signal": "ev", "type": "nextreme", "alloc_param": 2}}
+        }}]
+        """
+        self.hydra.build()
+        strategy = self.hydra.addStrategySpec(spec, self.root_strategy)[0]
+        self.runTo("2010-02-01")
+        self.hydra.step()
+        current_time = self.exchange.getCurrentTimestamp()
+        current_time = pd.to_datetime(current_time, unit="ns")
+        data = self.data.loc[:current_time]
+        returns = data.pct_change().iloc[-1]
+        ordered_columns = sorted(
+            data.columns, key=lambda x: self.exchange.getAssetMap()[x]
+        )
+        returns = returns[ordered_columns]
+        expected = pd.Series(0.0, index=returns.index)
+        expected.loc[returns.nlargest(2).index] = 0.25
+        expected.loc[returns.nsmallest(2).index] = -0.25
+        allocation = strategy.getAllocationBuffer()
+        self.assertTrue(np.allclose(allocation, expected.values))
+
+    def testNLargestAllocationParam(self):
+        # NLARGEST expects a signal that is already selected, the parameter
+        # does not select from it and every valid asset is weighted equally
+        spec = f"""
+        [{{
+            "name": "{STRATEGY_ID}",
+            "exchange": "{EXCHANGE_ID}",
+            "nodes": {{
+                "close": {{"type": "read", "column": "close"}},
+                "ev": {{"type": "exchange_view", "parent": "close"}}
+            }},
+            "allocation": {{"signal": "ev", "type": "nlargest", "alloc_param": 2}}
+        }}]
+        """
+        self.hydra.build()
+        strategy = self.hydra.addStrategySpec(spec, self.root_strategy)[0]
+        self.runTo("2010-02-01")
+        self.hydra.step()
+        allocation = strategy.getAllocationBuffer()
+        expected = np.full(len(allocation), 1.0 / len(allocation))
+        self.assertTrue(np.allclose(allocation, expected))
+
+    def testGroupNormalize(self):
+        # long the assets beating their group's mean return, short the rest
+        asset_map = self.exchange.getAssetMap()
+        groups = [i % 2 for i in range(len(asset_map))]
+        asset_read_node = AssetReadNode.make("close", 0, self.exchange)
+        asser_read_previouse_node = AssetReadNode.make("close", -1, self.exchange)
+        spread = AssetOpNode.make(
+            asset_read_node, asser_read_previouse_node, AssetOpType.DIVIDE
+        )
+        demeaned = GroupNormalizeNode.make(spread, groups, GroupOpType.DEMEAN)
+        exchange_view = ExchangeViewNode.make(self.exchange, demeaned)
+        allocation = AllocationNode.make(
+            exchange_view, AllocationType.CONDITIONAL_SPLIT, 0.0
+        )
+        strategy_node = StrategyNode.make(allocation)
+        strategy = ImmediateStrategy(
+            self.exchange, self.root_strategy, STRATEGY_ID, 1.0, strategy_node
+        )
+        _ = self.root_strategy.addStrategy(strategy, True)
+        self.runTo("2010-02-01")
+        self.hydra.step()
+        current_time = self.exchange.getCurrentTimestamp()
+        current_time = pd.to_datetime(current_time, unit="ns")
+        data = self.data.loc[:current_time]
+        returns = data.pct_change().iloc[-1]
+        ordered_columns = sorted(data.columns, key=lambda x: asset_map[x])
+        returns = returns[ordered_columns]
+        expected = returns - returns.groupby(groups).transform("mean").values
+        allocation = strategy.getAllocationBuffer()
+        self.assertTrue(np.array_equal(np.sign(allocation), np.sign(expected.values)))
+
+        with self.assertRaises(RuntimeError):
+            GroupNormalizeNode.make(spread, groups[1:], GroupOpType.DEMEAN)
+
+    def runGroupNormalize(self, op, groups, param=3.0):
+        # the normalized 1 period close ratio and the one computed by pandas,
+        # at the first step of february
+        close = AssetReadNode.make("close", 0, self.exchange)
+        prev = AssetReadNode.make("close", -1, self.exchange)
+        spread = AssetOpNode.make(close, prev, AssetOpType.DIVIDE)
+        if isinstance(groups, list):
+            normalized = GroupNormalizeNode.make(spread, groups, op, param)
+        else:
+            normalized = GroupNormalizeNode.make(spread, groups(close), op, param)
+        self.exchange.enableNodeCache("group", normalized, False)
+        exchange_view = ExchangeViewNode.make(self.exchange, normalized)
+        allocation = AllocationNode.make(exchange_view, AllocationType.UNIFORM)
+        strategy = ImmediateStrategy(
+            self.exchange,
+            self.root_strategy,
+            STRATEGY_ID,
+            1.0,
+            StrategyNode.make(allocation),
+        )
+        _ = self.root_strategy.addStrategy(strategy, True)
+        self.runTo("2010-02-01")
+        self.hydra.step()
+        current_time = self.exchange.getCurrentTimestamp()
+        col = list(self.exchange.getTimestamps()).index(current_time)
+        current_time = pd.to_datetime(current_time, unit="ns")
+        data = self.data.loc[:current_time]
+        asset_map = self.exchange.getAssetMap()
+        ordered_columns = sorted(data.columns, key=lambda x: asset_map[x])
+        ratios = (data.iloc[-1] / data.iloc[-2])[ordered_columns]
+        return np.asarray(normalized.cache())[:, col], ratios
+
+    def testGroupZScore(self):
+        groups = [i % 3 for i in range(len(self.exchange.getAssetMap()))]
+        values, ratios = self.runGroupNormalize(GroupOpType.ZSCORE, groups)
+        grouped = ratios.groupby(groups)
+        expected = (ratios - grouped.transform("mean")) / grouped.transform(
+            lambda x: x.std(ddof=0)
+        )
+        self.assertTrue(np.allclose(values, expected.values))
+
+    def testGroupRank(self):
+        groups = [i % 3 for i in range(len(self.exchange.getAssetMap()))]
+        values, ratios = self.runGroupNormalize(GroupOpType.RANK, groups)
+        grouped = ratios.groupby(groups)
+        expected = (grouped.rank(method="first") - 1) / (grouped.transform("count") - 1)
+        self.assertTrue(np.allclose(values, expected.values))
+
+    def testGroupWinsorize(self):
+        groups = [i % 3 for i in range(len(self.exchange.getAssetMap()))]
+        values, ratios = self.runGroupNormalize(GroupOpType.WINSORIZE, groups, 1.0)
+        grouped = ratios.groupby(groups)
+        mean = grouped.transform("mean")
+        std = grouped.transform(lambda x: x.std(ddof=0))
+        expected = ratios.clip(mean - std, mean + std)
+        self.assertTrue(np.allclose(values, expected.values))
+
+    def testGroupNode(self):
+        # every asset is given the same large group id by a node, it is mapped
+        # to a single dense group instead of sizing the layout by the id
+        def group_node(close):
+            zero = AssetScalerNode(close, AssetOpType.MULTIPLY, 0.0)
+            return AssetScalerNode(zero, AssetOpType.ADD, 1e12)
+
+        values, ratios = self.runGroupNormalize(GroupOpType.ZSCORE, group_node)
+        expected = (ratios - ratios.mean()) / ratios.std(ddof=0)
+        self.assertTrue(np.allclose(values, expected.values))
+
+    def testCrossSectionRegression(self):
+        # neutralize the 1 period return against the previous period's return
+        close = AssetReadNode.make("close", 0, self.exchange)
+        prev = AssetReadNode.make("close", -1, self.exchange)
+        prev_2 = AssetReadNode.make("close", -2, self.exchange)
+        returns_node = AssetOpNode.make(close, prev, AssetOpType.DIVIDE)
+        prev_returns_node = AssetOpNode.make(prev, prev_2, AssetOpType.DIVIDE)
+        regression = CrossSectionRegressionNode.make(
+            returns_node, [prev_returns_node], CrossSectionOutputType.RESIDUAL
+        )
+        exchange_view = ExchangeViewNode.make(self.exchange, regression)
+        allocation = AllocationNode.make(
+            exchange_view, AllocationType.CONDITIONAL_SPLIT, 0.0
+        )
+        strategy_node = StrategyNode.make(allocation)
+        strategy = ImmediateStrategy(
+            self.exchange, self.root_strategy, STRATEGY_ID, 1.0, strategy_node
+        )
+        _ = self.root_strategy.addStrategy(strategy, True)
+        self.runTo("2010-02-01")
+        self.hydra.step()
+        current_time = self.exchange.getCurrentTimestamp()
+        current_time = pd.to_datetime(current_time, unit="ns")
+        data = self.data.loc[:current_time]
+        asset_map = self.exchange.getAssetMap()
+        ordered_columns = sorted(data.columns, key=lambda x: asset_map[x])
+        data = data[ordered_columns]
+        y = (data.iloc[-1] / data.iloc[-2]).values
+        x = (data.iloc[-2] / data.iloc[-3]).values
+        X = np.column_stack([np.ones_like(x), x])
+        beta = np.linalg.lstsq(X, y, rcond=None)[0]
+        self.assertTrue(np.allclose(regression.getFactorReturns(), beta))
+        residuals = y - X @ beta
+        allocation = strategy.getAllocationBuffer()
+        self.assertTrue(np.array_equal(np.sign(allocation), np.sign(residuals)))
+
+        with self.assertRaises(RuntimeError):
+            CrossSectionRegressionNode.make(
+                returns_node,
+                [prev_returns_node],
+                CrossSectionOutputType.FACTOR_RETURN,
+                factor=2,
+            )
+
 
 if __name__ == "__main__":
     unittest.main()
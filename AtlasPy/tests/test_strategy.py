@@ -1,3 +1,5 @@
+import tempfile
+
 import pandas as pd
 import numpy as np
 
@@ -60,6 +62,256 @@ class SimpleTestStrategy(unittest.TestCase):
         nlv *= 1.0 + avg_return
         assert strategy.getNLV() == nlv
 
+    def testStrategySpec(self) -> None:
+        spec = f"""
+        [{{
+            "name": "{STRATEGY_ID}",
+            "exchange": "{EXCHANGE_ID}",
+            "nodes": {{
+                "ev": {{"type": "exchange_view", "parent": "close"}},
+                "close": {{"type": "read", "column": "close"}}
+            }},
+            "allocation": {{"signal": "ev", "type": "uniform"}}
+        }}]
+        """
+        self.hydra.build()
+        strategies = self.hydra.addStrategySpec(spec, self.root_strategy)
+        assert len(strategies) == 1
+        strategy = strategies[0]
+        self.hydra.step()
+        assert strategy.getNLV() == self.intial_cash
+        self.hydra.step()
+
+        asset_2_return = (
+            self.asset2_close[1] - self.asset2_close[0]
+        ) / self.asset2_close[0]
+        nlv = self.intial_cash * (1 + asset_2_return)
+        assert strategy.getNLV() == nlv
+
+        # unknown node references fail without adding anything
+        with self.assertRaises(Exception):
+            self.hydra.addStrategySpec(
+                spec.replace('"parent": "close"', '"parent": "missing"'),
+                self.root_strategy,
+            )
+
+        # a batch failing on its second strategy adds neither, so the first
+        # name is still free and stepping does not touch the dropped one
+        first = spec.replace(STRATEGY_ID, "first").strip()[1:-1]
+        second = spec.replace(STRATEGY_ID, "second").strip()[1:-1]
+        bad = second.replace('"column": "close"', '"column": "close", "offset": 1')
+        with self.assertRaises(Exception):
+            self.hydra.addStrategySpec(f"[{first}, {bad}]", self.root_strategy)
+        self.hydra.step()
+        strategies = self.hydra.addStrategySpec(
+            spec.replace(STRATEGY_ID, "first"), self.root_strategy
+        )
+        assert len(strategies) == 1
+
+    def testOptimizedAlloc(self) -> None:
+        read_close = AssetReadNode.make("close", 0, self.exchange)
+        scaled = AssetScalerNode(
+            AssetScalerNode(read_close, AssetOpType.ADD, 0.0),
+            AssetOpType.MULTIPLY,
+            1.0,
+        )
+        exchange_view = ExchangeViewNode.make(self.exchange, scaled)
+        allocation = AllocationNode.make(exchange_view, AllocationType.UNIFORM, 0.0)
+        strategy_node = StrategyNode.make(allocation)
+        self.hydra.build()
+        strategy = ImmediateStrategy(
+            self.exchange, self.root_strategy, STRATEGY_ID, 1.0, strategy_node
+        )
+        _ = self.root_strategy.addStrategy(strategy, True)
+
+        # both identity scalers are removed and the view reads the close directly
+        report = strategy.getOptimizerReport()
+        self.assertEqual(len(report), 2)
+
+        self.hydra.step()
+        self.hydra.step()
+        asset_2_return = (
+            self.asset2_close[1] - self.asset2_close[0]
+        ) / self.asset2_close[0]
+        self.assertAlmostEqual(strategy.getNLV(), self.intial_cash * (1 + asset_2_return))
+
+    def testCacheBudget(self) -> None:
+        read_close = AssetReadNode.make("close", 0, self.exchange)
+        scaled = AssetScalerNode(read_close, AssetOpType.MULTIPLY, 2.0)
+        exchange_view = ExchangeViewNode.make(self.exchange, scaled)
+        allocation = AllocationNode.make(exchange_view, AllocationType.UNIFORM, 0.0)
+        strategy_node = StrategyNode.make(allocation)
+        self.hydra.build()
+
+        budget = 10**6
+        self.exchange.setCacheBudget(budget)
+        strategy = ImmediateStrategy(
+            self.exchange, self.root_strategy, STRATEGY_ID, 1.0, strategy_node
+        )
+        _ = self.root_strategy.addStrategy(strategy, True)
+
+        # the scaler is path independent so it is cached over the full history
+        report = strategy.getOptimizerReport()
+        self.assertTrue(any(r.startswith("cached") for r in report))
+        self.assertEqual(self.exchange.getCacheBudget(), budget)
+        self.assertLess(self.exchange.getCacheBudgetRemaining(), budget)
+
+        self.hydra.step()
+        self.hydra.step()
+        asset_2_return = (
+            self.asset2_close[1] - self.asset2_close[0]
+        ) / self.asset2_close[0]
+        self.assertAlmostEqual(strategy.getNLV(), self.intial_cash * (1 + asset_2_return))
+
+        # removing the strategy releases its caches back to the budget
+        del _, strategy, strategy_node, allocation, exchange_view, scaled, read_close
+        self.root_strategy = None
+        self.hydra.removeStrategy("root")
+        self.assertEqual(self.exchange.getCacheBudgetRemaining(), budget)
+
+    def testActiveAssets(self) -> None:
+        read_close = AssetReadNode.make("close", 0, self.exchange)
+        scaled = AssetScalerNode(read_close, AssetOpType.MULTIPLY, 2.0)
+        exchange_view = ExchangeViewNode.make(self.exchange, scaled)
+        exchange_view.setAssets([self.asset_id2])
+        allocation = AllocationNode.make(exchange_view, AllocationType.UNIFORM, 0.0)
+        strategy_node = StrategyNode.make(allocation)
+        self.hydra.build()
+        strategy = ImmediateStrategy(
+            self.exchange, self.root_strategy, STRATEGY_ID, 1.0, strategy_node
+        )
+        _ = self.root_strategy.addStrategy(strategy, True)
+
+        # the scaler is only read for asset2 by the view
+        report = strategy.getOptimizerReport()
+        self.assertTrue(any(r.startswith("restricted") for r in report))
+
+        # both assets have data on the third step but asset1 is outside the view
+        self.hydra.step()
+        self.hydra.step()
+        self.hydra.step()
+        allocation = strategy.getAllocationBuffer()
+        self.assertAlmostEqual(allocation[self.asset1_index], 0.0)
+        self.assertAlmostEqual(allocation[self.asset2_index], 1.0)
+
+    def testSharedActiveAssets(self) -> None:
+        read_close = AssetReadNode.make("close", 0, self.exchange)
+        scaled = AssetScalerNode(read_close, AssetOpType.MULTIPLY, 2.0)
+        self.hydra.build()
+
+        # the scaler is shared, the first strategy reads every asset and the
+        # second only asset2
+        strategies = []
+        for i, assets in enumerate([None, [self.asset_id2]]):
+            exchange_view = ExchangeViewNode.make(self.exchange, scaled)
+            if assets:
+                exchange_view.setAssets(assets)
+            allocation = AllocationNode.make(exchange_view, AllocationType.UNIFORM, 0.0)
+            strategy = ImmediateStrategy(
+                self.exchange,
+                self.root_strategy,
+                f"{STRATEGY_ID}_{i}",
+                1.0,
+                StrategyNode.make(allocation),
+            )
+            _ = self.root_strategy.addStrategy(strategy, True)
+            strategies.append(strategy)
+
+        # optimizing the second strategy must not drop asset1 from the first
+        self.hydra.step()
+        self.hydra.step()
+        self.hydra.step()
+        allocation = strategies[0].getAllocationBuffer()
+        self.assertAlmostEqual(allocation[self.asset1_index], 0.5)
+        self.assertAlmostEqual(allocation[self.asset2_index], 0.5)
+        allocation = strategies[1].getAllocationBuffer()
+        self.assertAlmostEqual(allocation[self.asset1_index], 0.0)
+        self.assertAlmostEqual(allocation[self.asset2_index], 1.0)
+
+    def testLagOfRead(self) -> None:
+        # an exchange read is only ever viewed, its lag must match reading the
+        # column further back on every step, as must a lag of that lag
+        read_close = AssetReadNode.make("close", 0, self.exchange)
+        read_prev = AssetReadNode.make("close", -1, self.exchange)
+        read_prev_2 = AssetReadNode.make("close", -2, self.exchange)
+        lagged = read_close.lag(1)
+        lagged_twice = lagged.lag(1)
+        self.assertIsInstance(lagged, LagNode)
+        self.assertIsInstance(lagged_twice, LagNode)
+        signals = [
+            AssetOpNode.make(read_close, lagged, AssetOpType.SUBTRACT),
+            AssetOpNode.make(read_close, read_prev, AssetOpType.SUBTRACT),
+            AssetOpNode.make(read_close, lagged_twice, AssetOpType.SUBTRACT),
+            AssetOpNode.make(read_close, read_prev_2, AssetOpType.SUBTRACT),
+        ]
+        self.hydra.build()
+        strategies = []
+        for i, signal in enumerate(signals):
+            exchange_view = ExchangeViewNode.make(self.exchange, signal)
+            allocation = AllocationNode.make(
+                exchange_view, AllocationType.CONDITIONAL_SPLIT, 0.0
+            )
+            strategy = ImmediateStrategy(
+                self.exchange,
+                self.root_strategy,
+                f"{STRATEGY_ID}_{i}",
+                1.0,
+                StrategyNode.make(allocation),
+            )
+            _ = self.root_strategy.addStrategy(strategy, True)
+            strategies.append(strategy)
+
+        for _ in self.exchange.getTimestamps():
+            self.hydra.step()
+            for i in range(0, len(strategies), 2):
+                self.assertTrue(
+                    np.allclose(
+                        strategies[i].getAllocationBuffer(),
+                        strategies[i + 1].getAllocationBuffer(),
+                    )
+                )
+        for i in range(0, len(strategies), 2):
+            self.assertAlmostEqual(
+                strategies[i].getNLV(), strategies[i + 1].getNLV()
+            )
+
+    def testGenerateNative(self) -> None:
+        read_close = AssetReadNode.make("close", 0, self.exchange)
+        read_prev = AssetReadNode.make("close", -1, self.exchange)
+        change = AssetOpNode.make(read_close, read_prev, AssetOpType.SUBTRACT)
+        exchange_view = ExchangeViewNode.make(self.exchange, change)
+        allocation = AllocationNode.make(
+            exchange_view, AllocationType.CONDITIONAL_SPLIT, 0.0
+        )
+        strategy_node = StrategyNode.make(allocation)
+        self.hydra.build()
+        strategy = ImmediateStrategy(
+            self.exchange, self.root_strategy, STRATEGY_ID, 1.0, strategy_node
+        )
+        _ = self.root_strategy.addStrategy(strategy, True)
+
+        source = strategy.generateNative()
+        self.assertIn("atlas_signal", source)
+        self.assertIn("read(", source)
+
+        def run():
+            allocations = []
+            for _ in self.exchange.getTimestamps():
+                self.hydra.step()
+                allocations.append(np.copy(strategy.getAllocationBuffer()))
+            self.hydra.reset()
+            return np.array(allocations)
+
+        # the compiled signal must allocate exactly like the interpreted one
+        interpreted = run()
+        extension = ".dll" if os.name == "nt" else ".so"
+        with tempfile.TemporaryDirectory() as tmp:
+            library_path = os.path.join(tmp, "native_strategy" + extension)
+            strategy.compileNative(library_path, EIGEN_INCLUDE_DIR)
+            native = run()
+            strategy.unloadNative()
+        self.assertTrue(np.allclose(native, interpreted))
+
     def testFixedAlloc(self) -> None:
         alloc = [(self.asset_id1, 0.3), (self.asset_id2, 0.7)]
         allocation = FixedAllocationNode.make(alloc, self.exchange, 0.0)
@@ -117,6 +369,36 @@ class SimpleTestStrategy(unittest.TestCase):
         self.assertAlmostEqual(strategy.getNLV(), nlv - commission)
 
 
+class NodeReuseTest(unittest.TestCase):
+    def setUp(self) -> None:
+        # the close of both assets is unchanged over the third and fourth step
+        exchange_path = os.path.join(os.path.dirname(__file__), EXCHANGE_DIR_2)
+        self.hydra = Hydra()
+        self.exchange = self.hydra.addExchange(EXCHANGE_ID, exchange_path, "%Y-%m-%d")
+        self.root_strategy = MetaStrategy("root", self.exchange, None, 100.0)
+        self.hydra.addStrategy(self.root_strategy, True)
+
+    def testCleanNodeReuse(self) -> None:
+        read_close = AssetReadNode.make("close", 0, self.exchange)
+        scaled = AssetScalerNode(read_close, AssetOpType.MULTIPLY, 2.0)
+        exchange_view = ExchangeViewNode.make(self.exchange, scaled)
+        allocation = AllocationNode.make(exchange_view, AllocationType.UNIFORM, 0.0)
+        strategy_node = StrategyNode.make(allocation)
+        self.hydra.build()
+        strategy = ImmediateStrategy(
+            self.exchange, self.root_strategy, STRATEGY_ID, 1.0, strategy_node
+        )
+        _ = self.root_strategy.addStrategy(strategy, True)
+
+        # the first clean step evaluates once more to start tracking the
+        # output, the second reuses it and the changed close forces a new one
+        expected = [1, 2, 3, 3, 4]
+        for count in expected:
+            self.hydra.step()
+            self.assertEqual(scaled.getEvaluateCount(), count)
+        self.assertAlmostEqual(strategy.getAllocationBuffer().sum(), 1.0)
+
+
 class VectorBTCompare(unittest.TestCase):
     def setUp(self) -> None:
         hydra_path = os.path.join(os.path.dirname(__file__), HYDRA_DIR)
@@ -158,6 +440,63 @@ class VectorBTCompare(unittest.TestCase):
         df = df.iloc[n:]
         self.assertTrue(np.allclose(df["close_max_atlas"], df["close_max_pd"]))
 
+    def test_batched_cache(self):
+        n = 5
+        close = AssetReadNode.make("Close", 0, self.exchange)
+        close_max = self.exchange.registerObserver(
+            MaxObserverNode("close_max", close, n)
+        )
+        close_max_half = AssetScalerNode(close_max, AssetOpType.MULTIPLY, 0.5)
+        self.exchange.enableNodeCaches(
+            {"close_max_half": close_max_half, "close_max": close_max}, True
+        )
+
+        ticker = "BTC-USD"
+        btc_idx = self.exchange.getAssetIndex(ticker)
+        df = pd.read_csv(os.path.join(self.exchange_path, f"{ticker}.csv"))
+        close_max_pd = df["Close"].rolling(n).max().fillna(0).values
+        self.assertTrue(np.allclose(close_max.cache()[btc_idx][n:], close_max_pd[n:]))
+        self.assertTrue(
+            np.allclose(close_max_half.cache()[btc_idx][n:], 0.5 * close_max_pd[n:])
+        )
+
+    def test_lag_buffer(self):
+        n = 5
+        lag = 2
+        close = AssetReadNode.make("Close", 0, self.exchange)
+        close_max = self.exchange.registerObserver(
+            MaxObserverNode("close_max", close, n)
+        )
+        lagged = AssetScalerNode(close_max.lag(lag), AssetOpType.MULTIPLY, 2.0)
+        self.exchange.enableNodeCache("lagged", lagged, True)
+        self.assertLessEqual(close_max.cache().shape[1], 1)
+
+        ticker = "BTC-USD"
+        btc_idx = self.exchange.getAssetIndex(ticker)
+        df = pd.read_csv(os.path.join(self.exchange_path, f"{ticker}.csv"))
+        expected = 2.0 * df["Close"].rolling(n).max().shift(lag).values
+        warmup = n + lag
+        self.assertTrue(np.allclose(lagged.cache()[btc_idx][warmup:], expected[warmup:]))
+
+    def test_observer_of_lagged_view(self):
+        n = 5
+        lag = 1
+        close = AssetReadNode.make("Close", 0, self.exchange)
+        view = ExchangeViewNode.make(self.exchange, close)
+        lagged_mean = self.exchange.registerObserver(
+            MeanObserverNode("lagged_view_mean", view.lag(lag), n)
+        )
+        self.exchange.enableNodeCache("lagged_view_mean", lagged_mean, True)
+
+        ticker = "BTC-USD"
+        btc_idx = self.exchange.getAssetIndex(ticker)
+        df = pd.read_csv(os.path.join(self.exchange_path, f"{ticker}.csv"))
+        expected = df["Close"].shift(lag).rolling(n).mean().values
+        warmup = n + lag
+        self.assertTrue(
+            np.allclose(lagged_mean.cache()[btc_idx][warmup:], expected[warmup:])
+        )
+
     def test_ma_cross(self):
         fast_n = 50
         slow_n = 200
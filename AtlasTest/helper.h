@@ -2,7 +2,7 @@
 #include "pch.h"
 
 
-std::string exchange_path_sp500_ma = "C:/Users/natha/OneDrive/Desktop/C++/Atlas/AtlasPy/test/data_sp500_ma.h5";
-std::string exchange_path_sp500 = "C:/Users/natha/OneDrive/Desktop/C++/Atlas/AtlasPy/test/data_sp500.h5";
-std::string exchange_path =       "C:/Users/natha/OneDrive/Desktop/C++/Atlas/AtlasTest/scripts/data.h5";
-std::string exchange_path_large = "C:/Users/natha/OneDrive/Desktop/C++/Atlas/AtlasTest/scripts/data_large.h5";
+inline std::string exchange_path_sp500_ma = "C:/Users/natha/OneDrive/Desktop/C++/Atlas/AtlasPy/test/data_sp500_ma.h5";
+inline std::string exchange_path_sp500 = "C:/Users/natha/OneDrive/Desktop/C++/Atlas/AtlasPy/test/data_sp500.h5";
+inline std::string exchange_path =       "C:/Users/natha/OneDrive/Desktop/C++/Atlas/AtlasTest/scripts/data.h5";
+inline std::string exchange_path_large = "C:/Users/natha/OneDrive/Desktop/C++/Atlas/AtlasTest/scripts/data_large.h5";
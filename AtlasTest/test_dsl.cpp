@@ -0,0 +1,79 @@
+#include "helper.h"
+
+#include "ast/AllocationNode.hpp"
+#include "ast/AssetNode.hpp"
+#include "ast/ExchangeNode.hpp"
+#include "ast/StrategyNode.hpp"
+#include "exchange/Exchange.hpp"
+#include "hydra/Hydra.hpp"
+#include "strategy/MetaStrategy.hpp"
+#include "strategy/Strategy.hpp"
+#include "strategy/StrategyDSL.hpp"
+
+using namespace Atlas;
+
+//============================================================================
+class ASTStrategy final : public Strategy {
+private:
+	SharedPtr<AST::StrategyNode> m_ast;
+
+public:
+	ASTStrategy(String name, SharedPtr<Exchange> exchange,
+		SharedPtr<Allocator> parent, SharedPtr<AST::StrategyNode> ast)
+		: Strategy(std::move(name), exchange, parent, 1.0),
+		m_ast(std::move(ast)) {}
+
+	SharedPtr<AST::StrategyNode> loadAST() noexcept override { return m_ast; }
+};
+
+//============================================================================
+class DSLTests : public ::testing::Test
+{
+protected:
+	std::shared_ptr<Atlas::Hydra> hydra;
+	std::shared_ptr<Atlas::Exchange> exchange;
+	std::shared_ptr<Atlas::MetaStrategy> root;
+
+	void SetUp() override
+	{
+		hydra = std::make_shared<Hydra>();
+		exchange = hydra->addExchange("test", exchange_path).value();
+		root = std::make_shared<MetaStrategy>("root", exchange, std::nullopt, 100.0);
+		EXPECT_TRUE(hydra->addStrategy(root, true));
+		EXPECT_TRUE(hydra->build());
+	}
+};
+
+//============================================================================
+TEST_F(DSLTests, MatchesASTStrategy)
+{
+	// long assets whose close rose over the step and short those that fell,
+	// once as an AST and once as a compile time expression
+	auto read_close = AST::AssetReadNode::make("close", 0, *exchange).value();
+	auto read_prev = AST::AssetReadNode::make("close", -1, *exchange).value();
+	auto change = AST::AssetOpNode::make(
+		read_close, read_prev, AST::AssetOpType::SUBTRACT).value();
+	auto exchange_view = AST::ExchangeViewNode::make(exchange, change);
+	auto allocation = AST::AllocationNode::make(
+		exchange_view, AllocationType::CONDITIONAL_SPLIT, 0.0).value();
+	auto ast_strategy = std::make_shared<ASTStrategy>(
+		"ast", exchange, root, AST::StrategyNode::make(allocation));
+	EXPECT_TRUE(root->addStrategy(ast_strategy));
+
+	using namespace Atlas::DSL;
+	auto dsl_strategy = makeStrategy("dsl", exchange, root, 1.0,
+		ConditionalSplit(Read<"close">() - Read<"close", -1>(), 0.0));
+	EXPECT_TRUE(root->addStrategy(dsl_strategy));
+
+	for (size_t i = 0; i < exchange->getTimestamps().size(); ++i)
+	{
+		hydra->step();
+		auto ast_weights = ast_strategy->getAllocationBuffer();
+		auto dsl_weights = dsl_strategy->getAllocationBuffer();
+		for (Eigen::Index j = 0; j < ast_weights.size(); ++j)
+		{
+			EXPECT_DOUBLE_EQ(dsl_weights(j), ast_weights(j));
+		}
+		EXPECT_DOUBLE_EQ(dsl_strategy->getNLV(), ast_strategy->getNLV());
+	}
+}
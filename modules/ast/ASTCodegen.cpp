@@ -0,0 +1,445 @@
+#include <cerrno>
+#include <filesystem>
+#include <format>
+#include <fstream>
+
+#include "AtlasMacros.hpp"
+#include "exchange/Exchange.hpp"
+#include "ast/AssetNode.hpp"
+#include "ast/AssetLogical.hpp"
+#include "ast/ExchangeNode.hpp"
+#include "ast/ASTCodegen.hpp"
+
+// included last so the platform macros do not leak into the Atlas headers
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <dlfcn.h>
+#include <spawn.h>
+#include <sys/wait.h>
+
+extern char **environ;
+#endif
+
+namespace Atlas {
+
+namespace AST {
+
+//============================================================================
+static String literal(double value) noexcept {
+  if (std::isnan(value)) {
+    return "nan";
+  }
+  if (std::isinf(value)) {
+    return value > 0 ? "inf" : "-inf";
+  }
+  // shortest representation that round trips, kept a double literal
+  String s = std::format("{}", value);
+  if (s.find_first_of(".e") == String::npos) {
+    s += ".0";
+  }
+  return s;
+}
+
+//============================================================================
+static String opSymbol(AssetOpType op_type) noexcept {
+  switch (op_type) {
+  case AssetOpType::ADD:
+    return "+";
+  case AssetOpType::SUBTRACT:
+    return "-";
+  case AssetOpType::MULTIPLY:
+    return "*";
+  case AssetOpType::DIVIDE:
+    return "/";
+  }
+  return "";
+}
+
+//============================================================================
+static String compSymbol(AssetCompType comp_type) noexcept {
+  switch (comp_type) {
+  case AssetCompType::EQUAL:
+    return "==";
+  case AssetCompType::NOT_EQUAL:
+    return "!=";
+  case AssetCompType::GREATER:
+    return ">";
+  case AssetCompType::GREATER_EQUAL:
+    return ">=";
+  case AssetCompType::LESS:
+    return "<";
+  case AssetCompType::LESS_EQUAL:
+    return "<=";
+  }
+  return "";
+}
+
+//============================================================================
+NativeLibrary::~NativeLibrary() noexcept {
+#ifdef _WIN32
+  FreeLibrary(static_cast<HMODULE>(m_handle));
+#else
+  dlclose(m_handle);
+#endif
+}
+
+//============================================================================
+Result<SharedPtr<NativeLibrary>, AtlasException>
+NativeLibrary::load(String const &path) noexcept {
+#ifdef _WIN32
+  HMODULE handle = LoadLibraryA(path.c_str());
+  if (!handle) {
+    return Err("Failed to load native strategy: " + path);
+  }
+  auto signal =
+      reinterpret_cast<NativeSignal>(GetProcAddress(handle, "atlas_signal"));
+  if (!signal) {
+    FreeLibrary(handle);
+    return Err("atlas_signal not found in " + path);
+  }
+#else
+  void *handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+  if (!handle) {
+    return Err("Failed to load native strategy: " + path);
+  }
+  auto signal = reinterpret_cast<NativeSignal>(dlsym(handle, "atlas_signal"));
+  if (!signal) {
+    dlclose(handle);
+    return Err("atlas_signal not found in " + path);
+  }
+#endif
+  return std::make_shared<NativeLibrary>(handle, signal);
+}
+
+//============================================================================
+ASTCodegen::ASTCodegen(Exchange &exchange) noexcept : m_exchange(exchange) {}
+
+//============================================================================
+ASTCodegen::~ASTCodegen() noexcept {}
+
+//============================================================================
+String ASTCodegen::declare(String const &expr) noexcept {
+  String name = "v" + std::to_string(m_lines.size());
+  m_lines.push_back("  Vec " + name + " = " + expr + ";");
+  return name;
+}
+
+//============================================================================
+Result<String, AtlasException>
+ASTCodegen::emit(StrategyBufferOpNode const &node) noexcept {
+  if (auto it = m_names.find(&node); it != m_names.end()) {
+    return it->second;
+  }
+
+  String name;
+  switch (node.getType()) {
+  case NodeType::ASSET_READ: {
+    auto const &read = static_cast<AssetReadNode const &>(node);
+    name = declare(std::format("read({}, {})", read.getColumn(),
+                               std::abs(read.getRowOffset())));
+    break;
+  }
+  case NodeType::ASSET_MEDIAN: {
+    auto const &median = static_cast<AssetMedianNode const &>(node);
+    name = declare(std::format("(read({}, 0) + read({}, 0)) / 2.0",
+                               median.getCol1(), median.getCol2()));
+    break;
+  }
+  case NodeType::ASSET_SCALAR: {
+    auto const &scaler = static_cast<AssetScalerNode const &>(node);
+    auto parent = emit(*scaler.getParent());
+    if (!parent) {
+      return parent;
+    }
+    name = declare(*parent + " " + opSymbol(scaler.getOpType()) + " " +
+                   literal(scaler.getScale()));
+    break;
+  }
+  case NodeType::ASSET_OP: {
+    auto const &op = static_cast<AssetOpNode const &>(node);
+    auto left = emit(*op.getLeft());
+    if (!left) {
+      return left;
+    }
+    auto right = emit(*op.getRight());
+    if (!right) {
+      return right;
+    }
+    name = declare(*left + " " + opSymbol(op.getOpType()) + " " + *right);
+    break;
+  }
+  case NodeType::ASSET_FUNCTION: {
+    auto const &func = static_cast<AssetFunctionNode const &>(node);
+    auto parent = emit(*func.getParent());
+    if (!parent) {
+      return parent;
+    }
+    switch (func.getFuncType()) {
+    case AssetFunctionType::ABS:
+      name = declare(*parent + ".abs()");
+      break;
+    case AssetFunctionType::SIGN:
+      name = declare(*parent + ".sign()");
+      break;
+    case AssetFunctionType::POWER:
+      name = declare(*parent + ".pow(" +
+                     literal(func.getFuncParam().value_or(1.0)) + ")");
+      break;
+    case AssetFunctionType::LOG:
+      name = declare(*parent + ".log()");
+      break;
+    }
+    break;
+  }
+  case NodeType::ASSET_IF: {
+    auto const &if_node = static_cast<AssetIfNode const &>(node);
+    auto left = emit(*if_node.m_left_eval);
+    if (!left) {
+      return left;
+    }
+    auto right = emit(*if_node.m_right_eval);
+    if (!right) {
+      return right;
+    }
+    name = declare("(" + *left + " " + compSymbol(if_node.m_comp_type) + " " +
+                   *right + ").cast<double>()");
+    break;
+  }
+  case NodeType::ASSET_COMP: {
+    auto const &comp = static_cast<AssetCompNode const &>(node);
+    Vector<String> args;
+    for (auto const &input : {comp.getLeftEval(), comp.getRightEval(),
+                              comp.getTrueEval(), comp.getFalseEval()}) {
+      auto arg = emit(*input);
+      if (!arg) {
+        return arg;
+      }
+      args.push_back(*arg);
+    }
+    String logical =
+        comp.getLogicalType() == LogicalType::AND ? " && " : " || ";
+    name = declare("((" + args[0] + " != 0)" + logical + "(" + args[1] +
+                   " != 0)).select(" + args[2] + ", " + args[3] + ")");
+    break;
+  }
+  case NodeType::EXCHANGE_VIEW: {
+    auto const &view = static_cast<ExchangeViewNode const &>(node);
+    if (view.m_left_view) {
+      return Err("Codegen does not support exchange views used as signals");
+    }
+    auto input = emit(*view.m_asset_op_node);
+    if (!input) {
+      return input;
+    }
+    name = declare(*input);
+    for (auto const &filter : view.m_filters) {
+      String op;
+      String lhs = name;
+      switch (filter->type) {
+      case ExchangeViewFilterType::GREATER_THAN:
+        op = ">";
+        break;
+      case ExchangeViewFilterType::LESS_THAN:
+        op = "<";
+        break;
+      case ExchangeViewFilterType::EQUAL_TO:
+        op = "==";
+        lhs += ".abs()";
+        break;
+      }
+      String mask = "(" + lhs + " " + op + " " + literal(filter->value) + ")";
+      if (filter->value_inplace) {
+        m_lines.push_back("  " + name + " = " + mask +
+                          ".select(Vec::Constant(asset_count, " +
+                          literal(*filter->value_inplace) + "), " + name +
+                          ");");
+      } else {
+        m_lines.push_back("  " + name + " = " + mask + ".select(" + name +
+                          ", nan);");
+      }
+    }
+    if (view.m_assets) {
+      String lanes;
+      for (auto lane : *view.m_assets) {
+        lanes += (lanes.empty() ? "" : ", ") + std::to_string(lane);
+      }
+      String mask = declare("Vec::Constant(asset_count, nan)");
+      m_lines.push_back("  for (size_t lane : {" + lanes + "}) " + mask +
+                        "(lane) = 0.0;");
+      m_lines.push_back("  " + name + " += " + mask + ";");
+    }
+    break;
+  }
+  default:
+    return Err("Codegen does not support node type " +
+               std::to_string(static_cast<int>(node.getType())));
+  }
+  m_names[&node] = name;
+  return name;
+}
+
+//============================================================================
+Result<String, AtlasException>
+ASTCodegen::generate(StrategyBufferOpNode const &node) noexcept {
+  m_names.clear();
+  m_lines.clear();
+  auto result = emit(node);
+  if (!result) {
+    return result;
+  }
+
+  String source;
+  source += "// generated by Atlas, evaluates a strategy signal for one step\n";
+  source += "#include <cmath>\n#include <cstddef>\n#include <limits>\n";
+  source += "#include <Eigen/Dense>\n\n";
+  source += "#ifdef _WIN32\n#define ATLAS_NATIVE extern \"C\" "
+            "__declspec(dllexport)\n#else\n#define ATLAS_NATIVE extern "
+            "\"C\"\n#endif\n\n";
+  source += "using Vec = Eigen::Array<double, Eigen::Dynamic, 1>;\n\n";
+  source += "ATLAS_NATIVE void atlas_signal(double const *data, size_t "
+            "asset_count,\n                              size_t column_count, "
+            "size_t idx,\n                              double *target) {\n";
+  source += "  constexpr double nan = std::numeric_limits<double>::quiet_NaN();"
+            "\n  constexpr double inf = std::numeric_limits<double>::infinity();"
+            "\n  (void)nan;\n  (void)inf;\n";
+  source += "  auto read = [&](size_t column, size_t offset) {\n"
+            "    return Eigen::Map<const Vec>(\n"
+            "        data + ((idx - offset) * column_count + column) * "
+            "asset_count,\n        asset_count);\n  };\n  (void)read;\n";
+  for (auto const &line : m_lines) {
+    source += line + "\n";
+  }
+  source += "  Eigen::Map<Vec>(target, asset_count) = " + *result + ";\n}\n";
+  m_names.clear();
+  m_lines.clear();
+  return source;
+}
+
+//============================================================================
+NativeCompiler NativeCompiler::platformDefault() noexcept {
+#ifdef _WIN32
+  return {"cl", {"/nologo", "/O2", "/LD", "/EHsc", "/std:c++20"}};
+#else
+  return {"c++", {"-O3", "-shared", "-fPIC", "-std=c++20"}};
+#endif
+}
+
+#ifdef _WIN32
+//============================================================================
+static String quoteArgument(String const &arg) noexcept {
+  // quote so that the child's command line parser gives back arg unchanged,
+  // backslashes are only escaped when they precede a quote
+  if (!arg.empty() && arg.find_first_of(" \t\n\v\"") == String::npos) {
+    return arg;
+  }
+  String quoted = "\"";
+  size_t backslashes = 0;
+  for (char c : arg) {
+    if (c == '\\') {
+      backslashes++;
+      continue;
+    }
+    quoted.append(c == '"' ? backslashes * 2 + 1 : backslashes, '\\');
+    backslashes = 0;
+    quoted += c;
+  }
+  quoted.append(backslashes * 2, '\\');
+  quoted += '"';
+  return quoted;
+}
+#endif
+
+//============================================================================
+static Result<bool, AtlasException>
+spawnProcess(Vector<String> const &args) noexcept {
+#ifdef _WIN32
+  // CreateProcess takes a single command line but does not go through a
+  // shell, each argument is quoted on its own
+  String command_line;
+  for (auto const &arg : args) {
+    if (!command_line.empty()) {
+      command_line += ' ';
+    }
+    command_line += quoteArgument(arg);
+  }
+  STARTUPINFOA startup_info{};
+  startup_info.cb = sizeof(startup_info);
+  PROCESS_INFORMATION process_info{};
+  if (!CreateProcessA(nullptr, command_line.data(), nullptr, nullptr, FALSE,
+                      0, nullptr, nullptr, &startup_info, &process_info)) {
+    return Err("Failed to start " + args[0]);
+  }
+  WaitForSingleObject(process_info.hProcess, INFINITE);
+  DWORD exit_code = 1;
+  GetExitCodeProcess(process_info.hProcess, &exit_code);
+  CloseHandle(process_info.hThread);
+  CloseHandle(process_info.hProcess);
+  if (exit_code != 0) {
+    return Err(args[0] + " exited with status " + std::to_string(exit_code));
+  }
+#else
+  Vector<char *> argv;
+  for (auto const &arg : args) {
+    argv.push_back(const_cast<char *>(arg.c_str()));
+  }
+  argv.push_back(nullptr);
+  pid_t pid;
+  if (posix_spawnp(&pid, argv[0], nullptr, nullptr, argv.data(), environ) !=
+      0) {
+    return Err("Failed to start " + args[0]);
+  }
+  int status = 0;
+  while (waitpid(pid, &status, 0) < 0) {
+    if (errno != EINTR) {
+      return Err("Failed to wait for " + args[0]);
+    }
+  }
+  if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+    return Err(args[0] + " exited with status " + std::to_string(status));
+  }
+#endif
+  return true;
+}
+
+//============================================================================
+Result<bool, AtlasException>
+ASTCodegen::compile(String const &source, String const &library_path,
+                    String const &include_dir,
+                    NativeCompiler const &compiler) noexcept {
+  std::filesystem::path source_path(library_path);
+  source_path.replace_extension(".cpp");
+  {
+    std::ofstream file(source_path);
+    if (!file) {
+      return Err("Failed to write native source: " + source_path.string());
+    }
+    file << source;
+  }
+
+  // the paths are passed as separate arguments so they are never
+  // interpreted by a shell
+  Vector<String> args{compiler.compiler};
+  args.insert(args.end(), compiler.flags.begin(), compiler.flags.end());
+#ifdef _WIN32
+  args.push_back("/I" + include_dir);
+  args.push_back(source_path.string());
+  args.push_back("/Fe:" + library_path);
+#else
+  args.push_back("-I" + include_dir);
+  args.push_back(source_path.string());
+  args.push_back("-o");
+  args.push_back(library_path);
+#endif
+  auto res = spawnProcess(args);
+  if (!res) {
+    return Err("Failed to compile native strategy: " +
+               String(res.error().what()));
+  }
+  return true;
+}
+
+} // namespace AST
+
+} // namespace Atlas
@@ -0,0 +1,101 @@
+#pragma once
+#ifdef ATLAS_EXPORTS
+#define ATLAS_API __declspec(dllexport)
+#else
+#define ATLAS_API __declspec(dllimport)
+#endif
+#include "standard/AtlasCore.hpp"
+#include "ast/BaseNode.hpp"
+#include "ast/StrategyBufferNode.hpp"
+
+namespace Atlas {
+
+namespace AST {
+
+//============================================================================
+/// <summary>
+/// Signature of the function exported by a compiled strategy. data is the
+/// exchange's data matrix, idx the current exchange index and target the
+/// asset_count long signal buffer the function writes into.
+/// </summary>
+using NativeSignal = void (*)(double const *data, size_t asset_count,
+                              size_t column_count, size_t idx,
+                              double *target);
+
+//============================================================================
+/// <summary>
+/// A shared object holding a compiled strategy signal, closed on destruction
+/// </summary>
+class NativeLibrary {
+private:
+  void *m_handle;
+  NativeSignal m_signal;
+
+public:
+  NativeLibrary(void *handle, NativeSignal signal) noexcept
+      : m_handle(handle), m_signal(signal) {}
+  NativeLibrary(NativeLibrary const &) = delete;
+  NativeLibrary &operator=(NativeLibrary const &) = delete;
+  ~NativeLibrary() noexcept;
+
+  [[nodiscard]] static Result<SharedPtr<NativeLibrary>, AtlasException>
+  load(String const &path) noexcept;
+  [[nodiscard]] NativeSignal getSignal() const noexcept { return m_signal; }
+};
+
+//============================================================================
+/// <summary>
+/// Compiler used to build native strategies, run directly with the flags as
+/// its arguments and never through a shell. The default is the platform
+/// compiler with flags that produce a library portable across machines.
+/// </summary>
+struct NativeCompiler {
+  String compiler;
+  Vector<String> flags;
+
+  [[nodiscard]] static NativeCompiler platformDefault() noexcept;
+};
+
+//============================================================================
+class ASTCodegen {
+private:
+  Exchange &m_exchange;
+
+  /// <summary>
+  /// Local variable holding the value of each node already emitted, shared
+  /// sub graphs are computed once
+  /// </summary>
+  HashMap<StrategyBufferOpNode const *, String> m_names;
+  Vector<String> m_lines;
+
+  [[nodiscard]] Result<String, AtlasException>
+  emit(StrategyBufferOpNode const &node) noexcept;
+  [[nodiscard]] String declare(String const &expr) noexcept;
+
+public:
+  ASTCodegen(Exchange &exchange) noexcept;
+  ~ASTCodegen() noexcept;
+
+  /// <summary>
+  /// Emit self contained C++ source for the per step evaluation of the node,
+  /// exporting an "atlas_signal" function matching NativeSignal. Parameters
+  /// are emitted as literals and every node is a straight line Eigen
+  /// expression. Fails on nodes that hold state across steps.
+  /// </summary>
+  [[nodiscard]] Result<String, AtlasException>
+  generate(StrategyBufferOpNode const &node) noexcept;
+
+  /// <summary>
+  /// Write the source next to the library path and build it into a shared
+  /// object with the given compiler
+  /// </summary>
+  [[nodiscard]] static Result<bool, AtlasException>
+  compile(String const &source, String const &library_path,
+          String const &include_dir,
+          NativeCompiler const &compiler =
+              NativeCompiler::platformDefault()) noexcept;
+};
+
+} // namespace AST
+
+} // namespace Atlas
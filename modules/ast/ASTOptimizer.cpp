@@ -0,0 +1,504 @@
+#include "exchange/Exchange.hpp"
+#include "ast/AssetNode.hpp"
+#include "ast/StrategyNode.hpp"
+#include "ast/ASTOptimizer.hpp"
+
+#include <algorithm>
+
+namespace Atlas {
+
+namespace AST {
+
+//============================================================================
+static String opName(AssetOpType op_type) noexcept {
+  switch (op_type) {
+  case AssetOpType::ADD:
+    return "ADD";
+  case AssetOpType::SUBTRACT:
+    return "SUBTRACT";
+  case AssetOpType::MULTIPLY:
+    return "MULTIPLY";
+  case AssetOpType::DIVIDE:
+    return "DIVIDE";
+  }
+  return "";
+}
+
+//============================================================================
+static String nodeName(NodeType type) noexcept {
+  switch (type) {
+  case NodeType::ASSET_OP:
+    return "ASSET_OP";
+  case NodeType::ASSET_COMP:
+    return "ASSET_COMP";
+  case NodeType::ASSET_IF:
+    return "ASSET_IF";
+  case NodeType::ASSET_FUNCTION:
+    return "ASSET_FUNCTION";
+  case NodeType::ASSET_MEDIAN:
+    return "ASSET_MEDIAN";
+  case NodeType::ASSET_SCALAR:
+    return "ASSET_SCALAR";
+  case NodeType::EXCHANGE_VIEW:
+    return "EXCHANGE_VIEW";
+  case NodeType::RANK_NODE:
+    return "RANK_NODE";
+  case NodeType::GROUP:
+    return "GROUP";
+  default:
+    return "NODE";
+  }
+}
+
+//============================================================================
+static size_t nodeCost(NodeType type) noexcept {
+  // static per step cost estimates relative to a single vector op. nodes that
+  // already expose their value as a view cost nothing to read.
+  switch (type) {
+  case NodeType::ASSET_READ:
+  case NodeType::ASSET_OBSERVER:
+  case NodeType::ASSET_ATR:
+  case NodeType::LAG:
+  case NodeType::WINDOW_VIEW:
+    return 0;
+  case NodeType::ASSET_OP:
+  case NodeType::ASSET_SCALAR:
+  case NodeType::ASSET_MEDIAN:
+    return 1;
+  case NodeType::ASSET_FUNCTION:
+  case NodeType::ASSET_IF:
+  case NodeType::EXCHANGE_VIEW:
+    return 2;
+  case NodeType::ASSET_COMP:
+    return 3;
+  case NodeType::RANK_NODE:
+  case NodeType::GROUP:
+    return 4;
+  case NodeType::MODEL:
+  case NodeType::ASSET_PCA:
+  case NodeType::CLUSTER:
+  case NodeType::REGRESSION:
+    return 8;
+  default:
+    return 1;
+  }
+}
+
+//============================================================================
+static bool isPure(NodeType type) noexcept {
+  // nodes without per step state, evaluating them twice in a step gives the
+  // same result
+  switch (type) {
+  case NodeType::ASSET_OP:
+  case NodeType::ASSET_SCALAR:
+  case NodeType::ASSET_FUNCTION:
+  case NodeType::ASSET_IF:
+  case NodeType::ASSET_COMP:
+  case NodeType::ASSET_MEDIAN:
+    return true;
+  default:
+    return false;
+  }
+}
+
+//============================================================================
+ASTOptimizer::ASTOptimizer(Exchange &exchange) noexcept
+    : m_exchange(exchange) {}
+
+//============================================================================
+ASTOptimizer::~ASTOptimizer() noexcept {}
+
+//============================================================================
+void ASTOptimizer::optimize(StrategyNode &strategy) noexcept {
+  strategy.optimize(*this);
+  m_visited.clear();
+  m_fan_out.clear();
+  m_inputs.clear();
+  m_nodes.clear();
+  m_pinned.clear();
+  removeDeadObservers();
+
+  // the graph is at a fixed point now so a second pass only collects the
+  // final shape of the AST for the asset lanes and the cache policy
+  strategy.optimize(*this);
+  restrictAssets();
+  if (m_exchange.getCacheBudget()) {
+    materialize();
+  }
+  markShared(strategy);
+  m_nodes.clear();
+}
+
+//============================================================================
+void ASTOptimizer::visit(StrategyBufferOpNode &node) noexcept {
+  collectObservers(&node);
+  m_pinned.insert(&node);
+  if (!m_visited.insert(&node).second) {
+    return;
+  }
+  node.optimize(*this);
+}
+
+//============================================================================
+void ASTOptimizer::visit(StrategyBufferOpNode &owner,
+                         SharedPtr<StrategyBufferOpNode> &input) noexcept {
+  collectObservers(input.get());
+  if (m_visited.insert(input.get()).second) {
+    input->optimize(*this);
+  }
+
+  // keep folding until the input reaches a fixed point, i.e. a scaler that
+  // merges into its parent may itself become an identity
+  while (auto folded = fold(input)) {
+    SharedPtr<StrategyBufferOpNode> replacement = std::move(*folded);
+    owner.replaceParent(input.get(), replacement.get());
+    owner.replaceInput(input.get(), replacement);
+    input = std::move(replacement);
+    owner.invalidateHistory();
+  }
+  m_fan_out[input.get()]++;
+  m_inputs[&owner].push_back(input.get());
+  m_nodes.emplace(input.get(), input);
+}
+
+//============================================================================
+Option<SharedPtr<StrategyBufferOpNode>>
+ASTOptimizer::fold(SharedPtr<StrategyBufferOpNode> const &node) noexcept {
+  // nodes with a cache are referenced by name through the exchange and
+  // nodes with a lag buffer through their lags, both must stay in the graph
+  // so that the buffer is filled
+  if (node->hasCache() || node->m_lag_buffer.cols()) {
+    return std::nullopt;
+  }
+  switch (node->getType()) {
+  case NodeType::ASSET_SCALAR:
+    return foldScaler(static_cast<AssetScalerNode const &>(*node));
+  case NodeType::ASSET_FUNCTION:
+    return foldFunction(static_cast<AssetFunctionNode const &>(*node));
+  case NodeType::ASSET_OP:
+    return foldOp(static_cast<AssetOpNode const &>(*node));
+  default:
+    return std::nullopt;
+  }
+}
+
+//============================================================================
+Option<SharedPtr<StrategyBufferOpNode>>
+ASTOptimizer::foldScaler(AssetScalerNode const &node) noexcept {
+  AssetOpType op_type = node.getOpType();
+  double scale = node.getScale();
+  auto const &parent = node.getParent();
+  bool additive =
+      op_type == AssetOpType::ADD || op_type == AssetOpType::SUBTRACT;
+
+  // x + 0, x - 0, x * 1 and x / 1 evaluate to the parent
+  if ((additive && scale == 0.0) || (!additive && scale == 1.0)) {
+    m_report.push_back("removed identity scaler " + opName(op_type) + " " +
+                       std::to_string(scale));
+    return parent;
+  }
+
+  if (parent->getType() != NodeType::ASSET_SCALAR || parent->hasCache() ||
+      parent->m_lag_buffer.cols()) {
+    return std::nullopt;
+  }
+
+  // merge nested scalers of the same kind into a single scaler over the
+  // grandparent, the inner scaler is left in place for any other consumers
+  auto const &inner = static_cast<AssetScalerNode const &>(*parent);
+  AssetOpType inner_op_type = inner.getOpType();
+  double inner_scale = inner.getScale();
+  bool inner_additive = inner_op_type == AssetOpType::ADD ||
+                        inner_op_type == AssetOpType::SUBTRACT;
+  SharedPtr<StrategyBufferOpNode> merged = nullptr;
+  if (additive && inner_additive) {
+    double total = (op_type == AssetOpType::ADD ? scale : -scale) +
+                   (inner_op_type == AssetOpType::ADD ? inner_scale
+                                                      : -inner_scale);
+    merged = std::make_shared<AssetScalerNode>(inner.getParent(),
+                                               AssetOpType::ADD, total);
+  } else if (op_type == inner_op_type && (op_type == AssetOpType::MULTIPLY ||
+                                          op_type == AssetOpType::DIVIDE)) {
+    merged = std::make_shared<AssetScalerNode>(inner.getParent(), op_type,
+                                               scale * inner_scale);
+  } else {
+    return std::nullopt;
+  }
+  m_report.push_back("merged nested scalers " + opName(inner_op_type) + " " +
+                     std::to_string(inner_scale) + " and " +
+                     opName(op_type) + " " + std::to_string(scale));
+  return merged;
+}
+
+//============================================================================
+Option<SharedPtr<StrategyBufferOpNode>>
+ASTOptimizer::foldFunction(AssetFunctionNode const &node) noexcept {
+  auto const &parent = node.getParent();
+  AssetFunctionType func_type = node.getFuncType();
+
+  // pow(x, 1) evaluates to the parent
+  if (func_type == AssetFunctionType::POWER && node.getFuncParam() &&
+      *node.getFuncParam() == 1.0) {
+    m_report.push_back("removed identity power function");
+    return parent;
+  }
+
+  // abs and sign are idempotent, abs(abs(x)) == abs(x)
+  if ((func_type == AssetFunctionType::ABS ||
+       func_type == AssetFunctionType::SIGN) &&
+      parent->getType() == NodeType::ASSET_FUNCTION) {
+    auto const &inner = static_cast<AssetFunctionNode const &>(*parent);
+    if (inner.getFuncType() == func_type) {
+      m_report.push_back("removed repeated idempotent function");
+      return parent;
+    }
+  }
+  return std::nullopt;
+}
+
+//============================================================================
+Option<SharedPtr<StrategyBufferOpNode>>
+ASTOptimizer::foldOp(AssetOpNode const &node) noexcept {
+  auto const &left = node.getLeft();
+  auto const &right = node.getRight();
+  if (left.get() != right.get() && !left->isSame(right.get())) {
+    return std::nullopt;
+  }
+
+  // both sides evaluate to the same values so the right side does not need to
+  // be evaluated at all. x * x is left as is as a multiply is cheaper than
+  // pow, and x / x as it's not the same as 1 for zero, inf or NaN inputs.
+  SharedPtr<StrategyBufferOpNode> folded = nullptr;
+  switch (node.getOpType()) {
+  case AssetOpType::ADD:
+    folded =
+        std::make_shared<AssetScalerNode>(left, AssetOpType::MULTIPLY, 2.0);
+    break;
+  case AssetOpType::SUBTRACT:
+    // x * 0 keeps NaN and inf propagation of x - x
+    folded =
+        std::make_shared<AssetScalerNode>(left, AssetOpType::MULTIPLY, 0.0);
+    break;
+  case AssetOpType::MULTIPLY:
+  case AssetOpType::DIVIDE:
+    return std::nullopt;
+  }
+  m_report.push_back("removed duplicate operand of " +
+                     opName(node.getOpType()));
+  return folded;
+}
+
+//============================================================================
+static Option<Vector<size_t>>
+mergeAssets(Option<Vector<size_t>> const &a,
+            Option<Vector<size_t>> const &b) noexcept {
+  if (!a || !b) {
+    return std::nullopt;
+  }
+  Vector<size_t> merged;
+  std::set_union(a->begin(), a->end(), b->begin(), b->end(),
+                 std::back_inserter(merged));
+  return merged;
+}
+
+//============================================================================
+void ASTOptimizer::restrictAssets() noexcept {
+  // order the graph so that every node comes before its inputs
+  Vector<StrategyBufferOpNode const *> order;
+  Set<StrategyBufferOpNode const *> seen;
+  auto sort = [&](auto &self, StrategyBufferOpNode const *node) -> void {
+    if (!seen.insert(node).second) {
+      return;
+    }
+    if (auto it = m_inputs.find(node); it != m_inputs.end()) {
+      for (auto input : it->second) {
+        self(self, input);
+      }
+    }
+    order.push_back(node);
+  };
+  for (auto const &[owner, inputs] : m_inputs) {
+    sort(sort, owner);
+  }
+  std::reverse(order.begin(), order.end());
+
+  // the lanes needed from a node are the union of the lanes each of its
+  // consumers needs. roots, pinned nodes and nodes with a cache that can be
+  // read from outside the graph need every lane.
+  HashMap<StrategyBufferOpNode const *, Option<Vector<size_t>>> required;
+  auto lanesOf = [&](StrategyBufferOpNode const *node) {
+    auto it = required.find(node);
+    if (it == required.end() || m_pinned.contains(node) || node->hasCache()) {
+      return Option<Vector<size_t>>(std::nullopt);
+    }
+    return it->second;
+  };
+  for (auto node : order) {
+    auto it = m_inputs.find(node);
+    if (it == m_inputs.end()) {
+      continue;
+    }
+    auto needed = node->inputAssets(lanesOf(node));
+    for (auto input : it->second) {
+      auto [slot, inserted] = required.try_emplace(input, needed);
+      if (!inserted) {
+        slot->second = mergeAssets(slot->second, needed);
+      }
+    }
+  }
+
+  size_t asset_count = m_exchange.getAssetCount();
+  for (auto const &[ptr, node] : m_nodes) {
+    // a node shared with a strategy optimized earlier keeps computing the
+    // lanes that strategy reads as well
+    auto lanes = lanesOf(ptr);
+    if (node->m_assets_restricted) {
+      lanes = mergeAssets(node->m_active_assets, lanes);
+    }
+    node->m_assets_restricted = true;
+    if (lanes && lanes->size() >= asset_count) {
+      lanes = std::nullopt;
+    }
+    if (lanes) {
+      m_report.push_back("restricted " + nodeName(node->getType()) + " " +
+                         std::to_string(node->address()) + " to " +
+                         std::to_string(lanes->size()) + " assets");
+    }
+    node->setActiveAssets(std::move(lanes));
+  }
+}
+
+//============================================================================
+void ASTOptimizer::markShared(StrategyNode const &strategy) noexcept {
+  // strategies under a meta strategy step in parallel, a node reached from
+  // the AST of more than one of them can be read from several threads at once
+  Set<StrategyBufferOpNode *> seen;
+  Vector<StrategyBufferOpNode *> stack;
+  for (auto const &[ptr, node] : m_nodes) {
+    stack.push_back(node.get());
+  }
+  while (!stack.empty()) {
+    auto node = stack.back();
+    stack.pop_back();
+    if (!seen.insert(node).second) {
+      continue;
+    }
+    if (!node->m_owner) {
+      node->m_owner = &strategy;
+    } else if (node->m_owner != &strategy) {
+      node->m_shared = true;
+    }
+    for (auto const &input : node->m_child_of) {
+      stack.push_back(input.get());
+    }
+  }
+}
+
+//============================================================================
+void ASTOptimizer::collectObservers(StrategyBufferOpNode const *node) noexcept {
+  if (!m_observer_walk.insert(node).second) {
+    return;
+  }
+  if (node->getType() == NodeType::ASSET_OBSERVER) {
+    m_observers.insert(node);
+  }
+  for (auto const &input : node->m_child_of) {
+    collectObservers(input.get());
+  }
+}
+
+//============================================================================
+void ASTOptimizer::removeDeadObservers() noexcept {
+  // only observers this AST reached before folding are candidates, any other
+  // observer held by the exchange belongs to another strategy or the user
+  for (auto const &id : m_exchange.cleanupObservers(m_observers)) {
+    m_report.push_back("removed unused observer " + id);
+  }
+  m_observers.clear();
+  m_observer_walk.clear();
+}
+
+//============================================================================
+size_t ASTOptimizer::subtreeCost(
+    StrategyBufferOpNode const *node,
+    HashMap<StrategyBufferOpNode const *, size_t> &costs) const noexcept {
+  if (auto it = costs.find(node); it != costs.end()) {
+    return it->second;
+  }
+  // without a cache every evaluation of the node re-evaluates its inputs
+  size_t cost = nodeCost(node->getType());
+  if (auto it = m_inputs.find(node); it != m_inputs.end()) {
+    for (auto input : it->second) {
+      if (!input->hasCache()) {
+        cost += subtreeCost(input, costs);
+      }
+    }
+  }
+  costs[node] = cost;
+  return cost;
+}
+
+//============================================================================
+void ASTOptimizer::materialize() noexcept {
+  HashMap<StrategyBufferOpNode const *, size_t> costs;
+  HashMap<StrategyBufferOpNode const *, Vector<StrategyBufferOpNode const *>>
+      consumers;
+  for (auto const &[owner, inputs] : m_inputs) {
+    for (auto input : inputs) {
+      consumers[input].push_back(owner);
+    }
+  }
+
+  // path independent nodes can be filled over the full history in one
+  // vectorized pass, rank them by the work saved per step
+  Vector<std::pair<size_t, StrategyBufferOpNode const *>> candidates;
+  for (auto const &[ptr, node] : m_nodes) {
+    if (node->hasCache() || !node->isPathIndependent() ||
+        nodeCost(node->getType()) == 0) {
+      continue;
+    }
+    candidates.push_back({subtreeCost(ptr, costs) * m_fan_out[ptr], ptr});
+  }
+  std::sort(candidates.begin(), candidates.end(),
+            [](auto const &a, auto const &b) { return a.first > b.first; });
+
+  size_t cache_bytes = m_exchange.cacheBytes();
+  Set<StrategyBufferOpNode const *> cached;
+  HashMap<String, SharedPtr<StrategyBufferOpNode>> caches;
+  for (auto const &[score, ptr] : candidates) {
+    // a node whose consumers are all cached is never evaluated
+    auto const &node_consumers = consumers[ptr];
+    bool unused = !node_consumers.empty() &&
+                  std::all_of(node_consumers.begin(), node_consumers.end(),
+                              [&](auto c) { return cached.contains(c); });
+    if (unused) {
+      continue;
+    }
+    if (!m_exchange.reserveCache(cache_bytes)) {
+      break;
+    }
+    auto const &node = m_nodes[ptr];
+    caches["auto_cache_" + std::to_string(node->address())] = node;
+    cached.insert(ptr);
+    m_report.push_back("cached " + nodeName(node->getType()) + " " +
+                       std::to_string(node->address()));
+  }
+
+  // fill every cache in a single pass over the exchange history
+  m_exchange.enableNodeCaches(caches, true);
+
+  // shared nodes that are not cached are evaluated once per step
+  for (auto const &[ptr, node] : m_nodes) {
+    if (cached.contains(ptr) || m_fan_out[ptr] < 2 ||
+        !isPure(node->getType())) {
+      continue;
+    }
+    node->m_memoize = true;
+    m_report.push_back("memoized " + nodeName(node->getType()) + " " +
+                       std::to_string(node->address()));
+  }
+}
+
+} // namespace AST
+
+} // namespace Atlas
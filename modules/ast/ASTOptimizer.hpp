@@ -0,0 +1,110 @@
+#pragma once
+#ifdef ATLAS_EXPORTS
+#define ATLAS_API __declspec(dllexport)
+#else
+#define ATLAS_API __declspec(dllimport)
+#endif
+#include "standard/AtlasCore.hpp"
+#include "ast/BaseNode.hpp"
+#include "ast/StrategyBufferNode.hpp"
+
+namespace Atlas {
+
+namespace AST {
+
+class AssetScalerNode;
+class AssetFunctionNode;
+class AssetOpNode;
+
+//============================================================================
+class ASTOptimizer {
+private:
+  Exchange &m_exchange;
+
+  /// <summary>
+  /// Nodes whose inputs have already been visited, the AST is a DAG so shared
+  /// sub graphs are only optimized once
+  /// </summary>
+  Set<StrategyBufferOpNode const *> m_visited;
+
+  /// <summary>
+  /// Human readable description of every rewrite applied to the AST
+  /// </summary>
+  Vector<String> m_report;
+
+  /// <summary>
+  /// Shape of the AST gathered while visiting input slots: the number of
+  /// slots referencing each node, the inputs of each owner and an owning
+  /// pointer to every node reached through a slot. Used by the cache policy.
+  /// </summary>
+  HashMap<StrategyBufferOpNode const *, size_t> m_fan_out;
+  HashMap<StrategyBufferOpNode const *, Vector<StrategyBufferOpNode const *>>
+      m_inputs;
+  HashMap<StrategyBufferOpNode const *, SharedPtr<StrategyBufferOpNode>>
+      m_nodes;
+
+  /// <summary>
+  /// Nodes visited outside of an input slot, i.e. the parent of a lag or the
+  /// left view of a signal. Their consumers read every asset.
+  /// </summary>
+  Set<StrategyBufferOpNode const *> m_pinned;
+
+  /// <summary>
+  /// Observers reachable from the AST before folding, the only ones the
+  /// optimizer may remove from the exchange once they are no longer used
+  /// </summary>
+  Set<StrategyBufferOpNode const *> m_observers;
+  Set<StrategyBufferOpNode const *> m_observer_walk;
+
+  Option<SharedPtr<StrategyBufferOpNode>>
+  fold(SharedPtr<StrategyBufferOpNode> const &node) noexcept;
+  Option<SharedPtr<StrategyBufferOpNode>>
+  foldScaler(AssetScalerNode const &node) noexcept;
+  Option<SharedPtr<StrategyBufferOpNode>>
+  foldFunction(AssetFunctionNode const &node) noexcept;
+  Option<SharedPtr<StrategyBufferOpNode>>
+  foldOp(AssetOpNode const &node) noexcept;
+  void collectObservers(StrategyBufferOpNode const *node) noexcept;
+  void removeDeadObservers() noexcept;
+  size_t subtreeCost(StrategyBufferOpNode const *node,
+                     HashMap<StrategyBufferOpNode const *, size_t> &costs)
+      const noexcept;
+  void materialize() noexcept;
+  void restrictAssets() noexcept;
+  void markShared(StrategyNode const &strategy) noexcept;
+
+public:
+  ASTOptimizer(Exchange &exchange) noexcept;
+  ~ASTOptimizer() noexcept;
+
+  /// <summary>
+  /// Run all passes over the strategy's AST: constant folding and algebraic
+  /// simplification of the node graph followed by removal of its observers no
+  /// longer consumed by any node. Nodes whose consumers only read a subset
+  /// of the assets are restricted to those lanes, and if the exchange has a
+  /// cache budget the cache policy then picks which nodes to fully cache or
+  /// memoize. Nodes also reached from another strategy's AST are marked as
+  /// shared so that their reads are locked.
+  /// </summary>
+  void optimize(StrategyNode &strategy) noexcept;
+
+  /// <summary>
+  /// Optimize the inputs of the node in the input slot then attempt to fold
+  /// the node itself, replacing the slot of owner with the smaller graph.
+  /// </summary>
+  void visit(StrategyBufferOpNode &owner,
+             SharedPtr<StrategyBufferOpNode> &input) noexcept;
+
+  /// <summary>
+  /// Optimize the inputs of a node that can not itself be replaced
+  /// </summary>
+  void visit(StrategyBufferOpNode &node) noexcept;
+
+  [[nodiscard]] Vector<String> const &getReport() const noexcept {
+    return m_report;
+  }
+};
+
+} // namespace AST
+
+} // namespace Atlas
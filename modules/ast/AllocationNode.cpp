@@ -7,6 +7,7 @@
 #include "strategy/Tracer.hpp"
 #include "ast/RiskNode.hpp"
 #include "ast/AllocationNode.hpp"
+#include "ast/ASTOptimizer.hpp"
 
 
 namespace Atlas {
@@ -194,6 +195,7 @@ AllocationNode::AllocationNode(SharedPtr<StrategyBufferOpNode> exchange_view,
     : AllocationBaseNode(type, exchange_view->getExchange(), epsilon,
                          alloc_param),
       m_exchange_view(std::move(exchange_view)) {
+  addInput(m_exchange_view);
   setWarmup(m_exchange_view->getWarmup());
 }
 
@@ -203,6 +205,11 @@ size_t AllocationNode::refreshWarmup() noexcept {
   return getWarmup();
 }
 
+//============================================================================
+void AllocationNode::optimize(ASTOptimizer &optimizer) noexcept {
+  optimizer.visit(*this, m_exchange_view);
+}
+
 //============================================================================
 Result<SharedPtr<AllocationNode>, AtlasException>
 AllocationNode::make(SharedPtr<StrategyBufferOpNode> exchange_view,
@@ -227,7 +234,7 @@ AllocationNode::make(SharedPtr<StrategyBufferOpNode> exchange_view,
       return Err("Allocation type NEXTREME requires a size_t parameter");
     }
     // n*2 must be less than the number of assets in the exchange
-    size_t asset_count = exchange_view->getExchange().getAssetCount();
+    size_t asset_count = node->getExchange().getAssetCount();
     if (node->getNAllocParam() * 2 >= asset_count) {
       return Err("Allocation type NEXTREME requires a parameter less than half "
                  "the number of assets in the exchange");
@@ -252,8 +259,19 @@ AllocationNode::pyMake(SharedPtr<StrategyBufferOpNode> exchange_view,
 //============================================================================
 void AllocationNode::evaluateChild(
     LinAlg::EigenRef<LinAlg::EigenVectorXd> target) noexcept {
-  // evaluate the exchange view to calculate the signal
-  m_exchange_view->evaluate(target);
+  // evaluate the exchange view to calculate the signal, or call the compiled
+  // version of it if one has been loaded
+  if (m_native) {
+    (*m_native)->getSignal()(m_exchange.getData().data(),
+                             static_cast<size_t>(target.size()),
+                             m_exchange.getHeaders().size(),
+                             m_exchange.currentIdx(), target.data());
+  } else {
+    auto signal = m_exchange_view->read(target);
+    if (signal.data() != target.data()) {
+      target = signal;
+    }
+  }
 
   // calculate the number of non-NaN elements in the signal
   size_t nonNanCount =
@@ -285,7 +303,20 @@ void AllocationNode::evaluateChild(
     break;
   }
   case AllocationType::NEXTREME: {
-    assert(false);
+    // short the N smallest and long the N largest signals with equal weight,
+    // with fewer than 2N valid signals each side gets half of them
+    size_t valid = m_selector.partition(target);
+    size_t count = std::min(*n_alloc_param, valid / 2);
+    m_selector.selectSmallest(target, count);
+    m_selector.selectLargest(target, count, count);
+    auto const &index = m_selector.index();
+    double weight = count > 0 ? 1.0 / static_cast<double>(2 * count) : 0.0;
+    target.setZero();
+    for (size_t i = 0; i < count; ++i) {
+      target[index[i]] = -weight;
+      target[index[count + i]] = weight;
+    }
+    break;
   }
   }
 }
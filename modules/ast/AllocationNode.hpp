@@ -9,6 +9,8 @@
 #include "standard/AtlasLinAlg.hpp"
 #include "ast/BaseNode.hpp"
 #include "ast/StrategyBufferNode.hpp"
+#include "ast/ASTCodegen.hpp"
+#include "ast/RankNode.hpp"
 
 namespace Atlas
 {
@@ -116,9 +118,16 @@ final
 private:
 	Option<size_t> n_alloc_param = std::nullopt;
 	SharedPtr<StrategyBufferOpNode> m_exchange_view;
+	// compiled signal, the node holds the library so the signal can not be
+	// unloaded while it is still evaluated
+	Option<SharedPtr<NativeLibrary>> m_native = std::nullopt;
+	CrossSectionSelector m_selector;
 public:
 	ATLAS_API ~AllocationNode() noexcept;
 
+	void setNativeLibrary(Option<SharedPtr<NativeLibrary>> library) noexcept { m_native = std::move(library); }
+	[[nodiscard]] auto const& getExchangeView() const noexcept { return m_exchange_view; }
+
 	void setNAllocParam(size_t n) noexcept { n_alloc_param = n; }
 	[[nodiscard]] size_t getNAllocParam() const noexcept { return n_alloc_param.value(); }
 
@@ -146,6 +155,7 @@ public:
 	);
 
 	[[nodiscard]] size_t refreshWarmup() noexcept override;
+	void optimize(ASTOptimizer& optimizer) noexcept override;
 	void evaluateChild(LinAlg::EigenRef<LinAlg::EigenVectorXd> target) noexcept override;
 };
 
@@ -1,10 +1,55 @@
 #include "AtlasMacros.hpp"
 #include "AssetLogical.hpp"
+#include "ast/ASTOptimizer.hpp"
 
 namespace Atlas {
 
 namespace AST {
 
+//============================================================================
+template <typename Left, typename Right, typename Target>
+static void applyComp(AssetCompType comp_type, Left const &left,
+                      Right const &right, Target &&target) noexcept {
+  switch (comp_type) {
+  case AssetCompType::EQUAL:
+    target = (left.array() == right.array()).template cast<double>();
+    break;
+  case AssetCompType::NOT_EQUAL:
+    target = (left.array() != right.array()).template cast<double>();
+    break;
+  case AssetCompType::GREATER:
+    target = (left.array() > right.array()).template cast<double>();
+    break;
+  case AssetCompType::GREATER_EQUAL:
+    target = (left.array() >= right.array()).template cast<double>();
+    break;
+  case AssetCompType::LESS:
+    target = (left.array() < right.array()).template cast<double>();
+    break;
+  case AssetCompType::LESS_EQUAL:
+    target = (left.array() <= right.array()).template cast<double>();
+    break;
+  }
+}
+
+//============================================================================
+template <typename Left, typename Right, typename True, typename False,
+          typename Target>
+static void applyLogical(LogicalType logical_type, Left const &left,
+                         Right const &right, True const &true_eval,
+                         False const &false_eval, Target &&target) noexcept {
+  switch (logical_type) {
+  case LogicalType::AND:
+    target = ((left.array() != 0) && (right.array() != 0))
+                 .select(true_eval, false_eval);
+    break;
+  case LogicalType::OR:
+    target = ((left.array() != 0) || (right.array() != 0))
+                 .select(true_eval, false_eval);
+    break;
+  }
+}
+
 //============================================================================
 AssetIfNode::AssetIfNode(SharedPtr<StrategyBufferOpNode> left_eval,
                          AssetCompType comp_type,
@@ -16,8 +61,8 @@ AssetIfNode::AssetIfNode(SharedPtr<StrategyBufferOpNode> left_eval,
   m_warmup = std::max({left_eval->getWarmup(), right_eval->getWarmup()});
   m_buffer.resize(m_left_eval->getAssetCount());
   m_buffer.setZero();
-  left_eval->addChild(this);
-  right_eval->addChild(this);
+  addInput(m_left_eval);
+  addInput(m_right_eval);
 }
 
 //============================================================================
@@ -36,32 +81,50 @@ bool AssetIfNode::isSame(StrategyBufferOpNode const* other) const noexcept {
 //============================================================================
 void AssetIfNode::evaluate(
     LinAlg::EigenRef<LinAlg::EigenVectorXd> target) noexcept {
-  m_left_eval->evaluate(target);
-  m_right_eval->evaluate(m_buffer);
+  if (isBatchCached()) {
+    target = cacheColumn();
+    return;
+  }
+  auto left = m_left_eval->read(target);
+  auto right = m_right_eval->read(m_buffer);
+
+  if (auto const &lanes = activeAssets()) {
+    applyComp(m_comp_type, left(*lanes), right(*lanes), target(*lanes));
+    clearInactiveAssets(target);
+  } else {
+    applyComp(m_comp_type, left, right, target);
+  }
+
+  cacheOutput(target);
+}
+
+//============================================================================
+void AssetIfNode::evaluateBatch(
+    LinAlg::EigenRef<LinAlg::EigenMatrixXd> target) noexcept {
+  m_left_eval->evaluateHistory(target);
+  LinAlg::EigenMatrixXd right(target.rows(), target.cols());
+  m_right_eval->evaluateHistory(right);
 
   switch (m_comp_type) {
   case AssetCompType::EQUAL:
-    target = (target.array() == m_buffer.array()).cast<double>();
+    target = (target.array() == right.array()).cast<double>().matrix();
     break;
   case AssetCompType::NOT_EQUAL:
-    target = (target.array() != m_buffer.array()).cast<double>();
+    target = (target.array() != right.array()).cast<double>().matrix();
     break;
   case AssetCompType::GREATER:
-    target = (target.array() > m_buffer.array()).cast<double>();
+    target = (target.array() > right.array()).cast<double>().matrix();
     break;
   case AssetCompType::GREATER_EQUAL:
-    target = (target.array() >= m_buffer.array()).cast<double>();
+    target = (target.array() >= right.array()).cast<double>().matrix();
     break;
   case AssetCompType::LESS:
-    target = (target.array() < m_buffer.array()).cast<double>();
+    target = (target.array() < right.array()).cast<double>().matrix();
     break;
   case AssetCompType::LESS_EQUAL:
-    target = (target.array() <= m_buffer.array()).cast<double>();
+    target = (target.array() <= right.array()).cast<double>().matrix();
     break;
   }
-
-  if (hasCache())
-    cacheColumn() = target;
 }
 
 //============================================================================
@@ -71,6 +134,17 @@ void AssetIfNode::reset() noexcept {
   m_buffer.setZero();
 }
 
+//============================================================================
+void AssetIfNode::optimize(ASTOptimizer &optimizer) noexcept {
+  optimizer.visit(*this, m_left_eval);
+  optimizer.visit(*this, m_right_eval);
+}
+
+//============================================================================
+bool AssetIfNode::inputsDirty() noexcept {
+  return m_left_eval->isDirty() || m_right_eval->isDirty();
+}
+
 //============================================================================
 void AssetCompNode::reset() noexcept {
   m_left_eval->reset();
@@ -80,6 +154,20 @@ void AssetCompNode::reset() noexcept {
   m_buffer.setZero();
 }
 
+//============================================================================
+void AssetCompNode::optimize(ASTOptimizer &optimizer) noexcept {
+  optimizer.visit(*this, m_left_eval);
+  optimizer.visit(*this, m_right_eval);
+  optimizer.visit(*this, m_true_eval);
+  optimizer.visit(*this, m_false_eval);
+}
+
+//============================================================================
+bool AssetCompNode::inputsDirty() noexcept {
+  return m_left_eval->isDirty() || m_right_eval->isDirty() ||
+         m_true_eval->isDirty() || m_false_eval->isDirty();
+}
+
 //============================================================================
 AssetCompNode::AssetCompNode(
     SharedPtr<StrategyBufferOpNode> left_eval, LogicalType logicial_type,
@@ -95,10 +183,10 @@ AssetCompNode::AssetCompNode(
                        true_eval->getWarmup(), false_eval->getWarmup()});
   m_buffer.resize(m_left_eval->getAssetCount(), 3);
   m_buffer.setZero();
-  left_eval->addChild(this);
-  right_eval->addChild(this);
-  true_eval->addChild(this);
-  false_eval->addChild(this);
+  addInput(m_left_eval);
+  addInput(m_right_eval);
+  addInput(m_true_eval);
+  addInput(m_false_eval);
 }
 
 //============================================================================
@@ -107,23 +195,44 @@ AssetCompNode::~AssetCompNode() noexcept {}
 //============================================================================
 void AssetCompNode::evaluate(
     LinAlg::EigenRef<LinAlg::EigenVectorXd> target) noexcept {
-  m_left_eval->evaluate(target);
-  m_right_eval->evaluate(m_buffer.col(RIGHT_EVAL_IDX));
-  m_true_eval->evaluate(m_buffer.col(TRUE_EVAL_IDX));
-  m_false_eval->evaluate(m_buffer.col(FALSE_EVAL_IDX));
+  if (isBatchCached()) {
+    target = cacheColumn();
+    return;
+  }
+  auto left = m_left_eval->read(target);
+  auto right = m_right_eval->read(m_buffer.col(RIGHT_EVAL_IDX));
+  auto true_eval = m_true_eval->read(m_buffer.col(TRUE_EVAL_IDX));
+  auto false_eval = m_false_eval->read(m_buffer.col(FALSE_EVAL_IDX));
+  if (auto const &lanes = activeAssets()) {
+    applyLogical(m_logical_type, left(*lanes), right(*lanes),
+                 true_eval(*lanes), false_eval(*lanes), target(*lanes));
+    clearInactiveAssets(target);
+  } else {
+    applyLogical(m_logical_type, left, right, true_eval, false_eval, target);
+  }
+  cacheOutput(target);
+}
+
+//============================================================================
+void AssetCompNode::evaluateBatch(
+    LinAlg::EigenRef<LinAlg::EigenMatrixXd> target) noexcept {
+  m_left_eval->evaluateHistory(target);
+  LinAlg::EigenMatrixXd right(target.rows(), target.cols());
+  LinAlg::EigenMatrixXd true_eval(target.rows(), target.cols());
+  LinAlg::EigenMatrixXd false_eval(target.rows(), target.cols());
+  m_right_eval->evaluateHistory(right);
+  m_true_eval->evaluateHistory(true_eval);
+  m_false_eval->evaluateHistory(false_eval);
   switch (m_logical_type) {
   case LogicalType::AND:
-    target =
-        ((target.array() != 0) && (m_buffer.col(RIGHT_EVAL_IDX).array() != 0))
-            .select(m_buffer.col(TRUE_EVAL_IDX), m_buffer.col(FALSE_EVAL_IDX));
+    target = ((target.array() != 0) && (right.array() != 0))
+                 .select(true_eval, false_eval);
+    break;
   case LogicalType::OR:
-    target =
-        ((target.array() != 0) || (m_buffer.col(RIGHT_EVAL_IDX).array() != 0))
-            .select(m_buffer.col(TRUE_EVAL_IDX), m_buffer.col(FALSE_EVAL_IDX));
+    target = ((target.array() != 0) || (right.array() != 0))
+                 .select(true_eval, false_eval);
     break;
   }
-  if (hasCache())
-    cacheColumn() = target;
 }
 
 //============================================================================
@@ -144,6 +253,7 @@ void AssetIfNode::swapRightEval(
     SharedPtr<StrategyBufferOpNode> right_eval) noexcept {
   m_right_eval = right_eval;
   m_warmup = std::max(m_warmup, m_right_eval->getWarmup());
+  invalidateHistory();
 }
 
 //============================================================================
@@ -151,6 +261,7 @@ void AssetIfNode::swapLeftEval(
     SharedPtr<StrategyBufferOpNode> left_eval) noexcept {
   m_left_eval = left_eval;
   m_warmup = std::max(m_warmup, m_left_eval->getWarmup());
+  invalidateHistory();
 }
 
 //============================================================================
@@ -158,6 +269,7 @@ void AssetCompNode::swapFalseEval(
     SharedPtr<StrategyBufferOpNode> false_eval) noexcept {
   m_false_eval = false_eval;
   m_warmup = std::max(m_warmup, m_false_eval->getWarmup());
+  invalidateHistory();
 }
 
 //============================================================================
@@ -165,6 +277,7 @@ void AssetCompNode::swapTrueEval(
     SharedPtr<StrategyBufferOpNode> true_eval) noexcept {
   m_true_eval = true_eval;
   m_warmup = std::max(m_warmup, m_true_eval->getWarmup());
+  invalidateHistory();
 }
 
 } // namespace AST
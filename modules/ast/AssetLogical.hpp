@@ -21,6 +21,7 @@ namespace AST
 class AssetIfNode final
 	: public StrategyBufferOpNode
 {
+	friend class ASTCodegen;
 private:
 	LinAlg::EigenVectorXd m_buffer;
 	size_t m_warmup = 0;
@@ -41,8 +42,17 @@ public:
 
 	[[nodiscard]] size_t getWarmup() const noexcept override { return m_warmup; }
 	[[nodiscard]] bool isSame(StrategyBufferOpNode const* other) const noexcept override;
+	[[nodiscard]] bool isPathIndependent(Set<StrategyBufferOpNode const*>& visiting) const noexcept override {
+		return m_left_eval->isPathIndependent(visiting) && m_right_eval->isPathIndependent(visiting);
+	}
 	void evaluate(LinAlg::EigenRef<LinAlg::EigenVectorXd> target) noexcept override;
+	void evaluateBatch(LinAlg::EigenRef<LinAlg::EigenMatrixXd> target) noexcept override;
 	void reset() noexcept override;
+	void optimize(ASTOptimizer& optimizer) noexcept override;
+	bool inputsDirty() noexcept override;
+	Option<Vector<size_t>> inputAssets(Option<Vector<size_t>> const& lanes) const noexcept override {
+		return lanes;
+	}
 };
 
 
@@ -82,8 +92,18 @@ public:
 	[[nodiscard]] LogicalType getLogicalType() const noexcept { return m_logical_type; }
 	[[nodiscard]] size_t getWarmup() const noexcept override { return m_warmup; }
 	[[nodiscard]] bool isSame(StrategyBufferOpNode const* other) const noexcept override;
+	[[nodiscard]] bool isPathIndependent(Set<StrategyBufferOpNode const*>& visiting) const noexcept override {
+		return m_left_eval->isPathIndependent(visiting) && m_right_eval->isPathIndependent(visiting) &&
+			m_true_eval->isPathIndependent(visiting) && m_false_eval->isPathIndependent(visiting);
+	}
 	void evaluate(LinAlg::EigenRef<LinAlg::EigenVectorXd> target) noexcept override;
+	void evaluateBatch(LinAlg::EigenRef<LinAlg::EigenMatrixXd> target) noexcept override;
 	void reset() noexcept override;
+	void optimize(ASTOptimizer& optimizer) noexcept override;
+	bool inputsDirty() noexcept override;
+	Option<Vector<size_t>> inputAssets(Option<Vector<size_t>> const& lanes) const noexcept override {
+		return lanes;
+	}
 };
 
 
@@ -1,11 +1,74 @@
 #include "AtlasMacros.hpp"
 #include "exchange/Exchange.hpp"
 #include "AssetNode.hpp"
+#include "ast/ASTOptimizer.hpp"
 
 namespace Atlas {
 
 namespace AST {
 
+//============================================================================
+template <typename Left, typename Right, typename Target>
+static void applyOp(AssetOpType op_type, Left const &left, Right const &right,
+                    Target &&target) noexcept {
+  switch (op_type) {
+  case AssetOpType::ADD:
+    target = left + right;
+    break;
+  case AssetOpType::SUBTRACT:
+    target = left - right;
+    break;
+  case AssetOpType::MULTIPLY:
+    target = left.cwiseProduct(right);
+    break;
+  case AssetOpType::DIVIDE:
+    target = left.cwiseQuotient(right);
+    break;
+  }
+}
+
+//============================================================================
+template <typename Parent, typename Target>
+static void applyScaler(AssetOpType op_type, double scale,
+                        Parent const &parent, Target &&target) noexcept {
+  switch (op_type) {
+  case AssetOpType::ADD:
+    target = parent.array() + scale;
+    break;
+  case AssetOpType::SUBTRACT:
+    target = parent.array() - scale;
+    break;
+  case AssetOpType::MULTIPLY:
+    target = parent.array() * scale;
+    break;
+  case AssetOpType::DIVIDE:
+    target = parent.array() / scale;
+    break;
+  }
+}
+
+//============================================================================
+template <typename Parent, typename Target>
+static void applyFunction(AssetFunctionType func_type,
+                          Option<double> func_param, Parent const &parent,
+                          Target &&target) noexcept {
+  switch (func_type) {
+  case AssetFunctionType::ABS:
+    target = parent.array().abs();
+    break;
+  case AssetFunctionType::SIGN:
+    target = parent.array().sign();
+    break;
+  case AssetFunctionType::POWER:
+    assert(func_param);
+    target = parent.array().pow(func_param.value());
+    break;
+  case AssetFunctionType::LOG:
+    target = parent.array().log();
+    break;
+  }
+}
+
 //============================================================================
 AssetReadNode::AssetReadNode(size_t column, int row_offset,
                              Exchange &exchange) noexcept
@@ -27,6 +90,17 @@ bool AssetReadNode::isSame(StrategyBufferOpNode const *other) const noexcept {
   return m_column == node->getColumn() && m_row_offset == node->getRowOffset();
 }
 
+//============================================================================
+Option<LinAlg::EigenRef<const LinAlg::EigenVectorXd>>
+AssetReadNode::view() noexcept {
+  return m_exchange.getSlice(m_column, m_row_offset);
+}
+
+//============================================================================
+bool AssetReadNode::inputsDirty() noexcept {
+  return m_exchange.columnChanged(m_column, m_row_offset);
+}
+
 //============================================================================
 void AssetReadNode::evaluate(
     LinAlg::EigenRef<LinAlg::EigenVectorXd> target) noexcept {
@@ -40,6 +114,18 @@ void AssetReadNode::evaluate(
   target = slice;
 }
 
+//============================================================================
+void AssetReadNode::evaluateBatch(
+    LinAlg::EigenRef<LinAlg::EigenMatrixXd> target) noexcept {
+  auto history = m_exchange.getColumnHistory(m_column);
+  assert(target.rows() == history.rows());
+  assert(target.cols() == history.cols());
+  size_t cols = static_cast<size_t>(target.cols());
+  size_t offset = std::min(m_warmup, cols);
+  target.rightCols(cols - offset) = history.leftCols(cols - offset);
+  target.leftCols(offset).setZero();
+}
+
 //============================================================================
 Result<SharedPtr<AssetReadNode>, AtlasException>
 AssetReadNode::make(String const &column, int row_offset,
@@ -76,8 +162,8 @@ AssetOpNode::AssetOpNode(SharedPtr<StrategyBufferOpNode> asset_op_left,
       std::max(m_asset_op_left->getWarmup(), m_asset_op_right->getWarmup());
   m_right_buffer.resize(getExchange().getAssetCount());
   m_right_buffer.setZero();
-  m_asset_op_left->addChild(this);
-  m_asset_op_right->addChild(this);
+  addInput(m_asset_op_left);
+  addInput(m_asset_op_right);
 }
 
 //============================================================================
@@ -97,6 +183,7 @@ void AssetOpNode::swapLeft(SharedPtr<ASTNode> asset_op,
                            SharedPtr<StrategyBufferOpNode> &left) noexcept {
   auto asset_op_node = std::dynamic_pointer_cast<AssetOpNode>(asset_op);
   std::swap(asset_op_node->getLeft(), left);
+  asset_op_node->invalidateHistory();
 }
 
 //============================================================================
@@ -104,6 +191,7 @@ void AssetOpNode::swapRight(SharedPtr<ASTNode> asset_op,
                             SharedPtr<StrategyBufferOpNode> &right) noexcept {
   auto asset_op_node = std::dynamic_pointer_cast<AssetOpNode>(asset_op);
   std::swap(asset_op_node->getRight(), right);
+  asset_op_node->invalidateHistory();
 }
 
 //============================================================================
@@ -124,6 +212,9 @@ bool AssetOpNode::isSame(StrategyBufferOpNode const *other) const noexcept {
          m_asset_op_right->isSame(other_asset_op->getRight().get());
 }
 
+//============================================================================
+AssetOpNode::~AssetOpNode() noexcept {}
+
 //============================================================================
 void AssetOpNode::reset() noexcept {
   m_asset_op_left->reset();
@@ -131,6 +222,17 @@ void AssetOpNode::reset() noexcept {
   m_right_buffer.setZero();
 }
 
+//============================================================================
+void AssetOpNode::optimize(ASTOptimizer &optimizer) noexcept {
+  optimizer.visit(*this, m_asset_op_left);
+  optimizer.visit(*this, m_asset_op_right);
+}
+
+//============================================================================
+bool AssetOpNode::inputsDirty() noexcept {
+  return m_asset_op_left->isDirty() || m_asset_op_right->isDirty();
+}
+
 //============================================================================
 void AssetOpNode::evaluate(
     LinAlg::EigenRef<LinAlg::EigenVectorXd> target) noexcept {
@@ -141,22 +243,48 @@ void AssetOpNode::evaluate(
   assert(static_cast<size_t>(target.cols()) == 1);
 #endif
 
-  m_asset_op_left->evaluate(target);
-  m_asset_op_right->evaluate(m_right_buffer);
+  if (isBatchCached()) {
+    target = cacheColumn();
+    return;
+  }
+
+  // operands that already exist in a buffer are read in place, the result is
+  // written directly into the target
+  auto left = m_asset_op_left->read(target);
+  auto right = m_asset_op_right->read(m_right_buffer);
+
+  assert(left.size() == right.size());
+
+  // when the consumers only read a subset of the assets gather just those
+  // lanes, the remaining lanes of the target are set to NaN
+  if (auto const &lanes = activeAssets()) {
+    applyOp(m_op_type, left(*lanes), right(*lanes), target(*lanes));
+    clearInactiveAssets(target);
+  } else {
+    applyOp(m_op_type, left, right, target);
+  }
+  cacheOutput(target);
+}
+
+//============================================================================
+void AssetOpNode::evaluateBatch(
+    LinAlg::EigenRef<LinAlg::EigenMatrixXd> target) noexcept {
+  m_asset_op_left->evaluateHistory(target);
+  LinAlg::EigenMatrixXd right(target.rows(), target.cols());
+  m_asset_op_right->evaluateHistory(right);
 
-  assert(target.size() == m_right_buffer.size());
   switch (m_op_type) {
   case AssetOpType::ADD:
-    target = target + m_right_buffer;
+    target += right;
     break;
   case AssetOpType::SUBTRACT:
-    target = target - m_right_buffer;
+    target -= right;
     break;
   case AssetOpType::MULTIPLY:
-    target = target.cwiseProduct(m_right_buffer);
+    target.array() *= right.array();
     break;
   case AssetOpType::DIVIDE:
-    target = target.cwiseQuotient(m_right_buffer);
+    target.array() /= right.array();
     break;
   }
 }
@@ -198,6 +326,20 @@ void AssetMedianNode::evaluate(
       (m_exchange.getSlice(m_col_1, 0) + m_exchange.getSlice(m_col_2, 0)) / 2;
 }
 
+//============================================================================
+bool AssetMedianNode::inputsDirty() noexcept {
+  return m_exchange.columnChanged(m_col_1, 0) ||
+         m_exchange.columnChanged(m_col_2, 0);
+}
+
+//============================================================================
+void AssetMedianNode::evaluateBatch(
+    LinAlg::EigenRef<LinAlg::EigenMatrixXd> target) noexcept {
+  target = (m_exchange.getColumnHistory(m_col_1) +
+            m_exchange.getColumnHistory(m_col_2)) /
+           2;
+}
+
 //============================================================================
 ATRNode::ATRNode(Exchange &exchange, size_t high, size_t low,
                  size_t window) noexcept
@@ -273,19 +415,35 @@ bool ATRNode::isSame(StrategyBufferOpNode const *other) const noexcept {
 //============================================================================
 ATRNode::~ATRNode() noexcept {}
 
+//============================================================================
+Option<LinAlg::EigenRef<const LinAlg::EigenVectorXd>> ATRNode::view() noexcept {
+  return cacheColumn(m_exchange.currentIdx());
+}
+
 //============================================================================
 void ATRNode::evaluate(
     LinAlg::EigenRef<LinAlg::EigenVectorXd> target) noexcept {
   target = cacheColumn(m_exchange.currentIdx());
 }
 
+//============================================================================
+void ATRNode::evaluateBatch(
+    LinAlg::EigenRef<LinAlg::EigenMatrixXd> target) noexcept {
+  // the full history is already precomputed in build()
+  if (!hasCache()) {
+    target.setZero();
+    return;
+  }
+  target = m_cache;
+}
+
 //============================================================================
 AssetScalerNode::AssetScalerNode(SharedPtr<StrategyBufferOpNode> parent,
                                  AssetOpType op_type, double scale) noexcept
     : StrategyBufferOpNode(NodeType::ASSET_SCALAR, parent->getExchange(),
                            parent.get()),
       m_op_type(op_type), m_scale(scale), m_parent(parent) {
-  parent->addChild(this);
+  addInput(m_parent);
 }
 
 //============================================================================
@@ -294,7 +452,24 @@ AssetScalerNode::~AssetScalerNode() noexcept {}
 //============================================================================
 void AssetScalerNode::evaluate(
     LinAlg::EigenRef<LinAlg::EigenVectorXd> target) noexcept {
-  m_parent->evaluate(target);
+  if (isBatchCached()) {
+    target = cacheColumn();
+    return;
+  }
+  auto parent = m_parent->read(target);
+  if (auto const &lanes = activeAssets()) {
+    applyScaler(m_op_type, m_scale, parent(*lanes), target(*lanes));
+    clearInactiveAssets(target);
+  } else {
+    applyScaler(m_op_type, m_scale, parent, target);
+  }
+  cacheOutput(target);
+}
+
+//============================================================================
+void AssetScalerNode::evaluateBatch(
+    LinAlg::EigenRef<LinAlg::EigenMatrixXd> target) noexcept {
+  m_parent->evaluateHistory(target);
   switch (m_op_type) {
   case AssetOpType::ADD:
     target.array() += m_scale;
@@ -314,6 +489,14 @@ void AssetScalerNode::evaluate(
 //============================================================================
 void AssetScalerNode::reset() noexcept { m_parent->reset(); }
 
+//============================================================================
+void AssetScalerNode::optimize(ASTOptimizer &optimizer) noexcept {
+  optimizer.visit(*this, m_parent);
+}
+
+//============================================================================
+bool AssetScalerNode::inputsDirty() noexcept { return m_parent->isDirty(); }
+
 //============================================================================
 bool AssetScalerNode::isSame(StrategyBufferOpNode const *other) const noexcept {
   if (other->getType() != NodeType::ASSET_SCALAR) {
@@ -332,7 +515,7 @@ AssetFunctionNode::AssetFunctionNode(SharedPtr<StrategyBufferOpNode> parent,
     : StrategyBufferOpNode(NodeType::ASSET_FUNCTION, parent->getExchange(),
                            parent.get()),
       m_func_type(func_type), m_parent(parent), m_func_param(func_param) {
-  parent->addChild(this);
+  addInput(m_parent);
 }
 
 //============================================================================
@@ -341,27 +524,50 @@ AssetFunctionNode::~AssetFunctionNode() noexcept {}
 //============================================================================
 void AssetFunctionNode::reset() noexcept { m_parent->reset(); }
 
+//============================================================================
+void AssetFunctionNode::optimize(ASTOptimizer &optimizer) noexcept {
+  optimizer.visit(*this, m_parent);
+}
+
+//============================================================================
+bool AssetFunctionNode::inputsDirty() noexcept { return m_parent->isDirty(); }
+
 //============================================================================
 void AssetFunctionNode::evaluate(
     LinAlg::EigenRef<LinAlg::EigenVectorXd> target) noexcept {
-  m_parent->evaluate(target);
+  if (isBatchCached()) {
+    target = cacheColumn();
+    return;
+  }
+  auto parent = m_parent->read(target);
+  if (auto const &lanes = activeAssets()) {
+    applyFunction(m_func_type, m_func_param, parent(*lanes), target(*lanes));
+    clearInactiveAssets(target);
+  } else {
+    applyFunction(m_func_type, m_func_param, parent, target);
+  }
+  cacheOutput(target);
+}
+
+//============================================================================
+void AssetFunctionNode::evaluateBatch(
+    LinAlg::EigenRef<LinAlg::EigenMatrixXd> target) noexcept {
+  m_parent->evaluateHistory(target);
   switch (m_func_type) {
   case AssetFunctionType::ABS:
-    target = target.array().abs();
+    target = target.array().abs().matrix();
     break;
   case AssetFunctionType::SIGN:
-    target = target.array().sign();
+    target = target.array().sign().matrix();
     break;
   case AssetFunctionType::POWER:
     assert(m_func_param);
-    target = target.array().pow(m_func_param.value());
+    target = target.array().pow(m_func_param.value()).matrix();
     break;
   case AssetFunctionType::LOG:
-    target = target.array().log();
+    target = target.array().log().matrix();
     break;
   }
-  if (hasCache())
-    cacheColumn() = target;
 }
 
 //============================================================================
@@ -42,8 +42,16 @@ public:
   isSame(StrategyBufferOpNode const* other) const noexcept override;
   [[nodiscard]] size_t getWarmup() const noexcept override { return m_warmup; }
   void reset() noexcept override{};
+  [[nodiscard]] bool isPathIndependent(
+      Set<StrategyBufferOpNode const *> &visiting) const noexcept override {
+    return true;
+  }
+  Option<LinAlg::EigenRef<const LinAlg::EigenVectorXd>> view() noexcept override;
+  bool inputsDirty() noexcept override;
   void
   evaluate(LinAlg::EigenRef<LinAlg::EigenVectorXd> target) noexcept override;
+  void
+  evaluateBatch(LinAlg::EigenRef<LinAlg::EigenMatrixXd> target) noexcept override;
 };
 
 //============================================================================
@@ -60,7 +68,7 @@ public:
   auto &getRight() const noexcept { return m_asset_op_right; }
   auto &getOpType() const noexcept { return m_op_type; }
 
-  virtual ~AssetOpNode() noexcept = default;
+  virtual ~AssetOpNode() noexcept;
 
   //============================================================================
   AssetOpNode(SharedPtr<StrategyBufferOpNode> asset_op_left,
@@ -100,9 +108,22 @@ public:
   }
   [[nodiscard]] bool
   isSame(StrategyBufferOpNode const* other) const noexcept override;
+  [[nodiscard]] bool isPathIndependent(
+      Set<StrategyBufferOpNode const *> &visiting) const noexcept override {
+    return m_asset_op_left->isPathIndependent(visiting) &&
+           m_asset_op_right->isPathIndependent(visiting);
+  }
   void reset() noexcept override;
+  void optimize(ASTOptimizer &optimizer) noexcept override;
+  bool inputsDirty() noexcept override;
+  Option<Vector<size_t>>
+  inputAssets(Option<Vector<size_t>> const &lanes) const noexcept override {
+    return lanes;
+  }
   void
   evaluate(LinAlg::EigenRef<LinAlg::EigenVectorXd> target) noexcept override;
+  void
+  evaluateBatch(LinAlg::EigenRef<LinAlg::EigenMatrixXd> target) noexcept override;
 };
 
 //============================================================================
@@ -134,9 +155,16 @@ public:
   [[nodiscard]] size_t getWarmup() const noexcept override { return 0; }
   [[nodiscard]] bool
   isSame(StrategyBufferOpNode const* other) const noexcept override;
+  [[nodiscard]] bool isPathIndependent(
+      Set<StrategyBufferOpNode const *> &visiting) const noexcept override {
+    return true;
+  }
   void reset() noexcept override {}
+  bool inputsDirty() noexcept override;
   void
   evaluate(LinAlg::EigenRef<LinAlg::EigenVectorXd> target) noexcept override;
+  void
+  evaluateBatch(LinAlg::EigenRef<LinAlg::EigenMatrixXd> target) noexcept override;
 };
 
 //============================================================================
@@ -166,11 +194,18 @@ public:
   [[nodiscard]] bool
   isSame(StrategyBufferOpNode const* other) const noexcept override;
   [[nodiscard]] size_t getWarmup() const noexcept override { return m_window; }
+  [[nodiscard]] bool isPathIndependent(
+      Set<StrategyBufferOpNode const *> &visiting) const noexcept override {
+    return true;
+  }
 
   ATLAS_API ~ATRNode() noexcept;
   void reset() noexcept override {}
+  Option<LinAlg::EigenRef<const LinAlg::EigenVectorXd>> view() noexcept override;
   void
   evaluate(LinAlg::EigenRef<LinAlg::EigenVectorXd> target) noexcept override;
+  void
+  evaluateBatch(LinAlg::EigenRef<LinAlg::EigenMatrixXd> target) noexcept override;
 };
 
 //============================================================================
@@ -187,7 +222,19 @@ public:
 
   void
   evaluate(LinAlg::EigenRef<LinAlg::EigenVectorXd> target) noexcept override;
+  void
+  evaluateBatch(LinAlg::EigenRef<LinAlg::EigenMatrixXd> target) noexcept override;
   void reset() noexcept override;
+  void optimize(ASTOptimizer &optimizer) noexcept override;
+  bool inputsDirty() noexcept override;
+  Option<Vector<size_t>>
+  inputAssets(Option<Vector<size_t>> const &lanes) const noexcept override {
+    return lanes;
+  }
+  [[nodiscard]] bool isPathIndependent(
+      Set<StrategyBufferOpNode const *> &visiting) const noexcept override {
+    return m_parent->isPathIndependent(visiting);
+  }
   [[nodiscard]] auto const &getParent() const noexcept { return m_parent; }
   [[nodiscard]] AssetOpType getOpType() const noexcept { return m_op_type; }
   [[nodiscard]] double getScale() const noexcept { return m_scale; }
@@ -213,8 +260,20 @@ public:
   ATLAS_API ~AssetFunctionNode() noexcept;
 
   void reset() noexcept override;
+  void optimize(ASTOptimizer &optimizer) noexcept override;
+  bool inputsDirty() noexcept override;
+  Option<Vector<size_t>>
+  inputAssets(Option<Vector<size_t>> const &lanes) const noexcept override {
+    return lanes;
+  }
   void
   evaluate(LinAlg::EigenRef<LinAlg::EigenVectorXd> target) noexcept override;
+  void
+  evaluateBatch(LinAlg::EigenRef<LinAlg::EigenMatrixXd> target) noexcept override;
+  [[nodiscard]] bool isPathIndependent(
+      Set<StrategyBufferOpNode const *> &visiting) const noexcept override {
+    return m_parent->isPathIndependent(visiting);
+  }
   [[nodiscard]] auto const &getParent() const noexcept { return m_parent; }
   [[nodiscard]] AssetFunctionType getFuncType() const noexcept {
     return m_func_type;
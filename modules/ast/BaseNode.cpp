@@ -13,5 +13,15 @@ ASTNode::ASTNode(NodeType type,
   }
 }
 
+//============================================================================
+void ASTNode::replaceParent(ASTNode const *old_parent,
+                            ASTNode *new_parent) noexcept {
+  for (auto &p : m_parent) {
+    if (p == old_parent) {
+      p = new_parent;
+    }
+  }
+}
+
 } // namespace AST
 } // namespace Atlas
\ No newline at end of file
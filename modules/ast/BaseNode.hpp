@@ -30,6 +30,9 @@ enum class NodeType  {
   NOP = 20,
   ASSET_PCA = 21,
   CLUSTER = 22,
+  WINDOW_VIEW = 23,
+  GROUP = 24,
+  REGRESSION = 25,
 };
 
 //============================================================================
@@ -77,6 +80,7 @@ public:
 
   NodeType getType() const noexcept { return m_type; }
   auto const &getParents() const noexcept { return m_parent; }
+  void replaceParent(ASTNode const *old_parent, ASTNode *new_parent) noexcept;
   Option<ASTNode *> getParent() const noexcept {
     if (m_parent.size() > 0) {
 			return m_parent[0];
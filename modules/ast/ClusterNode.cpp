@@ -107,6 +107,10 @@ ClusterNode::ClusterNode(Vector<SharedPtr<StrategyBufferOpNode>> features,
   m_cluster.setZero();
   m_data.resize(getAssetCount(), m_features.size());
   m_last_index = std::numeric_limits<size_t>::max();
+  for (auto const &feature : m_features) {
+    addInput(feature);
+  }
+  addInput(m_target);
 }
 //============================================================================
 ClusterNode::~ClusterNode() noexcept {}
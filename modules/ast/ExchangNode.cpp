@@ -1,6 +1,7 @@
 #include "exchange/Exchange.hpp"
 #include "ast/AssetNode.hpp"
 #include "ast/ExchangeNode.hpp"
+#include "ast/ASTOptimizer.hpp"
 
 namespace Atlas {
 
@@ -17,11 +18,17 @@ ExchangeViewNode::ExchangeViewNode(
       m_asset_op_node(std::move(asset_op_node)),
       m_warmup(m_asset_op_node->getWarmup()),
       m_left_view(std::move(left_view)) {
+  addInput(m_asset_op_node);
+  if (m_left_view) {
+    addInput(*m_left_view);
+  }
   m_view_size = m_exchange.getAssetCount();
   if (m_left_view) {
     asSignal(true);
     m_buffer.resize(m_exchange.getAssetCount());
     m_buffer.setZero();
+    m_left_buffer.resize(m_exchange.getAssetCount());
+    m_left_buffer.setZero();
   } else {
     m_buffer.resize(0);
   }
@@ -40,43 +47,36 @@ bool ExchangeViewNode::isSame(
 }
 
 //============================================================================
-void ExchangeViewNode::filter(
-    LinAlg::EigenRef<LinAlg::EigenVectorXd> view) const noexcept {
+double ExchangeViewNode::filterValue(double x) const noexcept {
+  // the filters are applied to one asset at a time, in the order they were
+  // added. NaN fails every comparison so it is never replaced.
   for (auto const &filter : m_filters) {
-    double c = filter->value;
-    Option<double> value_inplace = filter->value_inplace;
+    bool hit = false;
     switch (filter->type) {
     case ExchangeViewFilterType::GREATER_THAN:
-      if (value_inplace.has_value())
-        view = (view.array() > c)
-                   .select(value_inplace.value() *
-                               Eigen::VectorXd::Ones(view.size()),
-                           view);
-      else
-        view = (view.array() > c)
-                   .select(view, std::numeric_limits<double>::quiet_NaN());
+      hit = x > filter->value;
       break;
     case ExchangeViewFilterType::LESS_THAN:
-      if (value_inplace.has_value())
-        view = (view.array() < c)
-                   .select(value_inplace.value() *
-                               Eigen::VectorXd::Ones(view.size()),
-                           view);
-      else
-        view = (view.array() < c)
-                   .select(view, std::numeric_limits<double>::quiet_NaN());
+      hit = x < filter->value;
       break;
     case ExchangeViewFilterType::EQUAL_TO:
-      if (value_inplace.has_value())
-        view = (view.array().abs() == c)
-                   .select(value_inplace.value() *
-                               Eigen::VectorXd::Ones(view.size()),
-                           view);
-      else
-        view = (view.array().abs() == c)
-                   .select(view, std::numeric_limits<double>::quiet_NaN());
+      hit = std::abs(x) == filter->value;
       break;
     }
+    if (filter->value_inplace) {
+      x = hit ? *filter->value_inplace : x;
+    } else if (!hit) {
+      return std::numeric_limits<double>::quiet_NaN();
+    }
+  }
+  return x;
+}
+
+//============================================================================
+void ExchangeViewNode::filter(
+    LinAlg::EigenRef<LinAlg::EigenVectorXd> view) const noexcept {
+  for (Eigen::Index i = 0; i < view.size(); ++i) {
+    view(i) = filterValue(view(i));
   }
 }
 
@@ -89,6 +89,55 @@ void ExchangeViewNode::asSignal(bool v) noexcept {
   m_as_signal = v;
 }
 
+//============================================================================
+Result<bool, AtlasException>
+ExchangeViewNode::setAssets(Vector<String> const &assets) noexcept {
+  Vector<size_t> lanes;
+  for (auto const &asset : assets) {
+    auto index = m_exchange.getAssetIndex(asset);
+    if (!index) {
+      return Err("Asset not found: " + asset);
+    }
+    lanes.push_back(*index);
+  }
+  std::sort(lanes.begin(), lanes.end());
+  lanes.erase(std::unique(lanes.begin(), lanes.end()), lanes.end());
+
+  // adding the mask leaves the assets in the view as is and sets every other
+  // asset to NaN in a single pass
+  m_asset_mask.resize(m_exchange.getAssetCount());
+  m_asset_mask.setConstant(std::numeric_limits<double>::quiet_NaN());
+  m_asset_mask(lanes).setZero();
+  m_assets = std::move(lanes);
+  invalidateHistory();
+  return true;
+}
+
+//============================================================================
+void ExchangeViewNode::pySetAssets(Vector<String> const &assets) {
+  auto res = setAssets(assets);
+  if (!res) {
+    throw std::runtime_error(res.error().what());
+  }
+}
+
+//============================================================================
+Option<Vector<size_t>> ExchangeViewNode::inputAssets(
+    Option<Vector<size_t>> const &lanes) const noexcept {
+  // filters and the signal state are applied per asset so only the lanes in
+  // both the view and the consumer's lanes are needed
+  if (!m_assets) {
+    return lanes;
+  }
+  if (!lanes) {
+    return m_assets;
+  }
+  Vector<size_t> both;
+  std::set_intersection(m_assets->begin(), m_assets->end(), lanes->begin(),
+                        lanes->end(), std::back_inserter(both));
+  return both;
+}
+
 //============================================================================
 void ExchangeViewNode::reset() noexcept {
   m_asset_op_node->reset();
@@ -98,6 +147,32 @@ void ExchangeViewNode::reset() noexcept {
   m_buffer.setZero();
 }
 
+//============================================================================
+void ExchangeViewNode::optimize(ASTOptimizer &optimizer) noexcept {
+  optimizer.visit(*this, m_asset_op_node);
+  if (m_left_view) {
+    optimizer.visit(**m_left_view);
+  }
+}
+
+//============================================================================
+bool ExchangeViewNode::inputsDirty() noexcept {
+  // as a signal the view holds state from the previous step
+  if (m_as_signal) {
+    return true;
+  }
+  return m_asset_op_node->isDirty();
+}
+
+//============================================================================
+Option<LinAlg::EigenRef<const LinAlg::EigenVectorXd>>
+ExchangeViewNode::view() noexcept {
+  if (m_take_from_cache) {
+    return cacheColumn();
+  }
+  return StrategyBufferOpNode::view();
+}
+
 //============================================================================
 void ExchangeViewNode::evaluate(
     LinAlg::EigenRef<LinAlg::EigenVectorXd> target) noexcept {
@@ -112,43 +187,55 @@ void ExchangeViewNode::evaluate(
   // on evaluation start ev is pass in the current weights to override.
   // store these weights to compare agaisnt the next time step
 
-  m_asset_op_node->evaluate(target);
-  if (m_filters.size()) {
-    filter(target);
-  }
-
-  // If operating ev as a signal, then we assume that the left and right view
-  // cannot be non-Nan at the same time. We only update the EV when the opposing
-  // view is non-Nan.
-  if (m_as_signal && m_left_view) {
-    // copy over the previous ev signals to a temp buffer
-    LinAlg::EigenVectorXd temp = m_buffer;
-
-    // evaluate the left view over the ev buffer
-    (*m_left_view)->evaluate(m_buffer);
-
-    for (int i = 0; i < m_buffer.size(); i++) {
-      // if left signal not nan take that
-      if (!std::isnan(m_buffer(i))) {
-        if (m_buffer(i) * temp(i) > 0) {
-          target(i) = temp(i);
-        } else {
-          target(i) = m_buffer(i);
-        }
+  auto values = m_asset_op_node->read(target);
+  if (values.data() != target.data()) {
+    target = values;
+  }
+  // filters, the signal merge and the asset mask are applied in a single
+  // pass over the assets. as a signal the previous output is held in m_buffer
+  // and the left view is evaluated into its own buffer so nothing is copied
+  // out before the merge.
+  bool merge = m_as_signal && m_left_view.has_value();
+  if (merge) {
+    (*m_left_view)->evaluate(m_left_buffer);
+  }
+  bool has_filters = !m_filters.empty();
+  bool has_mask = m_assets.has_value();
+  if (!has_filters && !merge && !has_mask) {
+    cacheOutput(target);
+    return;
+  }
+
+  for (Eigen::Index i = 0; i < target.size(); ++i) {
+    double x = has_filters ? filterValue(target(i)) : target(i);
+
+    // If operating ev as a signal, then we assume that the left and right
+    // view cannot be non-Nan at the same time. We only update the EV when the
+    // opposing view is non-Nan.
+    if (merge) {
+      double left = m_left_buffer(i);
+      double previous = m_buffer(i);
+      // if left signal not nan take that, keeping the previous signal when
+      // it is on the same side
+      if (!std::isnan(left)) {
+        x = left * previous > 0 ? previous : left;
       }
       // else if previous signal not nan take that. NOTE: assume that if the
-      // main ev signal evaluates to NaN we still are in the position untill the
-      // right signal fires.
-      else if (!std::isnan(temp(i))) {
-        if (target(i) * temp(i) > 0 || std::isnan(target(i))) {
-          target(i) = temp(i);
-        }
+      // main ev signal evaluates to NaN we still are in the position untill
+      // the right signal fires.
+      else if (!std::isnan(previous) && (x * previous > 0 || std::isnan(x))) {
+        x = previous;
       }
     }
-    m_buffer = target;
+    if (has_mask) {
+      x += m_asset_mask(i);
+    }
+    target(i) = x;
+    if (merge) {
+      m_buffer(i) = x;
+    }
   }
-  if (hasCache())
-    cacheColumn() = target;
+  cacheOutput(target);
 }
 
 } // namespace AST
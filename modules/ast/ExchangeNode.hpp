@@ -52,15 +52,21 @@ class ExchangeViewNode
 	final
 	: public StrategyBufferOpNode
 {
+	friend class ASTCodegen;
 private:
 	Option<SharedPtr<ExchangeViewNode>> m_left_view = std::nullopt;
 	SharedPtr<StrategyBufferOpNode> m_asset_op_node;
 	Vector<SharedPtr<ExchangeViewFilter>> m_filters;
 	LinAlg::EigenVectorXd m_buffer;
+	LinAlg::EigenVectorXd m_left_buffer;
+	Option<Vector<size_t>> m_assets = std::nullopt;
+	LinAlg::EigenVectorXd m_asset_mask;
 	size_t m_view_size;
 	size_t m_warmup;
 	bool m_as_signal = false;
 
+	[[nodiscard]] double filterValue(double x) const noexcept;
+
 public:
 	ATLAS_API ~ExchangeViewNode() noexcept;
 
@@ -116,10 +122,20 @@ public:
 	[[nodiscard]] auto& getExchange() { return m_exchange; }
 	[[nodiscard]] bool isSignal() const noexcept { return m_as_signal; }
 	void reset() noexcept override;
+	void optimize(ASTOptimizer& optimizer) noexcept override;
+	bool inputsDirty() noexcept override;
+	Option<Vector<size_t>> inputAssets(Option<Vector<size_t>> const& lanes) const noexcept override;
 	void evaluate(LinAlg::EigenRef<LinAlg::EigenVectorXd>) noexcept override;
+	Option<LinAlg::EigenRef<const LinAlg::EigenVectorXd>> view() noexcept override;
 	void filter(LinAlg::EigenRef<LinAlg::EigenVectorXd> v) const noexcept;
 	ATLAS_API void asSignal(bool v = true) noexcept;
 
+	//============================================================================
+	// restrict the view to the given assets, every other asset is NaN. The
+	// nodes feeding the view then only compute the lanes of these assets.
+	ATLAS_API [[nodiscard]] Result<bool, AtlasException> setAssets(Vector<String> const& assets) noexcept;
+	ATLAS_API void pySetAssets(Vector<String> const& assets);
+
 };
 
 
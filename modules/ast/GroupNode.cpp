@@ -0,0 +1,282 @@
+#include "AtlasMacros.hpp"
+
+#include "exchange/Exchange.hpp"
+#include "ast/GroupNode.hpp"
+#include "ast/ASTOptimizer.hpp"
+
+namespace Atlas {
+
+namespace AST {
+
+//============================================================================
+GroupNormalizeNode::GroupNormalizeNode(SharedPtr<StrategyBufferOpNode> parent,
+                                       Vector<Int64> groups, GroupOpType op,
+                                       double param) noexcept
+    : StrategyBufferOpNode(NodeType::GROUP, parent->getExchange(),
+                           parent.get()),
+      m_parent(std::move(parent)), m_op(op), m_param(param),
+      m_groups(std::move(groups)) {
+  addInput(m_parent);
+  buildGroups();
+}
+
+//============================================================================
+GroupNormalizeNode::GroupNormalizeNode(
+    SharedPtr<StrategyBufferOpNode> parent,
+    SharedPtr<StrategyBufferOpNode> group_node, GroupOpType op,
+    double param) noexcept
+    : StrategyBufferOpNode(NodeType::GROUP, parent->getExchange(),
+                           {parent, group_node}),
+      m_parent(std::move(parent)), m_group_node(std::move(group_node)),
+      m_op(op), m_param(param) {
+  addInput(m_parent);
+  addInput(*m_group_node);
+  size_t asset_count = getAssetCount();
+  m_groups.assign(asset_count, -1);
+  m_group_buffer.resize(asset_count);
+  m_group_buffer.setZero();
+  buildGroups();
+}
+
+//============================================================================
+GroupNormalizeNode::~GroupNormalizeNode() noexcept {}
+
+//============================================================================
+Result<SharedPtr<GroupNormalizeNode>, AtlasException>
+GroupNormalizeNode::make(SharedPtr<StrategyBufferOpNode> parent,
+                         Vector<Int64> groups, GroupOpType op,
+                         double param) noexcept {
+  if (groups.size() != parent->getAssetCount()) {
+    return Err("Expected one group id per asset, got " +
+               std::to_string(groups.size()));
+  }
+  return std::make_shared<GroupNormalizeNode>(std::move(parent),
+                                              std::move(groups), op, param);
+}
+
+//============================================================================
+SharedPtr<GroupNormalizeNode>
+GroupNormalizeNode::make(SharedPtr<StrategyBufferOpNode> parent,
+                         SharedPtr<StrategyBufferOpNode> group_node,
+                         GroupOpType op, double param) noexcept {
+  return std::make_shared<GroupNormalizeNode>(
+      std::move(parent), std::move(group_node), op, param);
+}
+
+//============================================================================
+SharedPtr<GroupNormalizeNode>
+GroupNormalizeNode::pyMake(SharedPtr<StrategyBufferOpNode> parent,
+                           Vector<Int64> groups, GroupOpType op,
+                           double param) {
+  auto result = make(std::move(parent), std::move(groups), op, param);
+  if (!result) {
+    throw std::runtime_error(result.error().what());
+  }
+  return *result;
+}
+
+//============================================================================
+void GroupNormalizeNode::buildGroups() noexcept {
+  // the ids are mapped to dense indices so sparse or large ids cost nothing,
+  // then a counting sort of the assets by index, the offsets are the running
+  // count of the members of every group before it
+  m_group_ids.clear();
+  for (auto group : m_groups) {
+    if (group >= 0) {
+      m_group_ids.push_back(group);
+    }
+  }
+  std::sort(m_group_ids.begin(), m_group_ids.end());
+  m_group_ids.erase(std::unique(m_group_ids.begin(), m_group_ids.end()),
+                    m_group_ids.end());
+  size_t group_count = m_group_ids.size();
+  m_offsets.assign(group_count + 1, 0);
+  m_group_index.resize(m_groups.size());
+  for (size_t i = 0; i < m_groups.size(); ++i) {
+    if (m_groups[i] < 0) {
+      continue;
+    }
+    auto it = std::lower_bound(m_group_ids.begin(), m_group_ids.end(),
+                               m_groups[i]);
+    m_group_index[i] = static_cast<size_t>(it - m_group_ids.begin());
+    ++m_offsets[m_group_index[i] + 1];
+  }
+  for (size_t g = 0; g < group_count; ++g) {
+    m_offsets[g + 1] += m_offsets[g];
+  }
+  m_members.resize(m_offsets.back());
+  m_rank_counts.assign(m_offsets.begin(), m_offsets.end() - 1);
+  for (size_t i = 0; i < m_groups.size(); ++i) {
+    if (m_groups[i] >= 0) {
+      m_members[m_rank_counts[m_group_index[i]]++] = i;
+    }
+  }
+}
+
+//============================================================================
+bool GroupNormalizeNode::readGroups() noexcept {
+  auto groups = (*m_group_node)->read(m_group_buffer);
+  bool changed = false;
+  for (size_t i = 0; i < m_groups.size(); ++i) {
+    // non finite, negative or out of range ids have no group
+    double id = groups(i);
+    Int64 group = id >= 0.0 && id < static_cast<double>(
+                                      std::numeric_limits<Int64>::max())
+                      ? static_cast<Int64>(id)
+                      : -1;
+    changed |= group != m_groups[i];
+    m_groups[i] = group;
+  }
+  return changed;
+}
+
+//============================================================================
+void GroupNormalizeNode::normalizeGroup(
+    LinAlg::EigenRef<LinAlg::EigenVectorXd> target, size_t group) noexcept {
+  size_t begin = m_offsets[group];
+  size_t end = m_offsets[group + 1];
+  double sum = 0.0;
+  size_t count = 0;
+  for (size_t k = begin; k < end; ++k) {
+    double x = target[m_members[k]];
+    if (!std::isnan(x)) {
+      sum += x;
+      ++count;
+    }
+  }
+  if (count == 0) {
+    return;
+  }
+  double mean = sum / static_cast<double>(count);
+  if (m_op == GroupOpType::DEMEAN) {
+    for (size_t k = begin; k < end; ++k) {
+      target[m_members[k]] -= mean;
+    }
+    return;
+  }
+
+  // population std from a second pass over the group, NaN members are
+  // skipped by the comparison
+  double squares = 0.0;
+  for (size_t k = begin; k < end; ++k) {
+    double x = target[m_members[k]] - mean;
+    squares += x == x ? x * x : 0.0;
+  }
+  double std = std::sqrt(squares / static_cast<double>(count));
+  for (size_t k = begin; k < end; ++k) {
+    double &x = target[m_members[k]];
+    if (m_op == GroupOpType::ZSCORE) {
+      x = std > 0.0 ? (x - mean) / std
+                    : std::numeric_limits<double>::quiet_NaN();
+    } else if (!std::isnan(x)) {
+      x = std::clamp(x, mean - m_param * std, mean + m_param * std);
+    }
+  }
+}
+
+//============================================================================
+void GroupNormalizeNode::rank(
+    LinAlg::EigenRef<LinAlg::EigenVectorXd> target) noexcept {
+  // one radix sort over every asset, walking it in order hands out the
+  // ordinal rank within each group
+  size_t valid = m_selector.partition(target);
+  m_selector.sort(target);
+  auto const &index = m_selector.index();
+  std::fill(m_rank_counts.begin(), m_rank_counts.end(), 0);
+  for (size_t i = 0; i < valid; ++i) {
+    size_t asset = index[i];
+    if (m_groups[asset] >= 0) {
+      target[asset] =
+          static_cast<double>(m_rank_counts[m_group_index[asset]]++);
+    }
+  }
+  for (size_t i = 0; i < valid; ++i) {
+    size_t asset = index[i];
+    if (m_groups[asset] >= 0) {
+      size_t count = m_rank_counts[m_group_index[asset]];
+      target[asset] =
+          count > 1 ? target[asset] / static_cast<double>(count - 1) : 0.5;
+    }
+  }
+}
+
+//============================================================================
+void GroupNormalizeNode::evaluate(
+    LinAlg::EigenRef<LinAlg::EigenVectorXd> target) noexcept {
+  auto values = m_parent->read(target);
+  if (values.data() != target.data()) {
+    target = values;
+  }
+  if (m_group_node && readGroups()) {
+    buildGroups();
+  }
+
+  if (m_op == GroupOpType::RANK) {
+    rank(target);
+  } else {
+    for (size_t g = 0; g + 1 < m_offsets.size(); ++g) {
+      normalizeGroup(target, g);
+    }
+  }
+  for (size_t i = 0; i < m_groups.size(); ++i) {
+    if (m_groups[i] < 0) {
+      target[i] = std::numeric_limits<double>::quiet_NaN();
+    }
+  }
+}
+
+//============================================================================
+size_t GroupNormalizeNode::getWarmup() const noexcept {
+  size_t warmup = m_parent->getWarmup();
+  if (m_group_node) {
+    warmup = std::max(warmup, (*m_group_node)->getWarmup());
+  }
+  return warmup;
+}
+
+//============================================================================
+bool GroupNormalizeNode::isSame(
+    StrategyBufferOpNode const *other) const noexcept {
+  if (other->getType() != NodeType::GROUP) {
+    return false;
+  }
+  auto ptr = static_cast<GroupNormalizeNode const *>(other);
+  if (m_op != ptr->m_op || m_param != ptr->m_param ||
+      !m_parent->isSame(ptr->m_parent.get())) {
+    return false;
+  }
+  if (m_group_node || ptr->m_group_node) {
+    return m_group_node && ptr->m_group_node &&
+           (*m_group_node)->isSame(ptr->m_group_node->get());
+  }
+  return m_groups == ptr->m_groups;
+}
+
+//============================================================================
+void GroupNormalizeNode::reset() noexcept {
+  m_parent->reset();
+  if (m_group_node) {
+    (*m_group_node)->reset();
+    std::fill(m_groups.begin(), m_groups.end(), -1);
+    buildGroups();
+  }
+}
+
+//============================================================================
+void GroupNormalizeNode::optimize(ASTOptimizer &optimizer) noexcept {
+  // every asset's output depends on the whole group so the inputs are
+  // pinned to all lanes
+  optimizer.visit(*m_parent);
+  if (m_group_node) {
+    optimizer.visit(**m_group_node);
+  }
+}
+
+//============================================================================
+bool GroupNormalizeNode::inputsDirty() noexcept {
+  return m_parent->isDirty() || (m_group_node && (*m_group_node)->isDirty());
+}
+
+} // namespace AST
+
+} // namespace Atlas
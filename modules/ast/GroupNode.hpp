@@ -0,0 +1,113 @@
+#pragma once
+#ifdef ATLAS_EXPORTS
+#define ATLAS_API __declspec(dllexport)
+#else
+#define ATLAS_API __declspec(dllimport)
+#endif
+#include "standard/AtlasCore.hpp"
+#include "ast/BaseNode.hpp"
+#include "ast/StrategyBufferNode.hpp"
+#include "ast/RankNode.hpp"
+#include "standard/AtlasLinAlg.hpp"
+
+namespace Atlas {
+
+namespace AST {
+
+//============================================================================
+enum class GroupOpType : Uint8 {
+  DEMEAN = 0,    /// subtract the group mean
+  ZSCORE = 1,    /// subtract the group mean and divide by the group std
+  RANK = 2,      /// percentile rank within the group, 0 to 1
+  WINSORIZE = 3, /// clip to the group mean +/- param group stds
+};
+
+//============================================================================
+/// <summary>
+/// Group neutral cross sectional normalization of a signal. Each asset
+/// belongs to a group given either once up front (a sector map) or by a node
+/// whose value is the asset's group id at every step (a time varying
+/// industry classification). Group ids are mapped to dense indices and the
+/// assets laid out by group with a counting sort, rebuilt only when the ids
+/// change, so every operation is a pass over contiguous groups in O(assets)
+/// whatever the ids are. Assets with a NaN signal or a negative / non finite
+/// group id are left NaN and do not enter their group's statistics.
+/// </summary>
+class GroupNormalizeNode final : public StrategyBufferOpNode {
+private:
+  SharedPtr<StrategyBufferOpNode> m_parent;
+  Option<SharedPtr<StrategyBufferOpNode>> m_group_node;
+  GroupOpType m_op;
+  double m_param;
+
+  /// <summary>
+  /// Group id of every asset, -1 for assets without a group
+  /// </summary>
+  Vector<Int64> m_groups;
+
+  /// <summary>
+  /// Sorted distinct group ids and the dense index of every asset's group
+  /// in them, valid for assets with a group
+  /// </summary>
+  Vector<Int64> m_group_ids;
+  Vector<size_t> m_group_index;
+
+  /// <summary>
+  /// Assets ordered by dense group index, group g owns m_members[m_offsets[g],
+  /// m_offsets[g + 1])
+  /// </summary>
+  Vector<size_t> m_members;
+  Vector<size_t> m_offsets;
+  Vector<size_t> m_rank_counts;
+  LinAlg::EigenVectorXd m_group_buffer;
+  CrossSectionSelector m_selector;
+
+  void buildGroups() noexcept;
+  [[nodiscard]] bool readGroups() noexcept;
+  void normalizeGroup(LinAlg::EigenRef<LinAlg::EigenVectorXd> target,
+                      size_t group) noexcept;
+  void rank(LinAlg::EigenRef<LinAlg::EigenVectorXd> target) noexcept;
+
+public:
+  ATLAS_API GroupNormalizeNode(SharedPtr<StrategyBufferOpNode> parent,
+                               Vector<Int64> groups, GroupOpType op,
+                               double param) noexcept;
+  ATLAS_API GroupNormalizeNode(SharedPtr<StrategyBufferOpNode> parent,
+                               SharedPtr<StrategyBufferOpNode> group_node,
+                               GroupOpType op, double param) noexcept;
+  ATLAS_API ~GroupNormalizeNode() noexcept;
+
+  /// <summary>
+  /// Normalize within a static grouping, one group id per asset in exchange
+  /// order. The param is the number of group stds to winsorize at.
+  /// </summary>
+  ATLAS_API [[nodiscard]] static Result<SharedPtr<GroupNormalizeNode>,
+                                        AtlasException>
+  make(SharedPtr<StrategyBufferOpNode> parent, Vector<Int64> groups,
+       GroupOpType op, double param = 3.0) noexcept;
+
+  /// <summary>
+  /// Normalize within the grouping given by the group node's value each step
+  /// </summary>
+  ATLAS_API [[nodiscard]] static SharedPtr<GroupNormalizeNode>
+  make(SharedPtr<StrategyBufferOpNode> parent,
+       SharedPtr<StrategyBufferOpNode> group_node, GroupOpType op,
+       double param = 3.0) noexcept;
+
+  ATLAS_API [[nodiscard]] static SharedPtr<GroupNormalizeNode>
+  pyMake(SharedPtr<StrategyBufferOpNode> parent, Vector<Int64> groups,
+         GroupOpType op, double param = 3.0);
+
+  [[nodiscard]] size_t getWarmup() const noexcept override;
+  [[nodiscard]] bool
+  isSame(StrategyBufferOpNode const *other) const noexcept override;
+  void reset() noexcept override;
+  void optimize(ASTOptimizer &optimizer) noexcept override;
+  bool inputsDirty() noexcept override;
+  void
+  evaluate(LinAlg::EigenRef<LinAlg::EigenVectorXd> target) noexcept override;
+};
+
+} // namespace AST
+
+} // namespace Atlas
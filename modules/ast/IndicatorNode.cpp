@@ -0,0 +1,395 @@
+
+#include "exchange/Exchange.hpp"
+#include "ast/IndicatorNode.hpp"
+
+namespace Atlas {
+
+namespace AST {
+
+//============================================================================
+TrueRangeObserverNode::TrueRangeObserverNode(
+    Option<String> id, SharedPtr<StrategyBufferOpNode> high,
+    SharedPtr<StrategyBufferOpNode> low,
+    SharedPtr<StrategyBufferOpNode> close) noexcept
+    : AssetObserverNode(id, close, AssetObserverType::TRUE_RANGE, 1),
+      m_high(high), m_low(low) {
+  addInput(m_high);
+  addInput(m_low);
+  size_t asset_count = m_exchange.getAssetCount();
+  m_high_buffer.resize(asset_count);
+  m_high_buffer.setZero();
+  m_low_buffer.resize(asset_count);
+  m_low_buffer.setZero();
+  m_prev_close.resize(asset_count);
+  reset();
+  size_t parent_warmup = std::max(
+      {high->getWarmup(), low->getWarmup(), close->getWarmup()});
+  setObserverWarmup(parent_warmup);
+  setWarmup(parent_warmup);
+}
+
+//============================================================================
+TrueRangeObserverNode::~TrueRangeObserverNode() noexcept {}
+
+//============================================================================
+void TrueRangeObserverNode::cacheObserver() noexcept {
+  auto close = buffer();
+  auto high = m_high->read(m_high_buffer);
+  auto low = m_low->read(m_low_buffer);
+  for (size_t i = 0; i < static_cast<size_t>(m_signal.rows()); i++) {
+    double prev_close = m_prev_close(i);
+    if (std::isnan(prev_close)) {
+      m_signal(i) = high(i) - low(i);
+    } else {
+      m_signal(i) =
+          std::max(high(i), prev_close) - std::min(low(i), prev_close);
+    }
+    if (!std::isnan(close(i))) {
+      m_prev_close(i) = close(i);
+    }
+  }
+}
+
+//============================================================================
+void TrueRangeObserverNode::reset() noexcept {
+  m_prev_close.setConstant(std::numeric_limits<double>::quiet_NaN());
+  m_signal.setConstant(std::numeric_limits<double>::quiet_NaN());
+}
+
+//============================================================================
+RsiObserverNode::RsiObserverNode(Option<String> id,
+                                 SharedPtr<StrategyBufferOpNode> parent,
+                                 size_t period) noexcept
+    : AssetObserverNode(id, parent, AssetObserverType::RSI, 1),
+      m_alpha(EWMAObserverNodeBase::toAlpha(static_cast<double>(period),
+                                            EWMAParamType::WILDER)) {
+  size_t asset_count = m_exchange.getAssetCount();
+  for (auto *v : {&m_prev, &m_up, &m_down, &m_gain, &m_loss}) {
+    v->resize(asset_count);
+  }
+  reset();
+  setObserverWarmup(parent->getWarmup());
+  setWarmup(parent->getWarmup());
+}
+
+//============================================================================
+RsiObserverNode::~RsiObserverNode() noexcept {}
+
+//============================================================================
+void RsiObserverNode::cacheObserver() noexcept {
+  auto observation = buffer();
+  for (size_t i = 0; i < static_cast<size_t>(m_signal.rows()); i++) {
+    double x = observation(i);
+    // no change on an asset's first observation or a missing one, the
+    // averages hold
+    double change = x - m_prev(i);
+    m_up(i) = std::isnan(change) ? change : std::max(change, 0.0);
+    m_down(i) = std::isnan(change) ? change : std::max(-change, 0.0);
+    if (!std::isnan(x)) {
+      m_prev(i) = x;
+    }
+  }
+  EWMAObserverNodeBase::smooth(m_gain, m_up, m_alpha);
+  EWMAObserverNodeBase::smooth(m_loss, m_down, m_alpha);
+  m_signal = 100.0 * m_gain.array() / (m_gain.array() + m_loss.array());
+}
+
+//============================================================================
+void RsiObserverNode::reset() noexcept {
+  m_prev.setConstant(std::numeric_limits<double>::quiet_NaN());
+  m_up.setConstant(std::numeric_limits<double>::quiet_NaN());
+  m_down.setConstant(std::numeric_limits<double>::quiet_NaN());
+  m_gain.setConstant(std::numeric_limits<double>::quiet_NaN());
+  m_loss.setConstant(std::numeric_limits<double>::quiet_NaN());
+  m_signal.setConstant(std::numeric_limits<double>::quiet_NaN());
+}
+
+//============================================================================
+MacdObserverNode::MacdObserverNode(Option<String> id,
+                                   SharedPtr<StrategyBufferOpNode> parent,
+                                   size_t fast, size_t slow, size_t signal,
+                                   MACDOutputType output) noexcept
+    : AssetObserverNode(id, parent, AssetObserverType::MACD, 1),
+      m_output(output),
+      m_signal_alpha(EWMAObserverNodeBase::toAlpha(static_cast<double>(signal),
+                                                   EWMAParamType::SPAN)) {
+  Option<String> fast_id = std::nullopt;
+  if (id.has_value()) {
+    fast_id = id.value() + "_fast";
+  }
+  auto fast_mean = std::make_shared<EWMAMeanObserverNode>(
+      fast_id, parent, static_cast<double>(fast));
+  m_fast_observer = std::static_pointer_cast<EWMAMeanObserverNode>(
+      m_exchange.registerObserver(std::move(fast_mean)));
+  addInput(m_fast_observer);
+
+  Option<String> slow_id = std::nullopt;
+  if (id.has_value()) {
+    slow_id = id.value() + "_slow";
+  }
+  auto slow_mean = std::make_shared<EWMAMeanObserverNode>(
+      slow_id, parent, static_cast<double>(slow));
+  m_slow_observer = std::static_pointer_cast<EWMAMeanObserverNode>(
+      m_exchange.registerObserver(std::move(slow_mean)));
+  addInput(m_slow_observer);
+
+  size_t asset_count = m_exchange.getAssetCount();
+  m_line.resize(asset_count);
+  m_signal_line.resize(asset_count);
+  reset();
+  setObserverWarmup(parent->getWarmup());
+  setWarmup(parent->getWarmup());
+}
+
+//============================================================================
+MacdObserverNode::~MacdObserverNode() noexcept {}
+
+//============================================================================
+Vector<double> MacdObserverNode::getObserverParams() const noexcept {
+  return {m_fast_observer->getAlpha(), m_slow_observer->getAlpha(),
+          m_signal_alpha, static_cast<double>(m_output)};
+}
+
+//============================================================================
+void MacdObserverNode::cacheObserver() noexcept {
+  m_line = m_fast_observer->getSignalCopy() - m_slow_observer->getSignalCopy();
+  EWMAObserverNodeBase::smooth(m_signal_line, m_line, m_signal_alpha);
+  switch (m_output) {
+  case MACDOutputType::LINE:
+    m_signal = m_line;
+    break;
+  case MACDOutputType::SIGNAL:
+    m_signal = m_signal_line;
+    break;
+  case MACDOutputType::HISTOGRAM:
+    m_signal = m_line - m_signal_line;
+    break;
+  }
+}
+
+//============================================================================
+void MacdObserverNode::reset() noexcept {
+  m_line.setConstant(std::numeric_limits<double>::quiet_NaN());
+  m_signal_line.setConstant(std::numeric_limits<double>::quiet_NaN());
+  m_signal.setConstant(std::numeric_limits<double>::quiet_NaN());
+}
+
+//============================================================================
+BollingerObserverNode::BollingerObserverNode(
+    Option<String> id, SharedPtr<StrategyBufferOpNode> parent, size_t window,
+    double num_std, BollingerOutputType output) noexcept
+    : AssetObserverNode(id, parent, AssetObserverType::BOLLINGER, window),
+      m_num_std(num_std), m_output(output) {
+  Option<String> mean_id = std::nullopt;
+  if (id.has_value()) {
+    mean_id = id.value() + "_mean";
+  }
+  auto mean = std::make_shared<MeanObserverNode>(mean_id, parent, window);
+  m_mean_observer = std::static_pointer_cast<MeanObserverNode>(
+      m_exchange.registerObserver(std::move(mean)));
+  addInput(m_mean_observer);
+
+  Option<String> variance_id = std::nullopt;
+  if (id.has_value()) {
+    variance_id = id.value() + "_variance";
+  }
+  auto variance =
+      std::make_shared<VarianceObserverNode>(variance_id, parent, window);
+  m_variance_observer = std::static_pointer_cast<VarianceObserverNode>(
+      m_exchange.registerObserver(std::move(variance)));
+  addInput(m_variance_observer);
+  setObserverWarmup(parent->getWarmup());
+  setWarmup(parent->getWarmup() + window);
+}
+
+//============================================================================
+BollingerObserverNode::~BollingerObserverNode() noexcept {}
+
+//============================================================================
+void BollingerObserverNode::cacheObserver() noexcept {
+  auto observation = buffer();
+  auto const &mean = m_mean_observer->getSignalCopy();
+  auto const &variance = m_variance_observer->getSignalCopy();
+  for (size_t i = 0; i < static_cast<size_t>(m_signal.rows()); i++) {
+    // the running sums can leave a flat window slightly negative
+    double width = m_num_std * std::sqrt(std::max(variance(i), 0.0));
+    double lower = mean(i) - width;
+    switch (m_output) {
+    case BollingerOutputType::UPPER:
+      m_signal(i) = mean(i) + width;
+      break;
+    case BollingerOutputType::LOWER:
+      m_signal(i) = lower;
+      break;
+    case BollingerOutputType::PERCENT_B:
+      m_signal(i) = width > 0.0 ? (observation(i) - lower) / (2.0 * width)
+                                : std::numeric_limits<double>::quiet_NaN();
+      break;
+    }
+  }
+}
+
+//============================================================================
+void BollingerObserverNode::reset() noexcept {
+  m_signal.setConstant(std::numeric_limits<double>::quiet_NaN());
+}
+
+//============================================================================
+StochasticObserverNode::StochasticObserverNode(
+    Option<String> id, SharedPtr<StrategyBufferOpNode> high,
+    SharedPtr<StrategyBufferOpNode> low, SharedPtr<StrategyBufferOpNode> close,
+    size_t window) noexcept
+    : AssetObserverNode(id, close, AssetObserverType::STOCHASTIC, window),
+      m_high(high), m_low(low) {
+  addInput(m_high);
+  addInput(m_low);
+  Option<String> max_id = std::nullopt;
+  if (id.has_value()) {
+    max_id = id.value() + "_max";
+  }
+  auto max = std::make_shared<MaxObserverNode>(max_id, high, window);
+  m_max_observer = std::static_pointer_cast<MaxObserverNode>(
+      m_exchange.registerObserver(std::move(max)));
+  addInput(m_max_observer);
+
+  Option<String> min_id = std::nullopt;
+  if (id.has_value()) {
+    min_id = id.value() + "_min";
+  }
+  auto min = std::make_shared<MinObserverNode>(min_id, low, window);
+  m_min_observer = std::static_pointer_cast<MinObserverNode>(
+      m_exchange.registerObserver(std::move(min)));
+  addInput(m_min_observer);
+
+  size_t parent_warmup = std::max(
+      {high->getWarmup(), low->getWarmup(), close->getWarmup()});
+  setObserverWarmup(parent_warmup);
+  setWarmup(parent_warmup + window);
+  reset();
+}
+
+//============================================================================
+StochasticObserverNode::~StochasticObserverNode() noexcept {}
+
+//============================================================================
+void StochasticObserverNode::cacheObserver() noexcept {
+  auto close = buffer();
+  auto const &highest = m_max_observer->getSignalCopy();
+  auto const &lowest = m_min_observer->getSignalCopy();
+  for (size_t i = 0; i < static_cast<size_t>(m_signal.rows()); i++) {
+    double range = highest(i) - lowest(i);
+    m_signal(i) = range > 0.0 ? 100.0 * (close(i) - lowest(i)) / range
+                              : std::numeric_limits<double>::quiet_NaN();
+  }
+}
+
+//============================================================================
+void StochasticObserverNode::reset() noexcept {
+  m_signal.setConstant(std::numeric_limits<double>::quiet_NaN());
+}
+
+//============================================================================
+AdxObserverNode::AdxObserverNode(Option<String> id,
+                                 SharedPtr<StrategyBufferOpNode> high,
+                                 SharedPtr<StrategyBufferOpNode> low,
+                                 SharedPtr<StrategyBufferOpNode> close,
+                                 size_t period, ADXOutputType output) noexcept
+    : AssetObserverNode(id, close, AssetObserverType::ADX, 1), m_high(high),
+      m_low(low), m_output(output),
+      m_alpha(EWMAObserverNodeBase::toAlpha(static_cast<double>(period),
+                                            EWMAParamType::WILDER)) {
+  addInput(m_high);
+  addInput(m_low);
+  Option<String> true_range_id = std::nullopt;
+  Option<String> atr_id = std::nullopt;
+  if (id.has_value()) {
+    true_range_id = id.value() + "_true_range";
+    atr_id = id.value() + "_atr";
+  }
+  auto true_range =
+      std::make_shared<TrueRangeObserverNode>(true_range_id, high, low, close);
+  auto true_range_observer =
+      m_exchange.registerObserver(std::move(true_range));
+  auto atr = std::make_shared<EWMAMeanObserverNode>(
+      atr_id, std::move(true_range_observer), static_cast<double>(period),
+      EWMAParamType::WILDER);
+  m_atr_observer = std::static_pointer_cast<EWMAMeanObserverNode>(
+      m_exchange.registerObserver(std::move(atr)));
+  addInput(m_atr_observer);
+
+  size_t asset_count = m_exchange.getAssetCount();
+  m_high_buffer.resize(asset_count);
+  m_high_buffer.setZero();
+  m_low_buffer.resize(asset_count);
+  m_low_buffer.setZero();
+  for (auto *v : {&m_prev_high, &m_prev_low, &m_plus_dm, &m_minus_dm,
+                  &m_plus_dm_average, &m_minus_dm_average, &m_plus_di,
+                  &m_minus_di, &m_dx, &m_adx}) {
+    v->resize(asset_count);
+  }
+  reset();
+  size_t parent_warmup = std::max(
+      {high->getWarmup(), low->getWarmup(), close->getWarmup()});
+  setObserverWarmup(parent_warmup);
+  setWarmup(parent_warmup);
+}
+
+//============================================================================
+AdxObserverNode::~AdxObserverNode() noexcept {}
+
+//============================================================================
+void AdxObserverNode::cacheObserver() noexcept {
+  auto high = m_high->read(m_high_buffer);
+  auto low = m_low->read(m_low_buffer);
+  for (size_t i = 0; i < static_cast<size_t>(m_signal.rows()); i++) {
+    // NaN movements on an asset's first bar or a missing one leave the
+    // averages unchanged
+    double up = high(i) - m_prev_high(i);
+    double down = m_prev_low(i) - low(i);
+    if (std::isnan(up) || std::isnan(down)) {
+      m_plus_dm(i) = std::numeric_limits<double>::quiet_NaN();
+      m_minus_dm(i) = std::numeric_limits<double>::quiet_NaN();
+    } else {
+      m_plus_dm(i) = up > down && up > 0.0 ? up : 0.0;
+      m_minus_dm(i) = down > up && down > 0.0 ? down : 0.0;
+    }
+    if (!std::isnan(high(i)) && !std::isnan(low(i))) {
+      m_prev_high(i) = high(i);
+      m_prev_low(i) = low(i);
+    }
+  }
+  EWMAObserverNodeBase::smooth(m_plus_dm_average, m_plus_dm, m_alpha);
+  EWMAObserverNodeBase::smooth(m_minus_dm_average, m_minus_dm, m_alpha);
+
+  auto const &atr = m_atr_observer->getSignalCopy();
+  m_plus_di = 100.0 * m_plus_dm_average.array() / atr.array();
+  m_minus_di = 100.0 * m_minus_dm_average.array() / atr.array();
+  m_dx = 100.0 * (m_plus_di - m_minus_di).array().abs() /
+         (m_plus_di + m_minus_di).array();
+  EWMAObserverNodeBase::smooth(m_adx, m_dx, m_alpha);
+  switch (m_output) {
+  case ADXOutputType::ADX:
+    m_signal = m_adx;
+    break;
+  case ADXOutputType::PLUS_DI:
+    m_signal = m_plus_di;
+    break;
+  case ADXOutputType::MINUS_DI:
+    m_signal = m_minus_di;
+    break;
+  }
+}
+
+//============================================================================
+void AdxObserverNode::reset() noexcept {
+  for (auto *v : {&m_prev_high, &m_prev_low, &m_plus_dm, &m_minus_dm,
+                  &m_plus_dm_average, &m_minus_dm_average, &m_plus_di,
+                  &m_minus_di, &m_dx, &m_adx}) {
+    v->setConstant(std::numeric_limits<double>::quiet_NaN());
+  }
+  m_signal.setConstant(std::numeric_limits<double>::quiet_NaN());
+}
+
+} // namespace AST
+
+} // namespace Atlas
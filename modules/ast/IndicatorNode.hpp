@@ -0,0 +1,223 @@
+#pragma once
+#define NOMINMAX
+#ifdef ATLAS_EXPORTS
+#define ATLAS_API __declspec(dllexport)
+#else
+#define ATLAS_API __declspec(dllimport)
+#endif
+#include "standard/AtlasCore.hpp"
+#include "standard/AtlasEnums.hpp"
+#include "ast/ObserverNodeBase.hpp"
+#include "ast/ObserverNode.hpp"
+#include "standard/AtlasLinAlg.hpp"
+
+namespace Atlas {
+
+namespace AST {
+
+//============================================================================
+/// <summary>
+/// True range of a bar, max(high, previous close) - min(low, previous close),
+/// or high - low on an asset's first bar. Observes the close and reads the
+/// high and low as other parents, keeping the previous close as its only
+/// state.
+/// </summary>
+class TrueRangeObserverNode final : public AssetObserverNode {
+private:
+  SharedPtr<StrategyBufferOpNode> m_high;
+  SharedPtr<StrategyBufferOpNode> m_low;
+  LinAlg::EigenVectorXd m_high_buffer;
+  LinAlg::EigenVectorXd m_low_buffer;
+  LinAlg::EigenVectorXd m_prev_close;
+
+public:
+  ATLAS_API TrueRangeObserverNode(Option<String> id,
+                                  SharedPtr<StrategyBufferOpNode> high,
+                                  SharedPtr<StrategyBufferOpNode> low,
+                                  SharedPtr<StrategyBufferOpNode> close) noexcept;
+  ATLAS_API ~TrueRangeObserverNode() noexcept;
+
+  [[nodiscard]] Vector<StrategyBufferOpNode const *>
+  getOtherParents() const noexcept override {
+    return {m_high.get(), m_low.get()};
+  }
+  void onOutOfRange(
+      LinAlg::EigenRef<LinAlg::EigenVectorXd> buffer_old) noexcept override {}
+  void cacheObserver() noexcept override;
+  void reset() noexcept override;
+};
+
+//============================================================================
+/// <summary>
+/// Relative strength index, 100 * gain / (gain + loss) with the gains and
+/// losses of the parent's changes smoothed by Wilder's average, alpha =
+/// 1 / period. The averages start from the first change rather than a
+/// simple mean of the first period changes.
+/// </summary>
+class RsiObserverNode final : public AssetObserverNode {
+private:
+  double m_alpha;
+  LinAlg::EigenVectorXd m_prev;
+  LinAlg::EigenVectorXd m_up;
+  LinAlg::EigenVectorXd m_down;
+  LinAlg::EigenVectorXd m_gain;
+  LinAlg::EigenVectorXd m_loss;
+
+public:
+  ATLAS_API RsiObserverNode(Option<String> id,
+                            SharedPtr<StrategyBufferOpNode> parent,
+                            size_t period) noexcept;
+  ATLAS_API ~RsiObserverNode() noexcept;
+
+  [[nodiscard]] Vector<double> getObserverParams() const noexcept override {
+    return {m_alpha};
+  }
+  void onOutOfRange(
+      LinAlg::EigenRef<LinAlg::EigenVectorXd> buffer_old) noexcept override {}
+  void cacheObserver() noexcept override;
+  void reset() noexcept override;
+};
+
+//============================================================================
+/// <summary>
+/// Moving average convergence divergence. The fast and slow averages are
+/// registered EWMA mean observers of the parent, so they are shared with any
+/// other observer of the same input and span. The signal line is the span
+/// smoothed MACD line and the histogram the line less the signal line.
+/// </summary>
+class MacdObserverNode final : public AssetObserverNode {
+private:
+  SharedPtr<EWMAMeanObserverNode> m_fast_observer;
+  SharedPtr<EWMAMeanObserverNode> m_slow_observer;
+  MACDOutputType m_output;
+  double m_signal_alpha;
+  LinAlg::EigenVectorXd m_line;
+  LinAlg::EigenVectorXd m_signal_line;
+
+public:
+  ATLAS_API MacdObserverNode(Option<String> id,
+                             SharedPtr<StrategyBufferOpNode> parent,
+                             size_t fast, size_t slow, size_t signal,
+                             MACDOutputType output = MACDOutputType::LINE) noexcept;
+  ATLAS_API ~MacdObserverNode() noexcept;
+
+  [[nodiscard]] Vector<double> getObserverParams() const noexcept override;
+  void onOutOfRange(
+      LinAlg::EigenRef<LinAlg::EigenVectorXd> buffer_old) noexcept override {}
+  void cacheObserver() noexcept override;
+  void reset() noexcept override;
+};
+
+//============================================================================
+/// <summary>
+/// Bollinger bands, the rolling mean plus or minus num_std rolling (population)
+/// standard deviations, or the position of the observation within the bands.
+/// Reads the registered mean and variance observers of the parent.
+/// </summary>
+class BollingerObserverNode final : public AssetObserverNode {
+private:
+  SharedPtr<MeanObserverNode> m_mean_observer;
+  SharedPtr<VarianceObserverNode> m_variance_observer;
+  double m_num_std;
+  BollingerOutputType m_output;
+
+public:
+  ATLAS_API BollingerObserverNode(
+      Option<String> id, SharedPtr<StrategyBufferOpNode> parent, size_t window,
+      double num_std = 2.0,
+      BollingerOutputType output = BollingerOutputType::PERCENT_B) noexcept;
+  ATLAS_API ~BollingerObserverNode() noexcept;
+
+  [[nodiscard]] Vector<double> getObserverParams() const noexcept override {
+    return {m_num_std, static_cast<double>(m_output)};
+  }
+  void onOutOfRange(
+      LinAlg::EigenRef<LinAlg::EigenVectorXd> buffer_old) noexcept override {}
+  void cacheObserver() noexcept override;
+  void reset() noexcept override;
+};
+
+//============================================================================
+/// <summary>
+/// Stochastic oscillator %K, 100 * (close - lowest low) / (highest high -
+/// lowest low) over the window, NaN when the range is empty. The extremes
+/// are the registered max observer of the high and min observer of the low.
+/// </summary>
+class StochasticObserverNode final : public AssetObserverNode {
+private:
+  SharedPtr<StrategyBufferOpNode> m_high;
+  SharedPtr<StrategyBufferOpNode> m_low;
+  SharedPtr<MaxObserverNode> m_max_observer;
+  SharedPtr<MinObserverNode> m_min_observer;
+
+public:
+  ATLAS_API StochasticObserverNode(Option<String> id,
+                                   SharedPtr<StrategyBufferOpNode> high,
+                                   SharedPtr<StrategyBufferOpNode> low,
+                                   SharedPtr<StrategyBufferOpNode> close,
+                                   size_t window) noexcept;
+  ATLAS_API ~StochasticObserverNode() noexcept;
+
+  [[nodiscard]] Vector<StrategyBufferOpNode const *>
+  getOtherParents() const noexcept override {
+    return {m_high.get(), m_low.get()};
+  }
+  void onOutOfRange(
+      LinAlg::EigenRef<LinAlg::EigenVectorXd> buffer_old) noexcept override {}
+  void cacheObserver() noexcept override;
+  void reset() noexcept override;
+};
+
+//============================================================================
+/// <summary>
+/// Average directional index or the directional indicators it is built from.
+/// The average true range is a registered Wilder EWMA of a registered true
+/// range observer, shared with any other indicator over the same bars and
+/// period. The directional movements and the directional index are smoothed
+/// in place with the same kernel.
+/// </summary>
+class AdxObserverNode final : public AssetObserverNode {
+private:
+  SharedPtr<StrategyBufferOpNode> m_high;
+  SharedPtr<StrategyBufferOpNode> m_low;
+  SharedPtr<EWMAMeanObserverNode> m_atr_observer;
+  ADXOutputType m_output;
+  double m_alpha;
+  LinAlg::EigenVectorXd m_high_buffer;
+  LinAlg::EigenVectorXd m_low_buffer;
+  LinAlg::EigenVectorXd m_prev_high;
+  LinAlg::EigenVectorXd m_prev_low;
+  LinAlg::EigenVectorXd m_plus_dm;
+  LinAlg::EigenVectorXd m_minus_dm;
+  LinAlg::EigenVectorXd m_plus_dm_average;
+  LinAlg::EigenVectorXd m_minus_dm_average;
+  LinAlg::EigenVectorXd m_plus_di;
+  LinAlg::EigenVectorXd m_minus_di;
+  LinAlg::EigenVectorXd m_dx;
+  LinAlg::EigenVectorXd m_adx;
+
+public:
+  ATLAS_API AdxObserverNode(Option<String> id,
+                            SharedPtr<StrategyBufferOpNode> high,
+                            SharedPtr<StrategyBufferOpNode> low,
+                            SharedPtr<StrategyBufferOpNode> close,
+                            size_t period,
+                            ADXOutputType output = ADXOutputType::ADX) noexcept;
+  ATLAS_API ~AdxObserverNode() noexcept;
+
+  [[nodiscard]] Vector<double> getObserverParams() const noexcept override {
+    return {m_alpha, static_cast<double>(m_output)};
+  }
+  [[nodiscard]] Vector<StrategyBufferOpNode const *>
+  getOtherParents() const noexcept override {
+    return {m_high.get(), m_low.get()};
+  }
+  void onOutOfRange(
+      LinAlg::EigenRef<LinAlg::EigenVectorXd> buffer_old) noexcept override {}
+  void cacheObserver() noexcept override;
+  void reset() noexcept override;
+};
+
+} // namespace AST
+
+} // namespace Atlas
@@ -25,6 +25,29 @@ void SumObserverNode::cacheObserver() noexcept { m_signal += buffer(); }
 //============================================================================
 void SumObserverNode::reset() noexcept { m_signal.setZero(); }
 
+//============================================================================
+void SumObserverNode::evaluateBatch(
+    LinAlg::EigenRef<LinAlg::EigenMatrixXd> target) noexcept {
+  LinAlg::EigenMatrixXd history(target.rows(), target.cols());
+  m_parent->evaluateHistory(history);
+
+  // same running sum as the step loop, observations start at the parent's
+  // warmup and fall out of the window after getWindow() steps
+  size_t start = m_parent->getWarmup();
+  size_t window = getWindow();
+  size_t cols = static_cast<size_t>(target.cols());
+  target.setZero();
+  for (size_t i = start; i < cols; ++i) {
+    if (i > start) {
+      target.col(i) = target.col(i - 1);
+    }
+    if (i >= start + window) {
+      target.col(i) -= history.col(i - window);
+    }
+    target.col(i) += history.col(i);
+  }
+}
+
 //============================================================================
 void SumObserverNode::onOutOfRange(
     LinAlg::EigenRef<LinAlg::EigenVectorXd> buffer_old) noexcept {
@@ -47,6 +70,13 @@ void MeanObserverNode::cacheObserver() noexcept {
 //============================================================================
 void MeanObserverNode::reset() noexcept { m_sum_observer->reset(); }
 
+//============================================================================
+void MeanObserverNode::evaluateBatch(
+    LinAlg::EigenRef<LinAlg::EigenMatrixXd> target) noexcept {
+  m_sum_observer->evaluateHistory(target);
+  target /= static_cast<double>(getWindow());
+}
+
 //============================================================================
 size_t MeanObserverNode::refreshWarmup() noexcept {
   setWarmup(m_sum_observer->refreshWarmup());
@@ -65,131 +95,165 @@ MeanObserverNode::MeanObserverNode(Option<String> id,
   auto sum = std::make_shared<SumObserverNode>(sum_id, parent, window);
   m_sum_observer = std::static_pointer_cast<SumObserverNode>(
       m_exchange.registerObserver(std::move(sum)));
+  addInput(m_sum_observer);
   setObserverWarmup(parent->getWarmup());
   setWarmup(parent->getWarmup() + window);
 }
 
 //============================================================================
-MaxObserverNode::MaxObserverNode(Option<String> id,
-                                 SharedPtr<StrategyBufferOpNode> parent,
-                                 size_t window) noexcept
-    : AssetObserverNode(id, parent, AssetObserverType::MAX, window) {
+ExtremumObserverNode::ExtremumObserverNode(
+    Option<String> id, SharedPtr<StrategyBufferOpNode> parent,
+    AssetObserverType observer_type, size_t window, bool is_max) noexcept
+    : AssetObserverNode(id, parent, observer_type, window), m_is_max(is_max) {
   setObserverWarmup(parent->getWarmup());
   setWarmup(parent->getWarmup() + window);
-  m_signal.resize(m_exchange.getAssetCount());
-  m_signal.setConstant(-std::numeric_limits<double>::max());
-  setObserverBuffer(-std::numeric_limits<double>::max());
+  size_t asset_count = m_exchange.getAssetCount();
+  m_steps.resize(asset_count * window, 0);
+  m_values.resize(asset_count * window, 0.0);
+  m_head.resize(asset_count, 0);
+  m_count.resize(asset_count, 0);
+  m_signal.setConstant(std::numeric_limits<double>::quiet_NaN());
 }
 
 //============================================================================
-MaxObserverNode::~MaxObserverNode() noexcept {}
+ExtremumObserverNode::~ExtremumObserverNode() noexcept {}
 
 //============================================================================
-void MaxObserverNode::onOutOfRange(
-    LinAlg::EigenRef<LinAlg::EigenVectorXd> buffer_old) noexcept {
-  assert(buffer_old.size() == m_signal.size());
-  size_t buffer_idx = getBufferIdx();
-  auto const &buffer_matrix = getBufferMatrix();
+void ExtremumObserverNode::cacheObserver() noexcept {
+  auto observation = buffer();
+  size_t window = getWindow();
   for (size_t i = 0; i < static_cast<size_t>(m_signal.rows()); i++) {
-    // Check if the column going out of range holds the max value for the row
-    if (buffer_old(i) != m_signal(i)) {
-      continue;
+    size_t *steps = m_steps.data() + i * window;
+    double *values = m_values.data() + i * window;
+    size_t &head = m_head[i];
+    size_t &count = m_count[i];
+
+    // at most one entry expires per step and it is always the front
+    if (count && steps[head] + window <= m_step) {
+      head = (head + 1) % window;
+      count--;
     }
 
-    // loop over the buffer row and find the new max, skipping the expiring
-    // index
-    size_t columns = static_cast<size_t>(buffer_matrix.cols());
-    double max = -std::numeric_limits<double>::max();
-    for (size_t j = 0; j < columns; j++) {
-      if (buffer_matrix(i, j) > max && j != buffer_idx) {
-        max = buffer_matrix(i, j);
+    double value = observation(i);
+    if (!std::isnan(value)) {
+      // entries beaten or matched by the new observation can never be the
+      // extreme again, ties resolve to the newest as in a full window scan
+      while (count) {
+        size_t back = (head + count - 1) % window;
+        bool dominated =
+            m_is_max ? values[back] <= value : values[back] >= value;
+        if (!dominated) {
+          break;
+        }
+        count--;
       }
+      size_t slot = (head + count) % window;
+      steps[slot] = m_step;
+      values[slot] = value;
+      count++;
     }
-    m_signal(i) = max;
+    m_signal(i) =
+        count ? values[head] : std::numeric_limits<double>::quiet_NaN();
   }
+  m_step++;
 }
 
 //============================================================================
-void MaxObserverNode::cacheObserver() noexcept {
-  m_signal = buffer().cwiseMax(m_signal);
+double ExtremumObserverNode::extremumPosition(size_t asset) const noexcept {
+  if (!m_count[asset]) {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+  size_t window = getWindow();
+  size_t age = m_step - 1 - m_steps[asset * window + m_head[asset]];
+  return static_cast<double>(window - age);
 }
 
 //============================================================================
-void MaxObserverNode::reset() noexcept {
-  m_signal.setConstant(-std::numeric_limits<double>::max());
-  setObserverBuffer(-std::numeric_limits<double>::max());
+void ExtremumObserverNode::reset() noexcept {
+  m_step = 0;
+  std::fill(m_head.begin(), m_head.end(), 0);
+  std::fill(m_count.begin(), m_count.end(), 0);
+  m_signal.setConstant(std::numeric_limits<double>::quiet_NaN());
 }
 
 //============================================================================
-void TsArgMaxObserverNode::reset() noexcept {
-  m_signal.setConstant(-std::numeric_limits<double>::max());
-  setObserverBuffer(-std::numeric_limits<double>::max());
+MaxObserverNode::MaxObserverNode(Option<String> id,
+                                 SharedPtr<StrategyBufferOpNode> parent,
+                                 size_t window) noexcept
+    : ExtremumObserverNode(id, parent, AssetObserverType::MAX, window, true) {}
+
+//============================================================================
+MaxObserverNode::~MaxObserverNode() noexcept {}
+
+//============================================================================
+MinObserverNode::MinObserverNode(Option<String> id,
+                                 SharedPtr<StrategyBufferOpNode> parent,
+                                 size_t window) noexcept
+    : ExtremumObserverNode(id, parent, AssetObserverType::MIN, window, false) {
 }
 
 //============================================================================
-TsArgMaxObserverNode::TsArgMaxObserverNode(
+MinObserverNode::~MinObserverNode() noexcept {}
+
+//============================================================================
+TsArgExtremumObserverNode::TsArgExtremumObserverNode(
     Option<String> id, SharedPtr<StrategyBufferOpNode> parent,
-    size_t window) noexcept
-    : AssetObserverNode(id, parent, AssetObserverType::TS_ARGMAX, window) {
-  Option<String> max_id = std::nullopt;
+    AssetObserverType observer_type, size_t window, bool is_max) noexcept
+    : AssetObserverNode(id, parent, observer_type, window) {
+  Option<String> extremum_id = std::nullopt;
   if (id.has_value()) {
-    max_id = id.value() + "_sum_";
+    extremum_id = id.value() + (is_max ? "_max" : "_min");
+  }
+  SharedPtr<ExtremumObserverNode> extremum;
+  if (is_max) {
+    extremum = std::make_shared<MaxObserverNode>(extremum_id, parent, window);
+  } else {
+    extremum = std::make_shared<MinObserverNode>(extremum_id, parent, window);
   }
-  auto max = std::make_shared<MaxObserverNode>(max_id, parent, window);
-  m_max_observer = std::static_pointer_cast<MaxObserverNode>(
-      m_exchange.registerObserver(std::move(max)));
+  m_extremum_observer = std::static_pointer_cast<ExtremumObserverNode>(
+      m_exchange.registerObserver(std::move(extremum)));
+  addInput(m_extremum_observer);
   setObserverWarmup(parent->getWarmup());
   setWarmup(parent->getWarmup() + window);
-
-  m_signal.resize(m_exchange.getAssetCount());
-  m_signal.setConstant(0);
-  setObserverBuffer(0);
+  m_signal.setConstant(std::numeric_limits<double>::quiet_NaN());
 }
 
 //============================================================================
-TsArgMaxObserverNode::~TsArgMaxObserverNode() noexcept {}
+TsArgExtremumObserverNode::~TsArgExtremumObserverNode() noexcept {}
 
 //============================================================================
-void TsArgMaxObserverNode::cacheObserver() noexcept {
-  auto const &buffer_matrix = m_max_observer->getBufferMatrix();
-  auto v = static_cast<double>(getWindow());
-  m_signal = (buffer_matrix.col(getBufferIdx()).array() ==
-              m_max_observer->getSignalCopy().array())
-                 .select(v, m_signal.array() - 1);
+void TsArgExtremumObserverNode::cacheObserver() noexcept {
+  // the extremum observer is registered first so it already holds this step
+  for (size_t i = 0; i < static_cast<size_t>(m_signal.rows()); i++) {
+    m_signal(i) = m_extremum_observer->extremumPosition(i);
+  }
 }
 
 //============================================================================
-void TsArgMaxObserverNode::onOutOfRange(
-    LinAlg::EigenRef<LinAlg::EigenVectorXd> buffer_old) noexcept {
-  size_t buffer_idx = getBufferIdx();
-  size_t window = getWindow();
-  auto const &buffer_matrix = m_max_observer->getBufferMatrix();
-  size_t columns = static_cast<size_t>(buffer_matrix.cols());
-  for (size_t i = 0; i < static_cast<size_t>(m_signal.rows()); i++) {
-    auto const &row = buffer_matrix.row(i);
-    // Column going out of range is the argmax if the value is equal to the
-    // window, otherwise it is not the argmax and we can skip it
-    auto old = m_signal(i);
-    if (old > 1) {
-      continue;
-    }
-
-    // get the max coefficient from the buffer row
-    double max = -std::numeric_limits<double>::max();
-    size_t max_idx = 0;
-    for (size_t j = 0; j < columns; j++) {
-      if (row(j) > max) {
-        max = row(j);
-        max_idx = j;
-      }
-    }
-    max_idx = (max_idx - buffer_idx + window) % window;
-    max_idx += 1;
-    m_signal(i) = static_cast<double>(max_idx);
-    cacheColumn()(i) = m_signal(i);
-  }
+void TsArgExtremumObserverNode::reset() noexcept {
+  m_signal.setConstant(std::numeric_limits<double>::quiet_NaN());
 }
 
+//============================================================================
+TsArgMaxObserverNode::TsArgMaxObserverNode(
+    Option<String> id, SharedPtr<StrategyBufferOpNode> parent,
+    size_t window) noexcept
+    : TsArgExtremumObserverNode(id, parent, AssetObserverType::TS_ARGMAX,
+                                window, true) {}
+
+//============================================================================
+TsArgMaxObserverNode::~TsArgMaxObserverNode() noexcept {}
+
+//============================================================================
+TsArgMinObserverNode::TsArgMinObserverNode(
+    Option<String> id, SharedPtr<StrategyBufferOpNode> parent,
+    size_t window) noexcept
+    : TsArgExtremumObserverNode(id, parent, AssetObserverType::TS_ARGMIN,
+                                window, false) {}
+
+//============================================================================
+TsArgMinObserverNode::~TsArgMinObserverNode() noexcept {}
+
 //============================================================================
 VarianceObserverNode::VarianceObserverNode(
     Option<String> id, SharedPtr<StrategyBufferOpNode> parent,
@@ -201,6 +265,7 @@ VarianceObserverNode::VarianceObserverNode(
   auto mean = std::make_shared<MeanObserverNode>(sum_id, parent, window);
   m_mean_observer = std::static_pointer_cast<MeanObserverNode>(
       m_exchange.registerObserver(std::move(mean)));
+  addInput(m_mean_observer);
 
   Option<String> sum_sq_id = std::nullopt;
   if (id.has_value())
@@ -211,6 +276,7 @@ VarianceObserverNode::VarianceObserverNode(
       std::move(sum_sq_id), std::move(squared_node), window);
   m_sum_squared_observer = std::static_pointer_cast<SumObserverNode>(
       m_exchange.registerObserver(std::move(sum_sq)));
+  addInput(m_sum_squared_observer);
   setObserverWarmup(parent->getWarmup());
   setWarmup(parent->getWarmup() + window);
 }
@@ -241,6 +307,7 @@ CovarianceObserverNode::CovarianceObserverNode(
     SharedPtr<StrategyBufferOpNode> right_parent, size_t window) noexcept
     : AssetObserverNode(id, left_parent, AssetObserverType::COVARIANCE, window),
       m_right_parent(right_parent) {
+  addInput(m_right_parent);
   Option<String> left_sum_id = std::nullopt;
   if (id.has_value())
     left_sum_id = id.value() + "_left_sum";
@@ -248,6 +315,7 @@ CovarianceObserverNode::CovarianceObserverNode(
       std::make_shared<SumObserverNode>(left_sum_id, left_parent, window);
   m_left_sum_observer = std::static_pointer_cast<SumObserverNode>(
       m_exchange.registerObserver(std::move(left_sum)));
+  addInput(m_left_sum_observer);
 
   Option<String> right_sum_id = std::nullopt;
   if (id.has_value())
@@ -256,6 +324,7 @@ CovarianceObserverNode::CovarianceObserverNode(
       std::make_shared<SumObserverNode>(right_sum_id, right_parent, window);
   m_right_sum_observer = std::static_pointer_cast<SumObserverNode>(
       m_exchange.registerObserver(std::move(right_sum)));
+  addInput(m_right_sum_observer);
 
   Option<String> cross_sum_id = std::nullopt;
   if (id.has_value())
@@ -266,6 +335,7 @@ CovarianceObserverNode::CovarianceObserverNode(
       std::make_shared<SumObserverNode>(cross_sum_id, product_node, window);
   m_cross_sum_observer = std::static_pointer_cast<SumObserverNode>(
       m_exchange.registerObserver(std::move(cross_sum)));
+  addInput(m_cross_sum_observer);
 
   size_t parent_warmup =
       std::max(left_parent->getWarmup(), right_parent->getWarmup());
@@ -294,18 +364,134 @@ void CovarianceObserverNode::cacheObserver() noexcept {
 void CovarianceObserverNode::reset() noexcept { m_signal.setConstant(0); }
 
 
+//============================================================================
+CentralMomentObserverNode::CentralMomentObserverNode(
+    Option<String> id, SharedPtr<StrategyBufferOpNode> parent,
+    size_t window) noexcept
+    : AssetObserverNode(id, parent, AssetObserverType::CENTRAL_MOMENT, window) {
+  size_t asset_count = m_exchange.getAssetCount();
+  for (auto *v : {&m_expired, &m_mean, &m_m2, &m_m3, &m_m4, &m_delta, &m_term}) {
+    v->resize(asset_count);
+    v->setZero();
+  }
+  setObserverWarmup(parent->getWarmup());
+  setWarmup(parent->getWarmup() + window);
+}
+
+//============================================================================
+CentralMomentObserverNode::~CentralMomentObserverNode() noexcept {}
+
+//============================================================================
+void CentralMomentObserverNode::add(
+    LinAlg::EigenRef<const LinAlg::EigenVectorXd> x) noexcept {
+  double n = static_cast<double>(m_count + 1);
+  m_delta = (x - m_mean) / n;
+  auto dn = m_delta.array();
+  m_term = dn.square() * (n * (n - 1.0));
+  auto term = m_term.array();
+  m_mean += m_delta;
+  // M4 and M3 use the sums before this observation
+  m_m4.array() += term * dn.square() * (n * n - 3.0 * n + 3.0) +
+                  6.0 * dn.square() * m_m2.array() - 4.0 * dn * m_m3.array();
+  m_m3.array() += term * dn * (n - 2.0) - 3.0 * dn * m_m2.array();
+  m_m2 += m_term;
+  m_count++;
+}
+
+//============================================================================
+void CentralMomentObserverNode::remove(
+    LinAlg::EigenRef<const LinAlg::EigenVectorXd> x) noexcept {
+  if (m_count <= 1) {
+    reset();
+    return;
+  }
+  // invert add, recovering the sums as they were before x was added
+  double n = static_cast<double>(m_count);
+  m_mean = (n * m_mean - x) / (n - 1.0);
+  m_delta = (x - m_mean) / n;
+  auto dn = m_delta.array();
+  m_term = dn.square() * (n * (n - 1.0));
+  auto term = m_term.array();
+  m_m2 -= m_term;
+  m_m3.array() -= term * dn * (n - 2.0) - 3.0 * dn * m_m2.array();
+  m_m4.array() -= term * dn.square() * (n * n - 3.0 * n + 3.0) +
+                  6.0 * dn.square() * m_m2.array() - 4.0 * dn * m_m3.array();
+  m_count--;
+}
+
+//============================================================================
+void CentralMomentObserverNode::recompute() noexcept {
+  // only valid with a full window of history
+  size_t window = getWindow();
+  m_mean.setZero();
+  for (size_t lag = 0; lag < window; lag++) {
+    m_mean += history(lag);
+  }
+  m_mean /= static_cast<double>(window);
+  m_m2.setZero();
+  m_m3.setZero();
+  m_m4.setZero();
+  for (size_t lag = 0; lag < window; lag++) {
+    m_delta = history(lag) - m_mean;
+    auto d = m_delta.array();
+    m_m2.array() += d.square();
+    m_m3.array() += d.cube();
+    m_m4.array() += d.square().square();
+  }
+}
+
+//============================================================================
+void CentralMomentObserverNode::onOutOfRange(
+    LinAlg::EigenRef<LinAlg::EigenVectorXd> buffer_old) noexcept {
+  // the oldest observation may be overwritten in the shared history before
+  // the next cacheObserver call, so it is copied out and removed then,
+  // keeping the signal for this step on the full window for dependent
+  // observers
+  if (m_count == getWindow()) {
+    m_expired = buffer_old;
+    m_has_expired = true;
+  }
+}
+
+//============================================================================
+void CentralMomentObserverNode::cacheObserver() noexcept {
+  if (m_has_expired) {
+    remove(m_expired);
+    m_has_expired = false;
+  }
+  add(buffer());
+  if (m_count == getWindow()) {
+    if (m_exact_countdown == 0) {
+      recompute();
+      m_exact_countdown = getWindow();
+    }
+    m_exact_countdown--;
+  }
+  m_signal = m_m2 / static_cast<double>(m_count);
+}
+
+//============================================================================
+void CentralMomentObserverNode::reset() noexcept {
+  m_count = 0;
+  m_exact_countdown = 0;
+  m_has_expired = false;
+  m_mean.setZero();
+  m_m2.setZero();
+  m_m3.setZero();
+  m_m4.setZero();
+  m_signal.setZero();
+}
+
 //============================================================================
 SkewnessObserverNode::SkewnessObserverNode(
     Option<String> id, SharedPtr<StrategyBufferOpNode> parent,
     size_t window) noexcept
     : AssetObserverNode(id, parent, AssetObserverType::SKEWNESS, window) {
-  auto mean = std::make_shared<MeanObserverNode>(std::nullopt, parent, window);
-  m_mean_observer = std::static_pointer_cast<MeanObserverNode>(
-      m_exchange.registerObserver(std::move(mean)));
-  auto var =
-      std::make_shared<VarianceObserverNode>(std::nullopt, parent, window);
-  m_var_observer = std::static_pointer_cast<VarianceObserverNode>(
-      m_exchange.registerObserver(std::move(var)));
+  auto moments =
+      std::make_shared<CentralMomentObserverNode>(std::nullopt, parent, window);
+  m_moment_observer = std::static_pointer_cast<CentralMomentObserverNode>(
+      m_exchange.registerObserver(std::move(moments)));
+  addInput(m_moment_observer);
 
   setObserverWarmup(parent->getWarmup());
   setWarmup(parent->getWarmup() + window);
@@ -320,22 +506,53 @@ void SkewnessObserverNode::onOutOfRange(
 
 //============================================================================
 void SkewnessObserverNode::cacheObserver() noexcept {
-  // Fisher-Pearson coefficient of skewness
-  auto const &data = getBufferMatrix();
-  Eigen::VectorXd const& mean = m_mean_observer->getSignalCopy();
-  LinAlg::EigenMatrixXd centered = data.colwise() - mean;
-  Eigen::VectorXd third_moment_sum = centered.array().pow(3).rowwise().sum();
-  Eigen::VectorXd std_dev = m_var_observer->getSignalCopy().array().pow(1.5);
-  std_dev *= static_cast<double>(getWindow());
-  m_signal = third_moment_sum.cwiseQuotient(std_dev);
+  // Fisher-Pearson coefficient of skewness, sqrt(n) * M3 / M2^1.5
+  double n = static_cast<double>(m_moment_observer->count());
+  m_signal = std::sqrt(n) * m_moment_observer->m3().array() /
+             m_moment_observer->m2().array().pow(1.5);
 }
 
-
 //============================================================================
 void SkewnessObserverNode::reset() noexcept {
   m_signal.setConstant(0);
-  m_mean_observer->reset();
-  m_var_observer->reset();
+  m_moment_observer->reset();
+}
+
+//============================================================================
+KurtosisObserverNode::KurtosisObserverNode(
+    Option<String> id, SharedPtr<StrategyBufferOpNode> parent,
+    size_t window) noexcept
+    : AssetObserverNode(id, parent, AssetObserverType::KURTOSIS, window) {
+  auto moments =
+      std::make_shared<CentralMomentObserverNode>(std::nullopt, parent, window);
+  m_moment_observer = std::static_pointer_cast<CentralMomentObserverNode>(
+      m_exchange.registerObserver(std::move(moments)));
+  addInput(m_moment_observer);
+
+  setObserverWarmup(parent->getWarmup());
+  setWarmup(parent->getWarmup() + window);
+}
+
+//============================================================================
+KurtosisObserverNode::~KurtosisObserverNode() noexcept {}
+
+//============================================================================
+void KurtosisObserverNode::onOutOfRange(
+    LinAlg::EigenRef<LinAlg::EigenVectorXd> buffer_old) noexcept {}
+
+//============================================================================
+void KurtosisObserverNode::cacheObserver() noexcept {
+  // n * M4 / M2^2 - 3
+  double n = static_cast<double>(m_moment_observer->count());
+  m_signal = n * m_moment_observer->m4().array() /
+                 m_moment_observer->m2().array().square() -
+             3.0;
+}
+
+//============================================================================
+void KurtosisObserverNode::reset() noexcept {
+  m_signal.setConstant(0);
+  m_moment_observer->reset();
 }
 
 //============================================================================
@@ -345,6 +562,7 @@ CorrelationObserverNode::CorrelationObserverNode(
     : AssetObserverNode(id, left_parent, AssetObserverType::CORRELATION,
                         window),
       m_right_parent(right_parent) {
+  addInput(m_right_parent);
   Option<String> left_sum_id = std::nullopt;
   if (id.has_value())
     left_sum_id = id.value() + "_left_var";
@@ -352,6 +570,7 @@ CorrelationObserverNode::CorrelationObserverNode(
       std::make_shared<VarianceObserverNode>(left_sum_id, left_parent, window);
   m_left_var_observer = std::static_pointer_cast<VarianceObserverNode>(
       m_exchange.registerObserver(std::move(m_left_var_observer)));
+  addInput(m_left_var_observer);
 
   Option<String> right_sum_id = std::nullopt;
   if (id.has_value())
@@ -360,6 +579,7 @@ CorrelationObserverNode::CorrelationObserverNode(
       right_sum_id, right_parent, window);
   m_right_var_observer = std::static_pointer_cast<VarianceObserverNode>(
       m_exchange.registerObserver(std::move(m_right_var_observer)));
+  addInput(m_right_var_observer);
 
   Option<String> cov_id = std::nullopt;
   if (id.has_value())
@@ -368,6 +588,7 @@ CorrelationObserverNode::CorrelationObserverNode(
       cov_id, left_parent, right_parent, window);
   m_cov_observer = std::static_pointer_cast<CovarianceObserverNode>(
       m_exchange.registerObserver(std::move(m_cov_observer)));
+  addInput(m_cov_observer);
   size_t parent_warmup =
       std::max(left_parent->getWarmup(), right_parent->getWarmup());
   setObserverWarmup(parent_warmup);
@@ -431,6 +652,899 @@ void LinearDecayNode::reset() noexcept {
   is_first_step = true;
 }
 
+//============================================================================
+OrderStatisticTree::OrderStatisticTree(size_t capacity) noexcept {
+  m_nodes.resize(capacity);
+  m_free.reserve(capacity);
+  clear();
+}
+
+//============================================================================
+void OrderStatisticTree::clear() noexcept {
+  m_root = -1;
+  m_free.clear();
+  for (size_t i = m_nodes.size(); i > 0; i--) {
+    m_free.push_back(static_cast<Int32>(i - 1));
+  }
+}
+
+//============================================================================
+void OrderStatisticTree::update(Int32 t) noexcept {
+  auto &node = m_nodes[t];
+  node.size = 1 + size(node.left) + size(node.right);
+}
+
+//============================================================================
+void OrderStatisticTree::split(Int32 t, double value, bool inclusive,
+                               Int32 &left, Int32 &right) noexcept {
+  if (t < 0) {
+    left = right = -1;
+    return;
+  }
+  auto &node = m_nodes[t];
+  bool goes_left = inclusive ? node.value <= value : node.value < value;
+  if (goes_left) {
+    split(node.right, value, inclusive, node.right, right);
+    left = t;
+  } else {
+    split(node.left, value, inclusive, left, node.left);
+    right = t;
+  }
+  update(t);
+}
+
+//============================================================================
+Int32 OrderStatisticTree::merge(Int32 left, Int32 right) noexcept {
+  if (left < 0) {
+    return right;
+  }
+  if (right < 0) {
+    return left;
+  }
+  if (m_nodes[left].priority > m_nodes[right].priority) {
+    m_nodes[left].right = merge(m_nodes[left].right, right);
+    update(left);
+    return left;
+  }
+  m_nodes[right].left = merge(left, m_nodes[right].left);
+  update(right);
+  return right;
+}
+
+//============================================================================
+void OrderStatisticTree::insert(double value) noexcept {
+  assert(!m_free.empty());
+  Int32 t = m_free.back();
+  m_free.pop_back();
+  // xorshift32 priorities keep the treap balanced in expectation
+  m_seed ^= m_seed << 13;
+  m_seed ^= m_seed >> 17;
+  m_seed ^= m_seed << 5;
+  m_nodes[t] = {value, m_seed, -1, -1, 1};
+
+  Int32 left, right;
+  split(m_root, value, false, left, right);
+  m_root = merge(merge(left, t), right);
+}
+
+//============================================================================
+bool OrderStatisticTree::erase(double value) noexcept {
+  Int32 left, middle, right;
+  split(m_root, value, false, left, right);
+  split(right, value, true, middle, right);
+  bool found = middle >= 0;
+  if (found) {
+    // drop a single copy, the root of the equal range
+    m_free.push_back(middle);
+    middle = merge(m_nodes[middle].left, m_nodes[middle].right);
+  }
+  m_root = merge(merge(left, middle), right);
+  return found;
+}
+
+//============================================================================
+double OrderStatisticTree::kth(size_t k) const noexcept {
+  assert(k < size());
+  Int32 t = m_root;
+  while (t >= 0) {
+    auto const &node = m_nodes[t];
+    size_t left_size = size(node.left);
+    if (k < left_size) {
+      t = node.left;
+    } else if (k == left_size) {
+      return node.value;
+    } else {
+      k -= left_size + 1;
+      t = node.right;
+    }
+  }
+  return std::numeric_limits<double>::quiet_NaN();
+}
+
+//============================================================================
+size_t OrderStatisticTree::countLess(double value) const noexcept {
+  size_t count = 0;
+  Int32 t = m_root;
+  while (t >= 0) {
+    auto const &node = m_nodes[t];
+    if (node.value < value) {
+      count += size(node.left) + 1;
+      t = node.right;
+    } else {
+      t = node.left;
+    }
+  }
+  return count;
+}
+
+//============================================================================
+size_t OrderStatisticTree::countLessEqual(double value) const noexcept {
+  size_t count = 0;
+  Int32 t = m_root;
+  while (t >= 0) {
+    auto const &node = m_nodes[t];
+    if (node.value <= value) {
+      count += size(node.left) + 1;
+      t = node.right;
+    } else {
+      t = node.left;
+    }
+  }
+  return count;
+}
+
+//============================================================================
+OrderStatisticObserverNode::OrderStatisticObserverNode(
+    Option<String> id, SharedPtr<StrategyBufferOpNode> parent,
+    AssetObserverType observer_type, size_t window) noexcept
+    : AssetObserverNode(id, parent, observer_type, window) {
+  size_t asset_count = m_exchange.getAssetCount();
+  m_trees.reserve(asset_count);
+  for (size_t i = 0; i < asset_count; i++) {
+    m_trees.emplace_back(window);
+  }
+  setObserverWarmup(parent->getWarmup());
+  setWarmup(parent->getWarmup() + window);
+  m_signal.setConstant(std::numeric_limits<double>::quiet_NaN());
+}
+
+//============================================================================
+OrderStatisticObserverNode::~OrderStatisticObserverNode() noexcept {}
+
+//============================================================================
+void OrderStatisticObserverNode::insertObservation() noexcept {
+  auto observation = buffer();
+  for (size_t i = 0; i < m_trees.size(); i++) {
+    if (!std::isnan(observation(i))) {
+      m_trees[i].insert(observation(i));
+    }
+  }
+  m_count++;
+}
+
+//============================================================================
+void OrderStatisticObserverNode::onOutOfRange(
+    LinAlg::EigenRef<LinAlg::EigenVectorXd> buffer_old) noexcept {
+  // the exchange index can reach the window before the buffer is full when
+  // the parent has a warmup, only a full window has an observation to drop
+  if (m_count < getWindow()) {
+    return;
+  }
+  for (size_t i = 0; i < m_trees.size(); i++) {
+    if (!std::isnan(buffer_old(i))) {
+      m_trees[i].erase(buffer_old(i));
+    }
+  }
+  m_count--;
+}
+
+//============================================================================
+double OrderStatisticObserverNode::quantile(size_t asset,
+                                            double q) const noexcept {
+  auto const &tree = m_trees[asset];
+  size_t n = tree.size();
+  if (!n) {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+  double h = q * static_cast<double>(n - 1);
+  size_t lo = static_cast<size_t>(std::floor(h));
+  double lo_value = tree.kth(lo);
+  if (lo + 1 >= n) {
+    return lo_value;
+  }
+  return lo_value + (h - static_cast<double>(lo)) * (tree.kth(lo + 1) - lo_value);
+}
+
+//============================================================================
+void OrderStatisticObserverNode::reset() noexcept {
+  m_count = 0;
+  for (auto &tree : m_trees) {
+    tree.clear();
+  }
+  m_signal.setConstant(std::numeric_limits<double>::quiet_NaN());
+}
+
+//============================================================================
+QuantileObserverNode::QuantileObserverNode(
+    Option<String> id, SharedPtr<StrategyBufferOpNode> parent, size_t window,
+    double quantile) noexcept
+    : OrderStatisticObserverNode(id, parent, AssetObserverType::QUANTILE,
+                                 window),
+      m_quantile(std::clamp(quantile, 0.0, 1.0)) {}
+
+//============================================================================
+QuantileObserverNode::~QuantileObserverNode() noexcept {}
+
+//============================================================================
+void QuantileObserverNode::cacheObserver() noexcept {
+  insertObservation();
+  for (size_t i = 0; i < m_trees.size(); i++) {
+    m_signal(i) = quantile(i, m_quantile);
+  }
+}
+
+//============================================================================
+MedianObserverNode::MedianObserverNode(Option<String> id,
+                                       SharedPtr<StrategyBufferOpNode> parent,
+                                       size_t window) noexcept
+    : OrderStatisticObserverNode(id, parent, AssetObserverType::MEDIAN,
+                                 window) {}
+
+//============================================================================
+MedianObserverNode::~MedianObserverNode() noexcept {}
+
+//============================================================================
+void MedianObserverNode::cacheObserver() noexcept {
+  insertObservation();
+  for (size_t i = 0; i < m_trees.size(); i++) {
+    m_signal(i) = quantile(i, 0.5);
+  }
+}
+
+//============================================================================
+TsRankObserverNode::TsRankObserverNode(Option<String> id,
+                                       SharedPtr<StrategyBufferOpNode> parent,
+                                       size_t window) noexcept
+    : OrderStatisticObserverNode(id, parent, AssetObserverType::TS_RANK,
+                                 window) {}
+
+//============================================================================
+TsRankObserverNode::~TsRankObserverNode() noexcept {}
+
+//============================================================================
+void TsRankObserverNode::cacheObserver() noexcept {
+  insertObservation();
+  auto observation = buffer();
+  for (size_t i = 0; i < m_trees.size(); i++) {
+    double value = observation(i);
+    auto const &tree = m_trees[i];
+    if (std::isnan(value)) {
+      m_signal(i) = std::numeric_limits<double>::quiet_NaN();
+      continue;
+    }
+    double less = static_cast<double>(tree.countLess(value));
+    double less_equal = static_cast<double>(tree.countLessEqual(value));
+    double rank = less + (less_equal - less + 1.0) / 2.0;
+    m_signal(i) = rank / static_cast<double>(tree.size());
+  }
+}
+
+//============================================================================
+EWMAObserverNodeBase::EWMAObserverNodeBase(
+    Option<String> id, SharedPtr<StrategyBufferOpNode> parent,
+    AssetObserverType observer_type, double param,
+    EWMAParamType param_type) noexcept
+    : AssetObserverNode(id, parent, observer_type, 1),
+      m_alpha(toAlpha(param, param_type)) {
+  setObserverWarmup(parent->getWarmup());
+  setWarmup(parent->getWarmup());
+  m_signal.setConstant(std::numeric_limits<double>::quiet_NaN());
+}
+
+//============================================================================
+EWMAObserverNodeBase::~EWMAObserverNodeBase() noexcept {}
+
+//============================================================================
+double EWMAObserverNodeBase::toAlpha(double param,
+                                     EWMAParamType param_type) noexcept {
+  switch (param_type) {
+  case EWMAParamType::SPAN:
+    return 2.0 / (std::max(param, 1.0) + 1.0);
+  case EWMAParamType::HALF_LIFE:
+    return 1.0 - std::exp(-std::log(2.0) / std::max(param, 1e-12));
+  case EWMAParamType::WILDER:
+    return 1.0 / std::max(param, 1.0);
+  }
+  return 1.0;
+}
+
+//============================================================================
+void EWMAObserverNodeBase::smooth(
+    LinAlg::EigenRef<LinAlg::EigenVectorXd> state,
+    LinAlg::EigenRef<const LinAlg::EigenVectorXd> observation,
+    double alpha) noexcept {
+  for (size_t i = 0; i < static_cast<size_t>(state.rows()); i++) {
+    double x = observation(i);
+    if (std::isnan(x)) {
+      continue;
+    }
+    if (std::isnan(state(i))) {
+      state(i) = x;
+    } else {
+      state(i) += alpha * (x - state(i));
+    }
+  }
+}
+
+//============================================================================
+EWMAMeanObserverNode::EWMAMeanObserverNode(
+    Option<String> id, SharedPtr<StrategyBufferOpNode> parent, double param,
+    EWMAParamType param_type) noexcept
+    : EWMAObserverNodeBase(id, parent, AssetObserverType::EWMA_MEAN, param,
+                           param_type) {}
+
+//============================================================================
+EWMAMeanObserverNode::~EWMAMeanObserverNode() noexcept {}
+
+//============================================================================
+void EWMAMeanObserverNode::cacheObserver() noexcept {
+  smooth(m_signal, buffer(), m_alpha);
+}
+
+//============================================================================
+void EWMAMeanObserverNode::reset() noexcept {
+  m_signal.setConstant(std::numeric_limits<double>::quiet_NaN());
+}
+
+//============================================================================
+EWMAVarianceObserverNode::EWMAVarianceObserverNode(
+    Option<String> id, SharedPtr<StrategyBufferOpNode> parent, double param,
+    EWMAParamType param_type) noexcept
+    : EWMAObserverNodeBase(id, parent, AssetObserverType::EWMA_VARIANCE,
+                           param, param_type) {
+  m_mean.resize(m_exchange.getAssetCount());
+  m_mean.setConstant(std::numeric_limits<double>::quiet_NaN());
+}
+
+//============================================================================
+EWMAVarianceObserverNode::~EWMAVarianceObserverNode() noexcept {}
+
+//============================================================================
+void EWMAVarianceObserverNode::cacheObserver() noexcept {
+  auto observation = buffer();
+  for (size_t i = 0; i < static_cast<size_t>(m_signal.rows()); i++) {
+    double x = observation(i);
+    if (std::isnan(x)) {
+      continue;
+    }
+    if (std::isnan(m_mean(i))) {
+      m_mean(i) = x;
+      m_signal(i) = 0.0;
+      continue;
+    }
+    double delta = x - m_mean(i);
+    m_mean(i) += m_alpha * delta;
+    m_signal(i) = (1.0 - m_alpha) * (m_signal(i) + m_alpha * delta * delta);
+  }
+}
+
+//============================================================================
+void EWMAVarianceObserverNode::reset() noexcept {
+  m_mean.setConstant(std::numeric_limits<double>::quiet_NaN());
+  m_signal.setConstant(std::numeric_limits<double>::quiet_NaN());
+}
+
+//============================================================================
+EWMAVolatilityObserverNode::EWMAVolatilityObserverNode(
+    Option<String> id, SharedPtr<StrategyBufferOpNode> parent, double param,
+    EWMAParamType param_type) noexcept
+    : EWMAObserverNodeBase(id, parent, AssetObserverType::EWMA_VOLATILITY,
+                           param, param_type) {
+  Option<String> var_id = std::nullopt;
+  if (id.has_value()) {
+    var_id = id.value() + "_var";
+  }
+  auto var = std::make_shared<EWMAVarianceObserverNode>(var_id, parent, param,
+                                                        param_type);
+  m_var_observer = std::static_pointer_cast<EWMAVarianceObserverNode>(
+      m_exchange.registerObserver(std::move(var)));
+  addInput(m_var_observer);
+}
+
+//============================================================================
+EWMAVolatilityObserverNode::~EWMAVolatilityObserverNode() noexcept {}
+
+//============================================================================
+void EWMAVolatilityObserverNode::cacheObserver() noexcept {
+  m_signal = m_var_observer->getSignalCopy().cwiseSqrt();
+}
+
+//============================================================================
+void EWMAVolatilityObserverNode::reset() noexcept {
+  m_signal.setConstant(std::numeric_limits<double>::quiet_NaN());
+}
+
+//============================================================================
+EWMAZScoreObserverNode::EWMAZScoreObserverNode(
+    Option<String> id, SharedPtr<StrategyBufferOpNode> parent, double param,
+    EWMAParamType param_type) noexcept
+    : EWMAObserverNodeBase(id, parent, AssetObserverType::EWMA_ZSCORE, param,
+                           param_type) {
+  Option<String> var_id = std::nullopt;
+  if (id.has_value()) {
+    var_id = id.value() + "_var";
+  }
+  auto var = std::make_shared<EWMAVarianceObserverNode>(var_id, parent, param,
+                                                        param_type);
+  m_var_observer = std::static_pointer_cast<EWMAVarianceObserverNode>(
+      m_exchange.registerObserver(std::move(var)));
+  addInput(m_var_observer);
+}
+
+//============================================================================
+EWMAZScoreObserverNode::~EWMAZScoreObserverNode() noexcept {}
+
+//============================================================================
+void EWMAZScoreObserverNode::cacheObserver() noexcept {
+  auto observation = buffer();
+  auto const &mean = m_var_observer->mean();
+  auto const &var = m_var_observer->getSignalCopy();
+  for (size_t i = 0; i < static_cast<size_t>(m_signal.rows()); i++) {
+    m_signal(i) = var(i) > 0.0 ? (observation(i) - mean(i)) / std::sqrt(var(i))
+                               : std::numeric_limits<double>::quiet_NaN();
+  }
+}
+
+//============================================================================
+void EWMAZScoreObserverNode::reset() noexcept {
+  m_signal.setConstant(std::numeric_limits<double>::quiet_NaN());
+}
+
+//============================================================================
+EWMACovarianceObserverNode::EWMACovarianceObserverNode(
+    Option<String> id, SharedPtr<StrategyBufferOpNode> left_parent,
+    SharedPtr<StrategyBufferOpNode> right_parent, double param,
+    EWMAParamType param_type, Option<size_t> benchmark_asset) noexcept
+    : EWMAObserverNodeBase(id, left_parent, AssetObserverType::EWMA_COVARIANCE,
+                           param, param_type),
+      m_right_parent(right_parent), m_benchmark_asset(benchmark_asset) {
+  addInput(m_right_parent);
+  size_t asset_count = m_exchange.getAssetCount();
+  m_right_buffer.resize(asset_count);
+  m_right_buffer.setZero();
+  m_left_mean.resize(asset_count);
+  m_right_mean.resize(asset_count);
+  reset();
+  size_t parent_warmup =
+      std::max(left_parent->getWarmup(), right_parent->getWarmup());
+  setObserverWarmup(parent_warmup);
+  setWarmup(parent_warmup);
+}
+
+//============================================================================
+EWMACovarianceObserverNode::~EWMACovarianceObserverNode() noexcept {}
+
+//============================================================================
+Vector<double> EWMACovarianceObserverNode::getObserverParams() const noexcept {
+  double benchmark = m_benchmark_asset
+                         ? static_cast<double>(*m_benchmark_asset)
+                         : -1.0;
+  return {m_alpha, benchmark};
+}
+
+//============================================================================
+void EWMACovarianceObserverNode::cacheObserver() noexcept {
+  auto left = buffer();
+  auto right = m_right_parent->read(m_right_buffer);
+  for (size_t i = 0; i < static_cast<size_t>(m_signal.rows()); i++) {
+    double x = left(i);
+    double y = m_benchmark_asset ? right(*m_benchmark_asset) : right(i);
+    if (std::isnan(x) || std::isnan(y)) {
+      continue;
+    }
+    if (std::isnan(m_left_mean(i))) {
+      m_left_mean(i) = x;
+      m_right_mean(i) = y;
+      m_signal(i) = 0.0;
+      continue;
+    }
+    double delta_x = x - m_left_mean(i);
+    double delta_y = y - m_right_mean(i);
+    m_left_mean(i) += m_alpha * delta_x;
+    m_right_mean(i) += m_alpha * delta_y;
+    m_signal(i) =
+        (1.0 - m_alpha) * (m_signal(i) + m_alpha * delta_x * delta_y);
+  }
+}
+
+//============================================================================
+void EWMACovarianceObserverNode::reset() noexcept {
+  m_left_mean.setConstant(std::numeric_limits<double>::quiet_NaN());
+  m_right_mean.setConstant(std::numeric_limits<double>::quiet_NaN());
+  m_signal.setConstant(std::numeric_limits<double>::quiet_NaN());
+}
+
+//============================================================================
+MultiWindowObserverNode::MultiWindowObserverNode(
+    Option<String> id, SharedPtr<StrategyBufferOpNode> parent,
+    size_t max_window) noexcept
+    : AssetObserverNode(id, parent, AssetObserverType::MULTI_WINDOW,
+                        max_window) {
+  setObserverWarmup(parent->getWarmup());
+  setWarmup(parent->getWarmup() + max_window - 1);
+  // one more column than the window so the prefix before the oldest
+  // observation of the largest window is still held
+  size_t asset_count = m_exchange.getAssetCount();
+  m_prefix.resize(asset_count, max_window + 1);
+  m_prefix_squared.resize(asset_count, max_window + 1);
+  m_prefix.setZero();
+  m_prefix_squared.setZero();
+}
+
+//============================================================================
+MultiWindowObserverNode::~MultiWindowObserverNode() noexcept {}
+
+//============================================================================
+size_t MultiWindowObserverNode::prefixColumn(size_t window) const noexcept {
+  // before the window has filled the sum starts from the zero prefix held
+  // in the oldest column
+  size_t capacity = static_cast<size_t>(m_prefix.cols());
+  size_t lag = std::min(window, m_count - 1);
+  return (m_head + capacity - lag) % capacity;
+}
+
+//============================================================================
+void MultiWindowObserverNode::windowStatistic(
+    AssetObserverType statistic, size_t window,
+    LinAlg::EigenRef<LinAlg::EigenVectorXd> target) noexcept {
+  assert(window && window <= getWindow());
+  size_t start = prefixColumn(window);
+  target = m_prefix.col(m_head) - m_prefix.col(start);
+  switch (statistic) {
+  case AssetObserverType::SUM:
+    break;
+  case AssetObserverType::MEAN:
+    target /= static_cast<double>(window);
+    break;
+  case AssetObserverType::VARIANCE: {
+    // same population variance as the variance observer
+    target = (m_prefix_squared.col(m_head) - m_prefix_squared.col(start)) -
+             target.cwiseAbs2() / static_cast<double>(window);
+    if (window > 1)
+      target /= static_cast<double>(window);
+    break;
+  }
+  default:
+    assert(false);
+  }
+}
+
+//============================================================================
+void MultiWindowObserverNode::cacheObserver() noexcept {
+  size_t capacity = static_cast<size_t>(m_prefix.cols());
+  size_t previous = m_head;
+  m_head = (m_head + 1) % capacity;
+  auto observation = buffer();
+  m_prefix.col(m_head) = m_prefix.col(previous) + observation;
+  m_prefix_squared.col(m_head) =
+      m_prefix_squared.col(previous) + observation.cwiseAbs2();
+  m_count = std::min(m_count + 1, capacity);
+
+  // window sums are differences of prefix columns, so subtracting the newest
+  // prefix from every column once per pass over the ring leaves them
+  // unchanged while keeping the prefixes bounded
+  if (++m_step % capacity == 0) {
+    LinAlg::EigenVectorXd base = m_prefix.col(m_head);
+    m_prefix.colwise() -= base;
+    base = m_prefix_squared.col(m_head);
+    m_prefix_squared.colwise() -= base;
+  }
+  windowStatistic(AssetObserverType::SUM, getWindow(), m_signal);
+}
+
+//============================================================================
+void MultiWindowObserverNode::reset() noexcept {
+  m_prefix.setZero();
+  m_prefix_squared.setZero();
+  m_head = 0;
+  m_count = 1;
+  m_step = 0;
+  m_signal.setZero();
+}
+
+//============================================================================
+WindowViewNode::WindowViewNode(SharedPtr<MultiWindowObserverNode> observer,
+                               size_t window,
+                               AssetObserverType statistic) noexcept
+    : StrategyBufferOpNode(NodeType::WINDOW_VIEW, observer->getExchange(),
+                           observer.get()),
+      m_observer(std::move(observer)), m_statistic(statistic),
+      m_window(window) {
+  assert(m_window && m_window <= m_observer->window());
+  addInput(m_observer);
+  // warmups match the sum, mean and variance observers of the same window
+  size_t parent_warmup = m_observer->m_parent->getWarmup();
+  m_warmup = statistic == AssetObserverType::SUM
+                 ? parent_warmup + window - 1
+                 : parent_warmup + window;
+}
+
+//============================================================================
+WindowViewNode::~WindowViewNode() noexcept {}
+
+//============================================================================
+SharedPtr<WindowViewNode>
+WindowViewNode::make(SharedPtr<MultiWindowObserverNode> observer,
+                     size_t window, AssetObserverType statistic) noexcept {
+  return std::make_shared<WindowViewNode>(std::move(observer), window,
+                                          statistic);
+}
+
+//============================================================================
+bool WindowViewNode::isSame(StrategyBufferOpNode const *other) const noexcept {
+  if (other->getType() != NodeType::WINDOW_VIEW)
+    return false;
+  auto ptr = static_cast<WindowViewNode const *>(other);
+  return ptr->m_observer == m_observer && ptr->m_window == m_window &&
+         ptr->m_statistic == m_statistic;
+}
+
+//============================================================================
+void WindowViewNode::evaluate(
+    LinAlg::EigenRef<LinAlg::EigenVectorXd> target) noexcept {
+  m_observer->windowStatistic(m_statistic, m_window, target);
+  cacheOutput(target);
+}
+
+//============================================================================
+RollingRegressionObserverNode::RollingRegressionObserverNode(
+    Option<String> id, SharedPtr<StrategyBufferOpNode> parent,
+    SharedPtr<StrategyBufferOpNode> benchmark, size_t window,
+    RegressionOutputType output, Option<size_t> benchmark_asset) noexcept
+    : AssetObserverNode(id, parent, AssetObserverType::ROLLING_REGRESSION,
+                        window),
+      m_right_parent(benchmark), m_benchmark_asset(benchmark_asset),
+      m_output(output) {
+  addInput(m_right_parent);
+  size_t parent_warmup =
+      std::max(parent->getWarmup(), m_right_parent->getWarmup());
+  setObserverWarmup(parent_warmup);
+  setWarmup(parent_warmup + window);
+  size_t asset_count = m_exchange.getAssetCount();
+  m_signal.setConstant(std::numeric_limits<double>::quiet_NaN());
+  if (output != RegressionOutputType::BETA) {
+    // the sums live on the BETA node, shared by every output
+    Option<String> source_id = std::nullopt;
+    if (id.has_value())
+      source_id = id.value() + "_regression";
+    auto source = std::make_shared<RollingRegressionObserverNode>(
+        source_id, parent, m_right_parent, window, RegressionOutputType::BETA,
+        benchmark_asset);
+    m_source = std::static_pointer_cast<RollingRegressionObserverNode>(
+        m_exchange.registerObserver(std::move(source)));
+    addInput(m_source);
+    return;
+  }
+  m_right_buffer.resize(asset_count);
+  m_right_history.resize(asset_count, window);
+  m_outputs.resize(asset_count, 4);
+  for (auto *v : {&m_sum_x, &m_sum_y, &m_sum_xy, &m_sum_xx, &m_sum_yy}) {
+    v->resize(asset_count);
+  }
+  reset();
+}
+
+//============================================================================
+RollingRegressionObserverNode::~RollingRegressionObserverNode() noexcept {}
+
+//============================================================================
+Vector<double>
+RollingRegressionObserverNode::getObserverParams() const noexcept {
+  double benchmark = m_benchmark_asset
+                         ? static_cast<double>(*m_benchmark_asset)
+                         : -1.0;
+  return {static_cast<double>(m_output), benchmark};
+}
+
+//============================================================================
+LinAlg::EigenRef<LinAlg::EigenVectorXd>
+RollingRegressionObserverNode::rightHistory(size_t lag) noexcept {
+  size_t window = getWindow();
+  return m_right_history.col((m_right_head + window - lag) % window);
+}
+
+//============================================================================
+void RollingRegressionObserverNode::recompute() noexcept {
+  // only valid with a full window of history
+  for (auto *v : {&m_sum_x, &m_sum_y, &m_sum_xy, &m_sum_xx, &m_sum_yy}) {
+    v->setZero();
+  }
+  for (size_t lag = 0; lag < getWindow(); lag++) {
+    auto x = rightHistory(lag);
+    auto y = history(lag);
+    m_sum_x += x;
+    m_sum_y += y;
+    m_sum_xy += x.cwiseProduct(y);
+    m_sum_xx += x.cwiseAbs2();
+    m_sum_yy += y.cwiseAbs2();
+  }
+}
+
+//============================================================================
+void RollingRegressionObserverNode::updateOutputs() noexcept {
+  constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+  double n = static_cast<double>(m_count);
+  for (size_t i = 0; i < static_cast<size_t>(m_outputs.rows()); i++) {
+    double sxx = m_sum_xx(i) - m_sum_x(i) * m_sum_x(i) / n;
+    double sxy = m_sum_xy(i) - m_sum_x(i) * m_sum_y(i) / n;
+    double syy = m_sum_yy(i) - m_sum_y(i) * m_sum_y(i) / n;
+    // a flat benchmark over the window leaves the regression undefined
+    double beta = sxx > 0.0 ? sxy / sxx : nan;
+    double explained = beta * sxy;
+    m_outputs(i, 0) = beta;
+    m_outputs(i, 1) = (m_sum_y(i) - beta * m_sum_x(i)) / n;
+    m_outputs(i, 2) = std::sqrt(std::max(syy - explained, 0.0) / n);
+    m_outputs(i, 3) = syy > 0.0 ? std::min(explained / syy, 1.0) : nan;
+  }
+}
+
+//============================================================================
+void RollingRegressionObserverNode::cacheObserver() noexcept {
+  if (m_source) {
+    // the BETA node is registered first so it already holds this step
+    m_signal = m_source->output(m_output);
+    return;
+  }
+  size_t window = getWindow();
+  m_right_head = m_step % window;
+  auto right = m_right_parent->read(m_right_buffer);
+  auto x = m_right_history.col(m_right_head);
+  if (m_benchmark_asset) {
+    x.setConstant(right(*m_benchmark_asset));
+  } else {
+    x = right;
+  }
+  auto y = buffer();
+  m_sum_x += x;
+  m_sum_y += y;
+  m_sum_xy += x.cwiseProduct(y);
+  m_sum_xx += x.cwiseAbs2();
+  m_sum_yy += y.cwiseAbs2();
+  m_count++;
+  m_step++;
+
+  if (m_count == window && m_step % window == 0) {
+    recompute();
+  }
+  updateOutputs();
+  m_signal = output(RegressionOutputType::BETA);
+}
+
+//============================================================================
+void RollingRegressionObserverNode::onOutOfRange(
+    LinAlg::EigenRef<LinAlg::EigenVectorXd> buffer_old) noexcept {
+  if (m_source) {
+    return;
+  }
+  auto x = rightHistory(getWindow() - 1);
+  m_sum_x -= x;
+  m_sum_y -= buffer_old;
+  m_sum_xy -= x.cwiseProduct(buffer_old);
+  m_sum_xx -= x.cwiseAbs2();
+  m_sum_yy -= buffer_old.cwiseAbs2();
+  m_count--;
+}
+
+//============================================================================
+void RollingRegressionObserverNode::reset() noexcept {
+  m_signal.setConstant(std::numeric_limits<double>::quiet_NaN());
+  if (m_source) {
+    return;
+  }
+  for (auto *v : {&m_sum_x, &m_sum_y, &m_sum_xy, &m_sum_xx, &m_sum_yy}) {
+    v->setZero();
+  }
+  m_right_buffer.setZero();
+  m_right_history.setZero();
+  m_outputs.setConstant(std::numeric_limits<double>::quiet_NaN());
+  m_right_head = 0;
+  m_count = 0;
+  m_step = 0;
+}
+
+//============================================================================
+KalmanFilterObserverNode::KalmanFilterObserverNode(
+    Option<String> id, SharedPtr<StrategyBufferOpNode> parent,
+    KalmanModelType model, double process_noise, double observation_noise,
+    double slope_noise, KalmanOutputType output) noexcept
+    : AssetObserverNode(id, parent, AssetObserverType::KALMAN_FILTER, 1),
+      m_model(model), m_output(output), m_process_noise(process_noise),
+      m_observation_noise(observation_noise), m_slope_noise(slope_noise) {
+  setObserverWarmup(parent->getWarmup());
+  setWarmup(parent->getWarmup());
+  size_t asset_count = m_exchange.getAssetCount();
+  for (auto *v : {&m_level, &m_slope, &m_p00, &m_p01, &m_p11, &m_gain,
+                  &m_slope_gain, &m_innovation}) {
+    v->resize(asset_count);
+  }
+  reset();
+}
+
+//============================================================================
+KalmanFilterObserverNode::~KalmanFilterObserverNode() noexcept {}
+
+//============================================================================
+Vector<double> KalmanFilterObserverNode::getObserverParams() const noexcept {
+  return {static_cast<double>(m_model), static_cast<double>(m_output),
+          m_process_noise, m_observation_noise, m_slope_noise};
+}
+
+//============================================================================
+void KalmanFilterObserverNode::cacheObserver() noexcept {
+  auto observation = buffer();
+  auto y = observation.array();
+  auto level = m_level.array();
+  auto slope = m_slope.array();
+  auto p00 = m_p00.array();
+  auto p01 = m_p01.array();
+  auto p11 = m_p11.array();
+  auto gain = m_gain.array();
+  auto innovation = m_innovation.array();
+  bool trend = m_model == KalmanModelType::LOCAL_TREND;
+
+  // predict, assets not yet started have a NaN level and are seeded below
+  if (trend) {
+    level += slope;
+    p00 += 2.0 * p01 + p11 + m_process_noise;
+    p01 += p11;
+    p11 += m_slope_noise;
+  } else {
+    p00 += m_process_noise;
+  }
+
+  // update, a NaN observation gives a NaN innovation and keeps the
+  // predicted state
+  innovation = y - level;
+  auto valid = innovation == innovation;
+  gain = p00 / (p00 + m_observation_noise);
+  level = valid.select(level + gain * innovation, level);
+  if (trend) {
+    auto slope_gain = m_slope_gain.array();
+    slope_gain = p01 / (p00 + m_observation_noise);
+    slope = valid.select(slope + slope_gain * innovation, slope);
+    p11 = valid.select(p11 - slope_gain * p01, p11);
+    p01 = valid.select((1.0 - gain) * p01, p01);
+  }
+  p00 = valid.select((1.0 - gain) * p00, p00);
+
+  // seed assets on their first observation
+  for (size_t i = 0; i < static_cast<size_t>(m_level.rows()); i++) {
+    if (std::isnan(m_level(i)) && !std::isnan(y(i))) {
+      m_level(i) = y(i);
+      m_slope(i) = 0.0;
+      m_p00(i) = m_observation_noise;
+      m_p01(i) = 0.0;
+      m_p11(i) = m_observation_noise;
+    }
+  }
+
+  // the local level model has no slope and reports it as zero
+  m_signal = m_output == KalmanOutputType::SLOPE ? m_slope : m_level;
+}
+
+//============================================================================
+void KalmanFilterObserverNode::reset() noexcept {
+  m_level.setConstant(std::numeric_limits<double>::quiet_NaN());
+  m_slope.setZero();
+  m_p00.setZero();
+  m_p01.setZero();
+  m_p11.setZero();
+  m_gain.setZero();
+  m_slope_gain.setZero();
+  m_innovation.setZero();
+  m_signal.setConstant(std::numeric_limits<double>::quiet_NaN());
+}
+
 } // namespace AST
 
 } // namespace Atlas
\ No newline at end of file
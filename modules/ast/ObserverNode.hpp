@@ -6,6 +6,7 @@
 #define ATLAS_API __declspec(dllimport)
 #endif
 #include "standard/AtlasCore.hpp"
+#include "standard/AtlasEnums.hpp"
 #include "ast/BaseNode.hpp"
 #include "ast/StrategyBufferNode.hpp"
 #include "ast/ObserverNodeBase.hpp"
@@ -24,9 +25,15 @@ public:
   ATLAS_API ~SumObserverNode() noexcept;
 
   [[nodiscard]] size_t refreshWarmup() noexcept override { return getWarmup(); }
+  [[nodiscard]] bool isPathIndependent(
+      Set<StrategyBufferOpNode const *> &visiting) const noexcept override {
+    return m_parent->isPathIndependent(visiting);
+  }
   void onOutOfRange(
       LinAlg::EigenRef<LinAlg::EigenVectorXd> buffer_old) noexcept override;
   void cacheObserver() noexcept override;
+  void
+  evaluateBatch(LinAlg::EigenRef<LinAlg::EigenMatrixXd> target) noexcept override;
   void reset() noexcept override;
 };
 
@@ -44,39 +51,113 @@ public:
   void onOutOfRange(
       LinAlg::EigenRef<LinAlg::EigenVectorXd> buffer_old) noexcept override;
   void cacheObserver() noexcept override;
+  void
+  evaluateBatch(LinAlg::EigenRef<LinAlg::EigenMatrixXd> target) noexcept override;
   void reset() noexcept override;
   [[nodiscard]] size_t refreshWarmup() noexcept override;
+  [[nodiscard]] bool isPathIndependent(
+      Set<StrategyBufferOpNode const *> &visiting) const noexcept override {
+    return m_sum_observer->isPathIndependent(visiting);
+  }
 };
 
 //============================================================================
-class MaxObserverNode final : public AssetObserverNode {
+/// <summary>
+/// Rolling max or min over the window kept as a monotonic deque per asset.
+/// Each asset owns a ring of window slots in flat arrays holding the steps
+/// and values of the observations that can still become the extreme, so a
+/// step costs O(1) amortized whatever the window length. NaN observations
+/// are skipped.
+/// </summary>
+class ExtremumObserverNode : public AssetObserverNode {
+private:
+  bool m_is_max;
+  size_t m_step = 0;
+  Vector<size_t> m_steps;
+  Vector<double> m_values;
+  Vector<size_t> m_head;
+  Vector<size_t> m_count;
+
+protected:
+  ExtremumObserverNode(Option<String> id,
+                       SharedPtr<StrategyBufferOpNode> parent,
+                       AssetObserverType observer_type, size_t window,
+                       bool is_max) noexcept;
+
+public:
+  ATLAS_API virtual ~ExtremumObserverNode() noexcept;
+
+  /// <summary>
+  /// Position of the current extreme in the window, 1 for the oldest
+  /// observation and window for the newest. Ties resolve to the oldest.
+  /// NaN if the window holds no valid observation.
+  /// </summary>
+  [[nodiscard]] double extremumPosition(size_t asset) const noexcept;
+
+  void onOutOfRange(
+      LinAlg::EigenRef<LinAlg::EigenVectorXd> buffer_old) noexcept override {}
+  void cacheObserver() noexcept override;
+  void reset() noexcept override;
+};
+
+//============================================================================
+class MaxObserverNode final : public ExtremumObserverNode {
 public:
   ATLAS_API MaxObserverNode(Option<String> id,
                             SharedPtr<StrategyBufferOpNode> parent,
                             size_t window) noexcept;
   ATLAS_API ~MaxObserverNode() noexcept;
+};
+
+//============================================================================
+class MinObserverNode final : public ExtremumObserverNode {
+public:
+  ATLAS_API MinObserverNode(Option<String> id,
+                            SharedPtr<StrategyBufferOpNode> parent,
+                            size_t window) noexcept;
+  ATLAS_API ~MinObserverNode() noexcept;
+};
+
+//============================================================================
+/// <summary>
+/// Rolling position of the max or min in the window, read from the deque of
+/// a shared extremum observer over the same parent and window
+/// </summary>
+class TsArgExtremumObserverNode : public AssetObserverNode {
+private:
+  SharedPtr<ExtremumObserverNode> m_extremum_observer;
+
+protected:
+  TsArgExtremumObserverNode(Option<String> id,
+                            SharedPtr<StrategyBufferOpNode> parent,
+                            AssetObserverType observer_type, size_t window,
+                            bool is_max) noexcept;
+
+public:
+  ATLAS_API virtual ~TsArgExtremumObserverNode() noexcept;
 
   void onOutOfRange(
-      LinAlg::EigenRef<LinAlg::EigenVectorXd> buffer_old) noexcept override;
+      LinAlg::EigenRef<LinAlg::EigenVectorXd> buffer_old) noexcept override {}
   void cacheObserver() noexcept override;
   void reset() noexcept override;
 };
 
 //============================================================================
-class TsArgMaxObserverNode final : public AssetObserverNode {
-private:
-  SharedPtr<MaxObserverNode> m_max_observer;
-
+class TsArgMaxObserverNode final : public TsArgExtremumObserverNode {
 public:
   ATLAS_API TsArgMaxObserverNode(Option<String> id,
                                  SharedPtr<StrategyBufferOpNode> parent,
                                  size_t window) noexcept;
   ATLAS_API ~TsArgMaxObserverNode() noexcept;
+};
 
-  void onOutOfRange(
-      LinAlg::EigenRef<LinAlg::EigenVectorXd> buffer_old) noexcept override;
-  void cacheObserver() noexcept override;
-  void reset() noexcept override;
+//============================================================================
+class TsArgMinObserverNode final : public TsArgExtremumObserverNode {
+public:
+  ATLAS_API TsArgMinObserverNode(Option<String> id,
+                                 SharedPtr<StrategyBufferOpNode> parent,
+                                 size_t window) noexcept;
+  ATLAS_API ~TsArgMinObserverNode() noexcept;
 };
 
 //============================================================================
@@ -112,6 +193,10 @@ public:
                                    size_t window) noexcept;
   ATLAS_API ~CovarianceObserverNode() noexcept;
 
+  [[nodiscard]] Vector<StrategyBufferOpNode const *>
+  getOtherParents() const noexcept override {
+    return {m_right_parent.get()};
+  }
   void onOutOfRange(
       LinAlg::EigenRef<LinAlg::EigenVectorXd> buffer_old) noexcept override;
   void cacheObserver() noexcept override;
@@ -132,6 +217,10 @@ public:
       SharedPtr<StrategyBufferOpNode> right_parent, size_t window) noexcept;
   ATLAS_API ~CorrelationObserverNode() noexcept;
 
+  [[nodiscard]] Vector<StrategyBufferOpNode const *>
+  getOtherParents() const noexcept override {
+    return {m_right_parent.get()};
+  }
   void onOutOfRange(
       LinAlg::EigenRef<LinAlg::EigenVectorXd> buffer_old) noexcept override;
   void cacheObserver() noexcept override;
@@ -158,10 +247,54 @@ public:
 };
 
 //============================================================================
+/// <summary>
+/// Rolling mean and central moment sums M2, M3 and M4 updated in O(1) per
+/// asset as observations enter and leave the window, using the pairwise
+/// update of Welford/Terriberry run forwards and backwards. The sums are
+/// recomputed exactly from the buffer once every window steps to bound
+/// drift and recover from NaN. The signal is the population variance.
+/// </summary>
+class CentralMomentObserverNode final : public AssetObserverNode {
+private:
+  size_t m_count = 0;
+  size_t m_exact_countdown = 0;
+  bool m_has_expired = false;
+  LinAlg::EigenVectorXd m_expired;
+  LinAlg::EigenVectorXd m_mean;
+  LinAlg::EigenVectorXd m_m2;
+  LinAlg::EigenVectorXd m_m3;
+  LinAlg::EigenVectorXd m_m4;
+  LinAlg::EigenVectorXd m_delta;
+  LinAlg::EigenVectorXd m_term;
+
+  void add(LinAlg::EigenRef<const LinAlg::EigenVectorXd> x) noexcept;
+  void remove(LinAlg::EigenRef<const LinAlg::EigenVectorXd> x) noexcept;
+  void recompute() noexcept;
+
+public:
+  ATLAS_API CentralMomentObserverNode(Option<String> id,
+                                      SharedPtr<StrategyBufferOpNode> parent,
+                                      size_t window) noexcept;
+  ATLAS_API ~CentralMomentObserverNode() noexcept;
+
+  [[nodiscard]] size_t count() const noexcept { return m_count; }
+  [[nodiscard]] auto const &m2() const noexcept { return m_m2; }
+  [[nodiscard]] auto const &m3() const noexcept { return m_m3; }
+  [[nodiscard]] auto const &m4() const noexcept { return m_m4; }
+
+  void onOutOfRange(
+      LinAlg::EigenRef<LinAlg::EigenVectorXd> buffer_old) noexcept override;
+  void cacheObserver() noexcept override;
+  void reset() noexcept override;
+};
+
+//============================================================================
+/// <summary>
+/// Fisher-Pearson coefficient of skewness of the window
+/// </summary>
 class SkewnessObserverNode final : public AssetObserverNode {
 private:
-  SharedPtr<MeanObserverNode> m_mean_observer;
-  SharedPtr<VarianceObserverNode> m_var_observer;
+  SharedPtr<CentralMomentObserverNode> m_moment_observer;
 
 public:
   ATLAS_API SkewnessObserverNode(Option<String> id,
@@ -170,7 +303,459 @@ public:
   ATLAS_API ~SkewnessObserverNode() noexcept;
 
   void onOutOfRange(
-			LinAlg::EigenRef<LinAlg::EigenVectorXd> buffer_old) noexcept override;
+      LinAlg::EigenRef<LinAlg::EigenVectorXd> buffer_old) noexcept override;
+  void cacheObserver() noexcept override;
+  void reset() noexcept override;
+};
+
+//============================================================================
+/// <summary>
+/// Excess kurtosis (Fisher, biased) of the window
+/// </summary>
+class KurtosisObserverNode final : public AssetObserverNode {
+private:
+  SharedPtr<CentralMomentObserverNode> m_moment_observer;
+
+public:
+  ATLAS_API KurtosisObserverNode(Option<String> id,
+                                 SharedPtr<StrategyBufferOpNode> parent,
+                                 size_t window) noexcept;
+  ATLAS_API ~KurtosisObserverNode() noexcept;
+
+  void onOutOfRange(
+      LinAlg::EigenRef<LinAlg::EigenVectorXd> buffer_old) noexcept override;
+  void cacheObserver() noexcept override;
+  void reset() noexcept override;
+};
+
+//============================================================================
+/// <summary>
+/// Multiset of doubles with rank queries, a treap keyed by value with
+/// subtree sizes. Nodes live in a pool preallocated to the capacity so
+/// inserts and erases never allocate, all operations are O(log n) expected.
+/// </summary>
+class OrderStatisticTree {
+private:
+  struct Node {
+    double value;
+    Uint32 priority;
+    Int32 left;
+    Int32 right;
+    Uint32 size;
+  };
+  Vector<Node> m_nodes;
+  Vector<Int32> m_free;
+  Int32 m_root = -1;
+  Uint32 m_seed = 2463534242u;
+
+  [[nodiscard]] Uint32 size(Int32 t) const noexcept {
+    return t < 0 ? 0 : m_nodes[t].size;
+  }
+  void update(Int32 t) noexcept;
+  void split(Int32 t, double value, bool inclusive, Int32 &left,
+             Int32 &right) noexcept;
+  [[nodiscard]] Int32 merge(Int32 left, Int32 right) noexcept;
+
+public:
+  OrderStatisticTree(size_t capacity) noexcept;
+
+  void insert(double value) noexcept;
+  bool erase(double value) noexcept;
+  void clear() noexcept;
+
+  /// <summary>
+  /// k-th smallest value, 0 based, k must be less than size()
+  /// </summary>
+  [[nodiscard]] double kth(size_t k) const noexcept;
+  [[nodiscard]] size_t countLess(double value) const noexcept;
+  [[nodiscard]] size_t countLessEqual(double value) const noexcept;
+  [[nodiscard]] size_t size() const noexcept { return size(m_root); }
+};
+
+//============================================================================
+/// <summary>
+/// Base of observers over the sorted window. Each asset keeps an order
+/// statistic tree of the non NaN observations in the window, updated in
+/// O(log window) as observations enter and leave.
+/// </summary>
+class OrderStatisticObserverNode : public AssetObserverNode {
+private:
+  size_t m_count = 0;
+
+protected:
+  Vector<OrderStatisticTree> m_trees;
+
+  OrderStatisticObserverNode(Option<String> id,
+                             SharedPtr<StrategyBufferOpNode> parent,
+                             AssetObserverType observer_type,
+                             size_t window) noexcept;
+
+  /// <summary>
+  /// Insert the current observation into the trees, called by derived
+  /// cacheObserver before reading from them
+  /// </summary>
+  void insertObservation() noexcept;
+
+  /// <summary>
+  /// Quantile of the asset's window with linear interpolation between the
+  /// closest ranks, NaN if the window holds no valid observation
+  /// </summary>
+  [[nodiscard]] double quantile(size_t asset, double q) const noexcept;
+
+public:
+  ATLAS_API virtual ~OrderStatisticObserverNode() noexcept;
+
+  void onOutOfRange(
+      LinAlg::EigenRef<LinAlg::EigenVectorXd> buffer_old) noexcept override;
+  void reset() noexcept override;
+};
+
+//============================================================================
+class QuantileObserverNode final : public OrderStatisticObserverNode {
+private:
+  double m_quantile;
+
+public:
+  ATLAS_API QuantileObserverNode(Option<String> id,
+                                 SharedPtr<StrategyBufferOpNode> parent,
+                                 size_t window, double quantile) noexcept;
+  ATLAS_API ~QuantileObserverNode() noexcept;
+
+  [[nodiscard]] Vector<double> getObserverParams() const noexcept override {
+    return {m_quantile};
+  }
+  void cacheObserver() noexcept override;
+};
+
+//============================================================================
+class MedianObserverNode final : public OrderStatisticObserverNode {
+public:
+  ATLAS_API MedianObserverNode(Option<String> id,
+                               SharedPtr<StrategyBufferOpNode> parent,
+                               size_t window) noexcept;
+  ATLAS_API ~MedianObserverNode() noexcept;
+
+  void cacheObserver() noexcept override;
+};
+
+//============================================================================
+/// <summary>
+/// Percentile rank of the newest observation within the window, ties take
+/// their average rank. 1 when the newest observation is the window max.
+/// </summary>
+class TsRankObserverNode final : public OrderStatisticObserverNode {
+public:
+  ATLAS_API TsRankObserverNode(Option<String> id,
+                               SharedPtr<StrategyBufferOpNode> parent,
+                               size_t window) noexcept;
+  ATLAS_API ~TsRankObserverNode() noexcept;
+
+  void cacheObserver() noexcept override;
+};
+
+//============================================================================
+/// <summary>
+/// Base of the exponentially weighted observers. The recursive (unadjusted)
+/// weighting needs no history, so the observers run with a single column
+/// buffer and O(assets) state. The decay is given as a span, alpha =
+/// 2 / (span + 1), a half life, alpha = 1 - exp(-ln 2 / half_life), or a
+/// Wilder period, alpha = 1 / period. Assets start from their first non NaN
+/// observation and NaN observations leave the state unchanged.
+/// </summary>
+class EWMAObserverNodeBase : public AssetObserverNode {
+protected:
+  double m_alpha;
+
+  EWMAObserverNodeBase(Option<String> id,
+                       SharedPtr<StrategyBufferOpNode> parent,
+                       AssetObserverType observer_type, double param,
+                       EWMAParamType param_type) noexcept;
+
+public:
+  ATLAS_API virtual ~EWMAObserverNodeBase() noexcept;
+
+  [[nodiscard]] static double toAlpha(double param,
+                                      EWMAParamType param_type) noexcept;
+
+  /// <summary>
+  /// One step of the exponential smoother for every asset, shared by the
+  /// EWMA observers and the indicator nodes
+  /// </summary>
+  static void smooth(LinAlg::EigenRef<LinAlg::EigenVectorXd> state,
+                     LinAlg::EigenRef<const LinAlg::EigenVectorXd> observation,
+                     double alpha) noexcept;
+  [[nodiscard]] double getAlpha() const noexcept { return m_alpha; }
+  [[nodiscard]] Vector<double> getObserverParams() const noexcept override {
+    return {m_alpha};
+  }
+  void onOutOfRange(
+      LinAlg::EigenRef<LinAlg::EigenVectorXd> buffer_old) noexcept override {}
+};
+
+//============================================================================
+class EWMAMeanObserverNode final : public EWMAObserverNodeBase {
+public:
+  ATLAS_API EWMAMeanObserverNode(
+      Option<String> id, SharedPtr<StrategyBufferOpNode> parent, double param,
+      EWMAParamType param_type = EWMAParamType::SPAN) noexcept;
+  ATLAS_API ~EWMAMeanObserverNode() noexcept;
+
+  void cacheObserver() noexcept override;
+  void reset() noexcept override;
+};
+
+//============================================================================
+/// <summary>
+/// Exponentially weighted (biased) variance, updated with the mean by
+/// West's recursion var = (1 - alpha) * (var + alpha * (x - mean)^2)
+/// </summary>
+class EWMAVarianceObserverNode final : public EWMAObserverNodeBase {
+private:
+  LinAlg::EigenVectorXd m_mean;
+
+public:
+  ATLAS_API EWMAVarianceObserverNode(
+      Option<String> id, SharedPtr<StrategyBufferOpNode> parent, double param,
+      EWMAParamType param_type = EWMAParamType::SPAN) noexcept;
+  ATLAS_API ~EWMAVarianceObserverNode() noexcept;
+
+  [[nodiscard]] auto const &mean() const noexcept { return m_mean; }
+  void cacheObserver() noexcept override;
+  void reset() noexcept override;
+};
+
+//============================================================================
+class EWMAVolatilityObserverNode final : public EWMAObserverNodeBase {
+private:
+  SharedPtr<EWMAVarianceObserverNode> m_var_observer;
+
+public:
+  ATLAS_API EWMAVolatilityObserverNode(
+      Option<String> id, SharedPtr<StrategyBufferOpNode> parent, double param,
+      EWMAParamType param_type = EWMAParamType::SPAN) noexcept;
+  ATLAS_API ~EWMAVolatilityObserverNode() noexcept;
+
+  void cacheObserver() noexcept override;
+  void reset() noexcept override;
+};
+
+//============================================================================
+/// <summary>
+/// Distance of the observation from its exponentially weighted mean in
+/// units of the exponentially weighted volatility
+/// </summary>
+class EWMAZScoreObserverNode final : public EWMAObserverNodeBase {
+private:
+  SharedPtr<EWMAVarianceObserverNode> m_var_observer;
+
+public:
+  ATLAS_API EWMAZScoreObserverNode(
+      Option<String> id, SharedPtr<StrategyBufferOpNode> parent, double param,
+      EWMAParamType param_type = EWMAParamType::SPAN) noexcept;
+  ATLAS_API ~EWMAZScoreObserverNode() noexcept;
+
+  void cacheObserver() noexcept override;
+  void reset() noexcept override;
+};
+
+//============================================================================
+/// <summary>
+/// Exponentially weighted covariance of each asset's left observation with
+/// its right observation, or with the right observation of a single
+/// benchmark asset broadcast to every asset
+/// </summary>
+class EWMACovarianceObserverNode final : public EWMAObserverNodeBase {
+private:
+  SharedPtr<StrategyBufferOpNode> m_right_parent;
+  Option<size_t> m_benchmark_asset;
+  LinAlg::EigenVectorXd m_right_buffer;
+  LinAlg::EigenVectorXd m_left_mean;
+  LinAlg::EigenVectorXd m_right_mean;
+
+public:
+  ATLAS_API EWMACovarianceObserverNode(
+      Option<String> id, SharedPtr<StrategyBufferOpNode> left_parent,
+      SharedPtr<StrategyBufferOpNode> right_parent, double param,
+      EWMAParamType param_type = EWMAParamType::SPAN,
+      Option<size_t> benchmark_asset = std::nullopt) noexcept;
+  ATLAS_API ~EWMACovarianceObserverNode() noexcept;
+
+  [[nodiscard]] Vector<double> getObserverParams() const noexcept override;
+  [[nodiscard]] Vector<StrategyBufferOpNode const *>
+  getOtherParents() const noexcept override {
+    return {m_right_parent.get()};
+  }
+  void cacheObserver() noexcept override;
+  void reset() noexcept override;
+};
+
+//============================================================================
+/// <summary>
+/// Running prefix sums and sums of squares of the parent over the largest
+/// window of a sweep. Any window up to the largest is answered in O(1) as a
+/// difference of two prefix columns, so the windows of a grid dimension share
+/// one observer. The prefix ring is rebased every max_window + 1 steps to keep
+/// the sums from growing without bound. The observer's own signal is the sum
+/// over the largest window.
+/// </summary>
+class MultiWindowObserverNode final : public AssetObserverNode {
+private:
+  LinAlg::EigenMatrixXd m_prefix;
+  LinAlg::EigenMatrixXd m_prefix_squared;
+  size_t m_head = 0;
+  size_t m_count = 1;
+  size_t m_step = 0;
+
+  [[nodiscard]] size_t prefixColumn(size_t window) const noexcept;
+
+public:
+  ATLAS_API MultiWindowObserverNode(Option<String> id,
+                                    SharedPtr<StrategyBufferOpNode> parent,
+                                    size_t max_window) noexcept;
+  ATLAS_API ~MultiWindowObserverNode() noexcept;
+
+  /// <summary>
+  /// Rolling sum, mean or population variance of the parent over window
+  /// observations, window must not exceed the observer's window
+  /// </summary>
+  void windowStatistic(AssetObserverType statistic, size_t window,
+                       LinAlg::EigenRef<LinAlg::EigenVectorXd> target) noexcept;
+
+  [[nodiscard]] size_t refreshWarmup() noexcept override { return getWarmup(); }
+  void onOutOfRange(
+      LinAlg::EigenRef<LinAlg::EigenVectorXd> buffer_old) noexcept override {}
+  void cacheObserver() noexcept override;
+  void reset() noexcept override;
+};
+
+//============================================================================
+/// <summary>
+/// Sum, mean or variance over one window read from a shared multi window
+/// observer. Holds no state of its own, so sweeping the window of a grid
+/// dimension swaps these in place of separate observers.
+/// </summary>
+class WindowViewNode final : public StrategyBufferOpNode {
+private:
+  SharedPtr<MultiWindowObserverNode> m_observer;
+  AssetObserverType m_statistic;
+  size_t m_window;
+  size_t m_warmup;
+
+public:
+  ATLAS_API WindowViewNode(SharedPtr<MultiWindowObserverNode> observer,
+                           size_t window,
+                           AssetObserverType statistic) noexcept;
+  ATLAS_API ~WindowViewNode() noexcept;
+
+  ATLAS_API static SharedPtr<WindowViewNode>
+  make(SharedPtr<MultiWindowObserverNode> observer, size_t window,
+       AssetObserverType statistic) noexcept;
+
+  [[nodiscard]] size_t getWarmup() const noexcept override { return m_warmup; }
+  [[nodiscard]] size_t refreshWarmup() noexcept override { return m_warmup; }
+  [[nodiscard]] bool
+  isSame(StrategyBufferOpNode const *other) const noexcept override;
+  [[nodiscard]] size_t window() const noexcept { return m_window; }
+  void evaluate(LinAlg::EigenRef<LinAlg::EigenVectorXd> target) noexcept override;
+  void reset() noexcept override {}
+};
+
+//============================================================================
+/// <summary>
+/// Rolling least squares regression of each asset (y) on a benchmark (x)
+/// from running sums of x, y, xy, x^2 and y^2 per asset. The benchmark is
+/// either the same lane of the right parent or one benchmark asset of it
+/// broadcast to every asset. The node emits beta, alpha, the (population)
+/// residual volatility or R^2; every output of the same regression reads the
+/// sums from one shared BETA node, which recomputes them exactly once per
+/// window to bound the rounding drift of the rolling updates.
+/// </summary>
+class RollingRegressionObserverNode final : public AssetObserverNode {
+private:
+  SharedPtr<StrategyBufferOpNode> m_right_parent;
+  Option<size_t> m_benchmark_asset;
+  RegressionOutputType m_output;
+  SharedPtr<RollingRegressionObserverNode> m_source;
+  LinAlg::EigenVectorXd m_right_buffer;
+  LinAlg::EigenMatrixXd m_right_history;
+  LinAlg::EigenVectorXd m_sum_x;
+  LinAlg::EigenVectorXd m_sum_y;
+  LinAlg::EigenVectorXd m_sum_xy;
+  LinAlg::EigenVectorXd m_sum_xx;
+  LinAlg::EigenVectorXd m_sum_yy;
+  LinAlg::EigenMatrixXd m_outputs;
+  size_t m_right_head = 0;
+  size_t m_count = 0;
+  size_t m_step = 0;
+
+  [[nodiscard]] LinAlg::EigenRef<LinAlg::EigenVectorXd>
+  rightHistory(size_t lag) noexcept;
+  void recompute() noexcept;
+  void updateOutputs() noexcept;
+
+public:
+  ATLAS_API RollingRegressionObserverNode(
+      Option<String> id, SharedPtr<StrategyBufferOpNode> parent,
+      SharedPtr<StrategyBufferOpNode> benchmark, size_t window,
+      RegressionOutputType output = RegressionOutputType::BETA,
+      Option<size_t> benchmark_asset = std::nullopt) noexcept;
+  ATLAS_API ~RollingRegressionObserverNode() noexcept;
+
+  /// <summary>
+  /// Output of the regression as of the current step
+  /// </summary>
+  [[nodiscard]] auto output(RegressionOutputType output) const noexcept {
+    return m_outputs.col(static_cast<size_t>(output));
+  }
+
+  [[nodiscard]] Vector<double> getObserverParams() const noexcept override;
+  [[nodiscard]] Vector<StrategyBufferOpNode const *>
+  getOtherParents() const noexcept override {
+    return {m_right_parent.get()};
+  }
+  void onOutOfRange(
+      LinAlg::EigenRef<LinAlg::EigenVectorXd> buffer_old) noexcept override;
+  void cacheObserver() noexcept override;
+  void reset() noexcept override;
+};
+
+//============================================================================
+/// <summary>
+/// Local level or local trend Kalman filter run for every asset at once. The
+/// state and its covariance are held per asset in flat vectors (level, slope
+/// and the three distinct entries of the symmetric covariance), so a step is
+/// one vectorized predict and update over all assets. An asset starts from
+/// its first non NaN observation and NaN observations skip the update,
+/// leaving the predicted state. Runs with a single column buffer as the
+/// filter needs no history.
+/// </summary>
+class KalmanFilterObserverNode final : public AssetObserverNode {
+private:
+  KalmanModelType m_model;
+  KalmanOutputType m_output;
+  double m_process_noise;
+  double m_observation_noise;
+  double m_slope_noise;
+  LinAlg::EigenVectorXd m_level;
+  LinAlg::EigenVectorXd m_slope;
+  LinAlg::EigenVectorXd m_p00;
+  LinAlg::EigenVectorXd m_p01;
+  LinAlg::EigenVectorXd m_p11;
+  LinAlg::EigenVectorXd m_gain;
+  LinAlg::EigenVectorXd m_slope_gain;
+  LinAlg::EigenVectorXd m_innovation;
+
+public:
+  ATLAS_API KalmanFilterObserverNode(
+      Option<String> id, SharedPtr<StrategyBufferOpNode> parent,
+      KalmanModelType model, double process_noise, double observation_noise,
+      double slope_noise = 0.0,
+      KalmanOutputType output = KalmanOutputType::LEVEL) noexcept;
+  ATLAS_API ~KalmanFilterObserverNode() noexcept;
+
+  [[nodiscard]] Vector<double> getObserverParams() const noexcept override;
+  void onOutOfRange(
+      LinAlg::EigenRef<LinAlg::EigenVectorXd> buffer_old) noexcept override {}
   void cacheObserver() noexcept override;
   void reset() noexcept override;
 };
@@ -1,11 +1,68 @@
 #include "exchange/Exchange.hpp"
 #include "ast/AssetNode.hpp"
 #include "ast/ObserverNode.hpp"
+#include "ast/ASTOptimizer.hpp"
 
 namespace Atlas {
 
 namespace AST {
 
+//============================================================================
+ObserverHistory::ObserverHistory(size_t asset_count, size_t capacity) noexcept {
+  m_ring.resize(asset_count, std::max<size_t>(capacity, 1));
+  m_ring.setZero();
+}
+
+//============================================================================
+void ObserverHistory::reserve(size_t capacity) noexcept {
+  if (capacity <= this->capacity()) {
+    return;
+  }
+  // lay the observations kept out oldest first from column 0
+  LinAlg::EigenMatrixXd ring(m_ring.rows(), capacity);
+  ring.setZero();
+  size_t kept = std::min(m_count, this->capacity());
+  for (size_t lag = 0; lag < kept; lag++) {
+    ring.col(kept - 1 - lag) = column(lag);
+  }
+  m_ring = std::move(ring);
+  m_head = kept ? kept - 1 : 0;
+  m_count = kept;
+}
+
+//============================================================================
+void ObserverHistory::observe(size_t idx,
+                              StrategyBufferOpNode &parent) noexcept {
+  if (m_last_idx == idx) {
+    return;
+  }
+  m_last_idx = idx;
+  if (m_count) {
+    m_head = (m_head + 1) % capacity();
+  }
+  m_count++;
+  auto target = m_ring.col(m_head);
+  auto observation = parent.read(target);
+  if (observation.data() != target.data()) {
+    target = observation;
+  }
+}
+
+//============================================================================
+LinAlg::EigenRef<LinAlg::EigenVectorXd>
+ObserverHistory::column(size_t lag) noexcept {
+  assert(lag < capacity());
+  return m_ring.col((m_head + capacity() - lag) % capacity());
+}
+
+//============================================================================
+void ObserverHistory::reset() noexcept {
+  m_ring.setZero();
+  m_head = 0;
+  m_count = 0;
+  m_last_idx = std::nullopt;
+}
+
 //============================================================================
 AssetObserverNode::AssetObserverNode(Option<String> name,
                                      SharedPtr<StrategyBufferOpNode> parent,
@@ -15,8 +72,9 @@ AssetObserverNode::AssetObserverNode(Option<String> name,
                            parent.get()),
       m_parent(parent), m_window(window), m_warmup(window), m_id(name),
       m_observer_warmup(window), m_observer_type(observer_type) {
-  m_buffer_matrix.resize(m_exchange.getAssetCount(), window);
-  m_buffer_matrix.setZero();
+  addInput(m_parent);
+  m_history =
+      std::make_shared<ObserverHistory>(m_exchange.getAssetCount(), window);
   m_signal.resize(m_exchange.getAssetCount());
   m_signal.setZero();
   m_signal_copy.resize(m_exchange.getAssetCount());
@@ -27,15 +85,22 @@ AssetObserverNode::AssetObserverNode(Option<String> name,
 AssetObserverNode::~AssetObserverNode() noexcept {}
 
 //============================================================================
-void AssetObserverNode::setObserverBuffer(double c) noexcept {
-  m_buffer_matrix.setConstant(c);
+void AssetObserverNode::resetBase() noexcept {
+  m_history->reset();
+  m_observed = 0;
+  reset();
 }
 
 //============================================================================
-void AssetObserverNode::resetBase() noexcept {
-  m_buffer_matrix.setZero();
-  m_buffer_idx = 0;
-  reset();
+void AssetObserverNode::shareHistory(AssetObserverNode &other) noexcept {
+  assert(other.m_parent == m_parent);
+  other.m_history->reserve(m_window);
+  m_history = other.m_history;
+}
+
+//============================================================================
+void AssetObserverNode::optimize(ASTOptimizer &optimizer) noexcept {
+  optimizer.visit(*this, m_parent);
 }
 
 //============================================================================
@@ -43,20 +108,19 @@ void AssetObserverNode::cacheBase() noexcept {
   if (m_exchange.currentIdx() < m_observer_warmup) {
     return;
   }
-  auto buffer_ref = buffer();
-  m_parent->evaluate(buffer_ref);
+  // the parent is read once per step however many observers share it
+  m_history->observe(m_exchange.currentIdx(), *m_parent);
 
   cacheObserver();
 
-  if (hasCache() && m_exchange.currentIdx() >= (m_window - 1))
-    cacheColumn() = m_signal;
-
-  m_buffer_idx = (m_buffer_idx + 1) % m_window;
+  if (m_exchange.currentIdx() >= (m_window - 1))
+    cacheOutput(m_signal);
 
   m_signal_copy = m_signal;
 
-  if (m_exchange.currentIdx() >= (m_window - 1))
-    onOutOfRange(m_buffer_matrix.col(m_buffer_idx));
+  m_observed++;
+  if (m_observed >= m_window)
+    onOutOfRange(m_history->column(m_window - 1));
 }
 
 //============================================================================
@@ -69,14 +133,23 @@ bool AssetObserverNode::isSame(
 		return false;
   if (ptr->window() != window())
     return false;
+  if (ptr->getObserverParams() != getObserverParams())
+    return false;
+  if (ptr->getOtherParents() != getOtherParents())
+    return false;
   return sameParents(other->getParents());
 }
 
 //============================================================================
 LinAlg::EigenRef<LinAlg::EigenVectorXd> AssetObserverNode::buffer() noexcept {
-  size_t col = 0;
-  assert(m_buffer_idx < static_cast<size_t>(m_buffer_matrix.cols()));
-  return m_buffer_matrix.col(m_buffer_idx);
+  return m_history->column(0);
+}
+
+//============================================================================
+LinAlg::EigenRef<LinAlg::EigenVectorXd>
+AssetObserverNode::history(size_t lag) noexcept {
+  assert(lag < m_window);
+  return m_history->column(lag);
 }
 
 //============================================================================
@@ -86,6 +159,12 @@ void AssetObserverNode::evaluate(
   target = m_signal_copy;
 }
 
+//============================================================================
+Option<LinAlg::EigenRef<const LinAlg::EigenVectorXd>>
+AssetObserverNode::view() noexcept {
+  return m_signal_copy;
+}
+
 } // namespace AST
 
 } // namespace Atlas
\ No newline at end of file
@@ -29,6 +29,68 @@ enum class AssetObserverType : Uint8 {
   CORRELATION = 7,
   LINEAR_DECAY = 8,
   SKEWNESS = 9,
+  MIN = 10,
+  TS_ARGMIN = 11,
+  CENTRAL_MOMENT = 12,
+  KURTOSIS = 13,
+  QUANTILE = 14,
+  MEDIAN = 15,
+  TS_RANK = 16,
+  EWMA_MEAN = 17,
+  EWMA_VARIANCE = 18,
+  EWMA_VOLATILITY = 19,
+  EWMA_COVARIANCE = 20,
+  EWMA_ZSCORE = 21,
+  MULTI_WINDOW = 22,
+  ROLLING_REGRESSION = 23,
+  KALMAN_FILTER = 24,
+  TRUE_RANGE = 25,
+  RSI = 26,
+  MACD = 27,
+  BOLLINGER = 28,
+  STOCHASTIC = 29,
+  ADX = 30,
+};
+
+//============================================================================
+/// <summary>
+/// Ring of the most recent values of a parent node, shared by every
+/// registered observer of that parent. The parent is read into the ring
+/// once per exchange step and the ring holds as many columns as the longest
+/// window observing it.
+/// </summary>
+class ObserverHistory {
+private:
+  LinAlg::EigenMatrixXd m_ring;
+  size_t m_head = 0;
+  size_t m_count = 0;
+  Option<size_t> m_last_idx = std::nullopt;
+
+public:
+  ObserverHistory(size_t asset_count, size_t capacity) noexcept;
+
+  /// <summary>
+  /// Grow the ring to hold at least capacity columns, keeping the values
+  /// already observed
+  /// </summary>
+  void reserve(size_t capacity) noexcept;
+
+  /// <summary>
+  /// Read the parent into the ring for the exchange index, a no op if the
+  /// index was already observed by another observer
+  /// </summary>
+  void observe(size_t idx, StrategyBufferOpNode &parent) noexcept;
+
+  /// <summary>
+  /// Value of the parent lag observations ago, 0 for the current step
+  /// </summary>
+  [[nodiscard]] LinAlg::EigenRef<LinAlg::EigenVectorXd>
+  column(size_t lag) noexcept;
+
+  [[nodiscard]] size_t capacity() const noexcept {
+    return static_cast<size_t>(m_ring.cols());
+  }
+  void reset() noexcept;
 };
 
 //============================================================================
@@ -58,18 +120,18 @@ private:
   size_t m_window = 0;
 
   /// <summary>
-  /// Buffer matrix holding previous observations of the observer.
+  /// History of the observed parent. Starts private to the observer and is
+  /// replaced by the ring shared with the other observers of the same parent
+  /// when the exchange registers it.
   /// </summary>
-  LinAlg::EigenMatrixXd m_buffer_matrix;
+  SharedPtr<ObserverHistory> m_history;
 
   /// <summary>
-  ///	Current index into the buffer to write to. On cacheObserver, the
-  ///m_buffer_idx - 1
-  /// column is overwritten with the new observation. Then onOutOfRange is
-  /// called on m_buffer_idx to update the observer with the column that is
-  /// about to be overwritten in the next step
+  /// Number of observations made since the last reset. Once it reaches the
+  /// window, onOutOfRange is called after every cacheObserver with the
+  /// oldest observation in the window, which leaves it on the next step.
   /// </summary>
-  size_t m_buffer_idx = 0;
+  size_t m_observed = 0;
 
   SharedPtr<StrategyBufferOpNode> parent() const noexcept { return m_parent; }
 
@@ -79,10 +141,32 @@ protected:
 
   void setObserverWarmup(size_t warmup) noexcept { m_observer_warmup = warmup; }
   void setWarmup(size_t warmup) noexcept { m_warmup = warmup; }
-  void setObserverBuffer(double c) noexcept;
-  [[nodiscard]] size_t getBufferIdx() const noexcept { return m_buffer_idx; }
   [[nodiscard]] size_t getWindow() const noexcept { return m_window; }
 
+  /// <summary>
+  /// Observation made lag steps ago, lag must be less than the window
+  /// </summary>
+  [[nodiscard]] LinAlg::EigenRef<LinAlg::EigenVectorXd>
+  history(size_t lag) noexcept;
+
+  /// <summary>
+  /// Parameters beyond the window that change the observer's output, two
+  /// observers are only the same if their parameters match
+  /// </summary>
+  [[nodiscard]] virtual Vector<double> getObserverParams() const noexcept {
+    return {};
+  }
+
+  /// <summary>
+  /// Observed inputs beyond the first parent, such as the right side of a
+  /// pair or the high and low of a bar, compared in isSame as the base only
+  /// records the first parent
+  /// </summary>
+  [[nodiscard]] virtual Vector<StrategyBufferOpNode const *>
+  getOtherParents() const noexcept {
+    return {};
+  }
+
 public:
   AssetObserverNode(Option<String> name, SharedPtr<StrategyBufferOpNode> parent,
                     AssetObserverType observer_type, size_t window) noexcept;
@@ -91,15 +175,23 @@ public:
   SharedPtr<StrategyBufferOpNode> m_parent;
   AssetObserverType m_observer_type;
 
-  [[nodiscard]] auto const &getBufferMatrix() const noexcept {
-    return m_buffer_matrix;
-  }
-
   /// <summary>
-  /// Zero out the buffer matrix and call reset on derived implementations
+  /// Clear the history and call reset on derived implementations
   /// </summary>
   void resetBase() noexcept;
 
+  /// <summary>
+  /// Read the parent's history from the ring of another observer of the
+  /// same parent, growing it to this observer's window
+  /// </summary>
+  void shareHistory(AssetObserverNode &other) noexcept;
+
+  /// <summary>
+  /// Visit the observed parent node, observers consume the parent through the
+  /// buffer matrix so the parent slot can be rewritten like any other input
+  /// </summary>
+  void optimize(ASTOptimizer &optimizer) noexcept override;
+
   /// <summary>
   /// On exchange step method is called to update the observer with the new
   /// observation
@@ -116,7 +208,7 @@ public:
   auto const &getSignalCopy() const noexcept { return m_signal_copy; }
 
   /// <summary>
-  /// Get a mutable ref into the observers buffer matrix at the current index
+  /// Get a ref to the current observation of the parent
   /// </summary>
   /// <returns></returns>
   LinAlg::EigenRef<LinAlg::EigenVectorXd> buffer() noexcept;
@@ -148,6 +240,12 @@ public:
   virtual void evaluate(
       LinAlg::EigenRef<LinAlg::EigenVectorXd> target) noexcept final override;
 
+  /// <summary>
+  /// Borrow the signal copy directly instead of copying it into a target
+  /// </summary>
+  Option<LinAlg::EigenRef<const LinAlg::EigenVectorXd>>
+  view() noexcept final override;
+
   [[nodiscard]] auto const &getId() const noexcept { return m_id; }
   [[nodiscard]] size_t getWarmup() const noexcept final override {
     return m_warmup;
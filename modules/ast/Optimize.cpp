@@ -1,8 +1,10 @@
 #include <omp.h>
+#include "AtlasMacros.hpp"
 #include "exchange/Exchange.hpp"
 #include "strategy/Tracer.hpp"
 #include "strategy/Strategy.hpp"
 #include "ast/ObserverNodeBase.hpp"
+#include "ast/ObserverNode.hpp"
 #include "ast/Optimize.hpp"
 
 namespace Atlas {
@@ -47,7 +49,7 @@ GridDimensionLimit::make(const String &name,
 
 //============================================================================
 StrategyGrid::StrategyGrid(
-    Strategy *strategy, Exchange const &exchange,
+    Strategy *strategy, Exchange &exchange,
     std::pair<SharedPtr<GridDimension>, SharedPtr<GridDimension>> dimensions,
     Option<GridType> grid_type) noexcept
     : m_strategy(strategy), m_exchange(exchange), m_dimensions(dimensions),
@@ -81,7 +83,17 @@ StrategyGrid::StrategyGrid(
 
   m_weights_grid = new double[row_count * col_count * depth];
   memset(m_weights_grid, 0, row_count * col_count * depth * sizeof(double));
-  buildNodeGrid();
+}
+
+//============================================================================
+Result<SharedPtr<StrategyGrid>, AtlasException> StrategyGrid::make(
+    Strategy *strategy, Exchange &exchange,
+    std::pair<SharedPtr<GridDimension>, SharedPtr<GridDimension>> dimensions,
+    Option<GridType> grid_type) noexcept {
+  auto grid = std::make_shared<StrategyGrid>(strategy, exchange,
+                                             std::move(dimensions), grid_type);
+  ATLAS_ASSIGN_OR_RETURN(res, grid->buildNodeGrid());
+  return grid;
 }
 
 //============================================================================
@@ -103,65 +115,77 @@ void StrategyGrid::reset() noexcept {
   }
 }
 
+//============================================================================
+Result<bool, AtlasException>
+StrategyGrid::checkNodeDim(GridDimensionObserver const *observer_dim) noexcept {
+  switch (observer_dim->getObserverBase()->getObserverType()) {
+  case AssetObserverType::SUM:
+  case AssetObserverType::MEAN:
+  case AssetObserverType::VARIANCE:
+    return true;
+  default:
+    return Err("Observer grid dimension " + observer_dim->getName() +
+               " must be over a sum, mean or variance observer");
+  }
+}
+
 //============================================================================
 void StrategyGrid::builNodeDim(GridDimensionObserver *observer_dim) noexcept {
   size_t size = observer_dim->size();
   SharedPtr<AssetObserverNode> const &observer_node =
       observer_dim->getObserverBase();
-  auto id = observer_node->getId();
+  auto statistic = observer_node->getObserverType();
+
+  // every window of the dimension is read from one prefix sum observer over
+  // the largest window instead of a separate observer per window
+  auto const &windows = observer_dim->getValues();
+  size_t max_window = static_cast<size_t>(
+      *std::max_element(windows.begin(), windows.end()));
+  Option<String> node_id = std::nullopt;
+  if (observer_node->getId()) {
+    node_id = *observer_node->getId() + "_windows";
+  }
+  auto multi_window = std::make_shared<MultiWindowObserverNode>(
+      node_id, observer_node->parent(), max_window);
+  multi_window = std::static_pointer_cast<MultiWindowObserverNode>(
+      observer_node->getExchange().registerObserver(std::move(multi_window)));
   for (size_t i = 0; i < size; ++i) {
-    // auto node_id = std::format("{}_{}", id, i);
-    // switch (observer_node->observerType())
-    //{
-    // case AssetObserverType::SUM:
-    //{
-    //	SharedPtr<SumObserverNode> new_observer =
-    //std::make_shared<SumObserverNode>( 		node_id, 		observer_node->parent(),
-    //		static_cast<size_t>(observer_dim->get(i))
-    //	);
-    //	observer_dim->addObserver(std::move(new_observer), i);
-    //	break;
-    // }
-    // case AssetObserverType::MEAN:
-    //{
-    //	SharedPtr<MeanObserverNode> new_observer =
-    //std::make_shared<MeanObserverNode>( 		node_id, 		observer_node->parent(),
-    //		static_cast<size_t>(observer_dim->get(i))
-    //	);
-    //	observer_dim->addObserver(std::move(new_observer), i);
-    //	break;
-    // }
-    // default:
-    //	assert(false);
-    // }
+    auto window = static_cast<size_t>(observer_dim->get(i));
+    observer_dim->addObserver(
+        WindowViewNode::make(multi_window, window, statistic), i);
   }
 }
 
 //============================================================================
-void StrategyGrid::buildNodeGrid() noexcept {
+Result<bool, AtlasException> StrategyGrid::buildNodeGrid() noexcept {
   int dim_count = 0;
   if (m_dimensions.first->getType() == DimensionType::OBSERVER)
     ++dim_count;
   if (m_dimensions.second->getType() == DimensionType::OBSERVER)
     ++dim_count;
   if (!dim_count) {
-    return;
+    return true;
   }
   if (dim_count == 1) {
     auto observer_dim =
         m_dimensions.first->getType() == DimensionType::OBSERVER
             ? static_cast<GridDimensionObserver *>(m_dimensions.first.get())
             : static_cast<GridDimensionObserver *>(m_dimensions.second.get());
-    observer_dim->buildWarmup(m_strategy);
+    ATLAS_ASSIGN_OR_RETURN(res, checkNodeDim(observer_dim));
     builNodeDim(observer_dim);
+    observer_dim->buildWarmup(m_strategy);
   } else {
+    // both dimensions are checked before either registers its observers
     auto dim1 = static_cast<GridDimensionObserver *>(m_dimensions.first.get());
     auto dim2 = static_cast<GridDimensionObserver *>(m_dimensions.second.get());
-    builNodeDim(static_cast<GridDimensionObserver *>(dim1));
-    builNodeDim(static_cast<GridDimensionObserver *>(dim2));
+    ATLAS_ASSIGN_OR_RETURN(res1, checkNodeDim(dim1));
+    ATLAS_ASSIGN_OR_RETURN(res2, checkNodeDim(dim2));
+    builNodeDim(dim1);
+    builNodeDim(dim2);
     dim1->buildWarmup(m_strategy);
     dim2->buildWarmup(m_strategy);
   }
+  return true;
 }
 
 //============================================================================
@@ -218,6 +242,7 @@ void StrategyGrid::evaluateGrid() noexcept {
     }
 
     m_dimensions.first->set(i);
+    m_exchange.invalidateReads();
     for (size_t j = 0; j < col_count; ++j) {
       if (__observer_dim2 &&
           m_exchange.currentIdx() < __observer_dim2->m_warmup(j)) {
@@ -241,7 +266,10 @@ void StrategyGrid::evaluateGrid() noexcept {
         break;
       }
 
+      // the swapped nodes and parameters change the value of their consumers
+      // within the step, outputs reused from the previous cell are stale
       m_dimensions.second->set(j);
+      m_exchange.invalidateReads();
       evaluateChild(i, j);
 
       // swap the observer node back into the grid
@@ -256,6 +284,7 @@ void StrategyGrid::evaluateGrid() noexcept {
   // restore original value of the dimensions for the base strategy
   m_dimensions.first->reset();
   m_dimensions.second->reset();
+  m_exchange.invalidateReads();
   m_strategy->setTracer(tracer);
 }
 
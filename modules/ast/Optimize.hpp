@@ -187,7 +187,7 @@ class StrategyGrid
 	friend class Strategy;
 private:
 	Strategy* m_strategy;
-	Exchange const& m_exchange;
+	Exchange& m_exchange;
 	std::pair<SharedPtr<GridDimension>, SharedPtr<GridDimension>> m_dimensions;
 	LinAlg::EigenMatrix<SharedPtr<Tracer>> m_tracers;
 	double* m_weights_grid = nullptr;
@@ -200,7 +200,8 @@ private:
 	LinAlg::EigenMap<LinAlg::EigenVectorXd> getBuffer(size_t row, size_t col) noexcept;
 	size_t gridStart(size_t row, size_t col) const noexcept;
 	void reset() noexcept;
-	void buildNodeGrid() noexcept;
+	[[nodiscard]] Result<bool, AtlasException> buildNodeGrid() noexcept;
+	[[nodiscard]] static Result<bool, AtlasException> checkNodeDim(GridDimensionObserver const* dim) noexcept;
 	void builNodeDim(GridDimensionObserver* dim) noexcept;
 	void evaluate() noexcept;
 	void evaluateGrid() noexcept;
@@ -209,11 +210,22 @@ private:
 public:
 	StrategyGrid(
 		Strategy* strategy,
-		Exchange const& exchange,
+		Exchange& exchange,
 		std::pair<SharedPtr<GridDimension>, SharedPtr<GridDimension>> m_dimensions,
 		Option<GridType> grid_type = std::nullopt
 	) noexcept;
 
+	/// <summary>
+	/// Build a grid and the nodes of its observer dimensions, fails if an
+	/// observer dimension is over a statistic that can not be windowed
+	/// </summary>
+	[[nodiscard]] static Result<SharedPtr<StrategyGrid>, AtlasException> make(
+		Strategy* strategy,
+		Exchange& exchange,
+		std::pair<SharedPtr<GridDimension>, SharedPtr<GridDimension>> dimensions,
+		Option<GridType> grid_type = std::nullopt
+	) noexcept;
+
 	auto const& getTracers() const noexcept
 	{
 		return m_tracers;
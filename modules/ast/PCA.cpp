@@ -24,7 +24,7 @@ PCAModel::PCAModel(String id,
   m_last_index = std::numeric_limits<size_t>::max();
   m_warmup = 0;
   for (auto &feature : m_features) {
-    feature->addChild(this);
+    addInput(feature);
     m_warmup = std::max(m_warmup, feature->getWarmup());
   }
 }
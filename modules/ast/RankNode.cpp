@@ -1,77 +1,122 @@
+#include <array>
+#include <bit>
+
 #include "ast/RankNode.hpp"
 #include "ast/ExchangeNode.hpp"
+#include "ast/ASTOptimizer.hpp"
 
 namespace Atlas {
 
 namespace AST {
 
 //============================================================================
-EVRankNode::EVRankNode(SharedPtr<ExchangeViewNode> ev, EVRankType type,
-                       size_t count) noexcept
-    : StrategyBufferOpNode(NodeType::RANK_NODE, ev->getExchange(), ev.get()),
-      m_N(count), m_type(type), m_ev(std::move(ev)) {
-  size_t view_count = m_ev->getViewSize();
-  m_view.reserve(view_count);
-  for (size_t i = 0; i < view_count; ++i) {
-    m_view.push_back(std::make_pair(i, 0.0));
+size_t CrossSectionSelector::partition(
+    LinAlg::EigenRef<const LinAlg::EigenVectorXd> values) noexcept {
+  size_t n = static_cast<size_t>(values.size());
+  m_index.resize(n);
+  // branch free compaction, every index is written and the cursor only
+  // advances past the valid ones
+  size_t count = 0;
+  for (size_t i = 0; i < n; ++i) {
+    m_index[count] = i;
+    count += !std::isnan(values(i));
   }
+  m_valid = count;
+  return count;
 }
 
 //============================================================================
-EVRankNode::~EVRankNode() noexcept {}
+size_t CrossSectionSelector::selectSmallest(
+    LinAlg::EigenRef<const LinAlg::EigenVectorXd> values,
+    size_t count) noexcept {
+  count = std::min(count, m_valid);
+  if (count > 0 && count < m_valid) {
+    std::nth_element(m_index.begin(), m_index.begin() + count,
+                     m_index.begin() + m_valid, [&](size_t a, size_t b) {
+                       return values(a) < values(b);
+                     });
+  }
+  return count;
+}
 
 //============================================================================
-static bool comparePairs(const std::pair<size_t, double> &a,
-                         const std::pair<size_t, double> &b) {
-  if (std::isnan(a.second)) {
-    return false;
+size_t CrossSectionSelector::selectLargest(
+    LinAlg::EigenRef<const LinAlg::EigenVectorXd> values, size_t count,
+    size_t offset) noexcept {
+  offset = std::min(offset, m_valid);
+  count = std::min(count, m_valid - offset);
+  auto begin = m_index.begin() + offset;
+  if (count > 0 && offset + count < m_valid) {
+    std::nth_element(begin, begin + count, m_index.begin() + m_valid,
+                     [&](size_t a, size_t b) { return values(a) > values(b); });
   }
-  if (std::isnan(b.second)) {
-    return true;
-  }
-  return a.second < b.second;
+  return count;
 }
 
 //============================================================================
-static bool comparePairsReverse(const std::pair<size_t, double> &a,
-                                const std::pair<size_t, double> &b) {
-  if (std::isnan(a.second)) {
-    return true;
+void CrossSectionSelector::sort(
+    LinAlg::EigenRef<const LinAlg::EigenVectorXd> values) noexcept {
+  size_t n = m_valid;
+  m_keys.resize(n);
+  m_keys_scratch.resize(n);
+  m_index_scratch.resize(m_index.size());
+
+  // flip every bit of a negative double and only the sign bit of a positive
+  // one so that the unsigned order of the keys is the order of the values
+  for (size_t i = 0; i < n; ++i) {
+    Uint64 bits = std::bit_cast<Uint64>(values(m_index[i]));
+    Uint64 mask = (0 - (bits >> 63)) | (Uint64(1) << 63);
+    m_keys[i] = bits ^ mask;
   }
-  if (std::isnan(b.second)) {
-    return false;
+
+  // stable LSD passes over each byte, skipping bytes every key shares
+  for (size_t shift = 0; shift < 64 && n > 1; shift += 8) {
+    std::array<size_t, 257> offsets{};
+    for (size_t i = 0; i < n; ++i) {
+      ++offsets[((m_keys[i] >> shift) & 0xFF) + 1];
+    }
+    if (offsets[((m_keys[0] >> shift) & 0xFF) + 1] == n) {
+      continue;
+    }
+    for (size_t b = 1; b < offsets.size(); ++b) {
+      offsets[b] += offsets[b - 1];
+    }
+    for (size_t i = 0; i < n; ++i) {
+      size_t position = offsets[(m_keys[i] >> shift) & 0xFF]++;
+      m_keys_scratch[position] = m_keys[i];
+      m_index_scratch[position] = m_index[i];
+    }
+    std::swap(m_keys, m_keys_scratch);
+    std::swap(m_index, m_index_scratch);
   }
-  return a.second > b.second;
 }
 
 //============================================================================
-void EVRankNode::sort() noexcept {
-  switch (m_type) {
-  case EVRankType::NSMALLEST:
-    // do a partial sort to find the smallest N elements
-    std::partial_sort(m_view.begin(), m_view.begin() + m_N, m_view.end(),
-                      &comparePairs);
-    break;
-  case EVRankType::NLARGEST:
-    // do a partial sort to find the largest N elements
-    std::partial_sort(m_view.begin(), m_view.begin() + m_N, m_view.end(),
-                      &comparePairsReverse);
-    break;
-  case EVRankType::NEXTREME:
-    // do a partial sort, first N elements are the smallest
-    std::partial_sort(m_view.begin(), m_view.begin() + m_N, m_view.end(),
-                      &comparePairs);
-
-    // Custom comparator for the last N elements (largest)
-    std::partial_sort(m_view.begin() + m_N, m_view.end(), m_view.end(),
-                      &comparePairs);
-    break;
-  case EVRankType::FULL:
-    std::sort(m_view.begin(), m_view.end(), &comparePairs);
-    break;
+void CrossSectionSelector::mask(LinAlg::EigenRef<LinAlg::EigenVectorXd> values,
+                                size_t count) noexcept {
+  m_kept.resize(count);
+  for (size_t i = 0; i < count; ++i) {
+    m_kept[i] = values(m_index[i]);
   }
+  values.setConstant(std::numeric_limits<double>::quiet_NaN());
+  for (size_t i = 0; i < count; ++i) {
+    values(m_index[i]) = m_kept[i];
+  }
+}
+
+//============================================================================
+EVRankNode::EVRankNode(SharedPtr<ExchangeViewNode> ev, EVRankType type,
+                       size_t count) noexcept
+    : StrategyBufferOpNode(NodeType::RANK_NODE, ev->getExchange(), ev.get()),
+      m_N(count), m_type(type), m_ev(std::move(ev)) {
+  addInput(m_ev);
+  // size the selection buffers up front so the first step does not allocate
+  m_selector.partition(LinAlg::EigenVectorXd::Zero(m_ev->getViewSize()));
 }
 
+//============================================================================
+EVRankNode::~EVRankNode() noexcept {}
+
 //============================================================================
 size_t EVRankNode::getWarmup() const noexcept { return m_ev->getWarmup(); }
 
@@ -85,58 +130,57 @@ bool EVRankNode::isSame(StrategyBufferOpNode const* other) const noexcept {
 }
 
 //============================================================================
-void EVRankNode::reset() noexcept {
-  m_ev->reset();
-  for (auto &pair : m_view) {
-    pair.second = 0.0;
-  }
+void EVRankNode::reset() noexcept { m_ev->reset(); }
+
+//============================================================================
+void EVRankNode::optimize(ASTOptimizer &optimizer) noexcept {
+  optimizer.visit(*m_ev);
 }
 
+//============================================================================
+bool EVRankNode::inputsDirty() noexcept { return m_ev->isDirty(); }
+
 //============================================================================
 void EVRankNode::evaluate(
     LinAlg::EigenRef<LinAlg::EigenVectorXd> target) noexcept {
   // before executing cross sectional rank, execute the parent exchange
   // view operation to populate target vector with feature values
-  m_ev->evaluate(target);
-
-  // then we copy target over to the view pair vector to keep
-  // track of the index locations of each value when sorting
-  assert(static_cast<size_t>(target.size()) == m_view.size());
-  for (size_t i = 0; i < m_view.size(); ++i) {
-    m_view[i].second = target[i];
+  auto values = m_ev->read(target);
+  if (values.data() != target.data()) {
+    target = values;
   }
 
-  // sort the view pair vector, the target elements will be in
-  // the first N locations, we can then set the rest to Nan to
-  // prevent them from being allocated. At which point we have a
-  // target vector that looks like:
-  // [Nan, largest_element(1), Nan, second_largest_element (-1), Nan, Nan]
-  sort();
+  // NaN values are never selected and stay NaN in the output, the
+  // selection then runs over the valid values only
+  size_t valid = m_selector.partition(target);
+  auto const &index = m_selector.index();
   switch (m_type) {
   case EVRankType::NSMALLEST:
+    m_selector.mask(target, m_selector.selectSmallest(target, m_N));
+    break;
   case EVRankType::NLARGEST:
-    for (size_t i = m_N; i < m_view.size(); ++i) {
-      target[m_view[i].first] = std::numeric_limits<double>::quiet_NaN();
-    }
+    m_selector.mask(target, m_selector.selectLargest(target, m_N));
     break;
-  case EVRankType::NEXTREME:
-    // the first N elements are the smallest, the last N are the largest. But
-    // we have to allow the allocation node to distinguish between the two so we
-    // eat the signal
-    for (size_t i = 0; i < m_N; ++i) {
-      target[m_view[i].first] = -1.0f;
-    }
-    for (size_t i = m_view.size() - m_N; i < m_view.size(); ++i) {
-      target[m_view[i].first] = 1.0f;
-    }
-    for (size_t i = m_N; i < m_view.size() - m_N; ++i) {
-      target[m_view[i].first] = std::numeric_limits<double>::quiet_NaN();
+  case EVRankType::NEXTREME: {
+    // the N smallest are flagged -1 and the N largest 1 so the allocation
+    // node can distinguish between the two, with fewer than 2N valid values
+    // each side gets half of them
+    size_t count = std::min(m_N, valid / 2);
+    m_selector.selectSmallest(target, count);
+    m_selector.selectLargest(target, count, count);
+    target.setConstant(std::numeric_limits<double>::quiet_NaN());
+    for (size_t i = 0; i < count; ++i) {
+      target[index[i]] = -1.0;
+      target[index[count + i]] = 1.0;
     }
     break;
+  }
   case EVRankType::FULL:
-    for (size_t i = 0; i < m_view.size(); ++i) {
-      target[m_view[i].first] = static_cast<double>(i);
+    m_selector.sort(target);
+    for (size_t i = 0; i < valid; ++i) {
+      target[index[i]] = static_cast<double>(i);
     }
+    break;
   }
 }
 
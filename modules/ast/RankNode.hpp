@@ -8,6 +8,7 @@
 #include "standard/AtlasCore.hpp"
 #include "ast/BaseNode.hpp"
 #include "ast/StrategyBufferNode.hpp"
+#include "standard/AtlasLinAlg.hpp"
 
 namespace Atlas
 {
@@ -26,6 +27,61 @@ enum class EVRankType : uint8_t
 };
 
 
+//============================================================================
+/// <summary>
+/// Reusable cross sectional selection over a vector of asset values. NaN
+/// values are partitioned out in one pass, after which the N smallest or
+/// largest are found with nth_element in linear time, or the valid values are
+/// fully ordered by an LSD radix sort on their bit patterns. The index
+/// buffers are kept between calls so a step does not allocate.
+/// </summary>
+class CrossSectionSelector
+{
+private:
+	Vector<size_t> m_index;
+	Vector<size_t> m_index_scratch;
+	Vector<Uint64> m_keys;
+	Vector<Uint64> m_keys_scratch;
+	Vector<double> m_kept;
+	size_t m_valid = 0;
+
+public:
+	/// <summary>
+	/// Move the indices of the non NaN values to the front of the index
+	/// buffer in asset order, returning their count
+	/// </summary>
+	size_t partition(LinAlg::EigenRef<const LinAlg::EigenVectorXd> values) noexcept;
+
+	/// <summary>
+	/// Place the indices of the count smallest valid values (unordered) at
+	/// the front of the index buffer, returning how many were selected
+	/// </summary>
+	size_t selectSmallest(LinAlg::EigenRef<const LinAlg::EigenVectorXd> values, size_t count) noexcept;
+
+	/// <summary>
+	/// Place the indices of the count largest valid values from offset on
+	/// (unordered) at offset, returning how many were selected
+	/// </summary>
+	size_t selectLargest(LinAlg::EigenRef<const LinAlg::EigenVectorXd> values, size_t count, size_t offset = 0) noexcept;
+
+	/// <summary>
+	/// Order the valid indices by ascending value, ties keep asset order
+	/// </summary>
+	void sort(LinAlg::EigenRef<const LinAlg::EigenVectorXd> values) noexcept;
+
+	/// <summary>
+	/// Set every value not among the first count selected indices to NaN
+	/// </summary>
+	void mask(LinAlg::EigenRef<LinAlg::EigenVectorXd> values, size_t count) noexcept;
+
+	/// <summary>
+	/// Asset indices, only the first valid() entries are meaningful
+	/// </summary>
+	[[nodiscard]] Vector<size_t> const& index() const noexcept { return m_index; }
+	[[nodiscard]] size_t valid() const noexcept { return m_valid; }
+};
+
+
 //============================================================================
 class EVRankNode final : public StrategyBufferOpNode
 {
@@ -33,9 +89,7 @@ private:
 	size_t m_N;
 	EVRankType m_type;
 	SharedPtr<ExchangeViewNode> m_ev;
-	Vector<std::pair<size_t, double>> m_view;
-	
-	void sort() noexcept;
+	CrossSectionSelector m_selector;
 
 public:
 	ATLAS_API EVRankNode(
@@ -61,6 +115,8 @@ public:
 	[[nodiscard]] size_t getWarmup() const noexcept override;
 	[[nodiscard]] bool isSame(StrategyBufferOpNode const* other) const noexcept override;
 	void reset() noexcept override;
+	void optimize(ASTOptimizer& optimizer) noexcept override;
+	bool inputsDirty() noexcept override;
 	void evaluate(LinAlg::EigenRef<LinAlg::EigenVectorXd> target) noexcept override;
 };
 
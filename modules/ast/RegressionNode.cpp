@@ -0,0 +1,288 @@
+#include "AtlasMacros.hpp"
+
+#include "exchange/Exchange.hpp"
+#include "ast/RegressionNode.hpp"
+#include "ast/ASTOptimizer.hpp"
+
+namespace Atlas {
+
+namespace AST {
+
+//============================================================================
+static Vector<SharedPtr<StrategyBufferOpNode>>
+regressionInputs(SharedPtr<StrategyBufferOpNode> const &parent,
+                 Vector<SharedPtr<StrategyBufferOpNode>> const &factors,
+                 Option<SharedPtr<StrategyBufferOpNode>> const &weights) {
+  Vector<SharedPtr<StrategyBufferOpNode>> inputs = {parent};
+  inputs.insert(inputs.end(), factors.begin(), factors.end());
+  if (weights) {
+    inputs.push_back(*weights);
+  }
+  return inputs;
+}
+
+//============================================================================
+CrossSectionRegressionNode::CrossSectionRegressionNode(
+    SharedPtr<StrategyBufferOpNode> parent,
+    Vector<SharedPtr<StrategyBufferOpNode>> factors,
+    CrossSectionOutputType output, bool intercept, size_t factor,
+    Option<SharedPtr<StrategyBufferOpNode>> weights) noexcept
+    : StrategyBufferOpNode(NodeType::REGRESSION, parent->getExchange(),
+                           regressionInputs(parent, factors, weights)),
+      m_parent(std::move(parent)), m_factors(std::move(factors)),
+      m_weights(std::move(weights)), m_output(output), m_intercept(intercept),
+      m_factor(factor) {
+  addInput(m_parent);
+  m_warmup = m_parent->getWarmup();
+  for (auto const &node : m_factors) {
+    addInput(node);
+    m_warmup = std::max(m_warmup, node->getWarmup());
+  }
+  if (m_weights) {
+    addInput(*m_weights);
+    m_warmup = std::max(m_warmup, (*m_weights)->getWarmup());
+  }
+
+  size_t asset_count = getAssetCount();
+  size_t cols = m_factors.size() + (m_intercept ? 1 : 0);
+  m_exposures.resize(asset_count, cols);
+  m_weighted_exposures.resize(asset_count, cols);
+  m_weight_buffer.resize(asset_count);
+  m_gram.resize(cols, cols);
+  m_moment.resize(cols);
+  m_ldlt = Eigen::LDLT<LinAlg::EigenMatrixXd>(static_cast<Eigen::Index>(cols));
+  m_factor_returns.setConstant(cols, std::numeric_limits<double>::quiet_NaN());
+  m_factor_return_sum.setZero(cols);
+  m_factor_return_sum_sq.setZero(cols);
+}
+
+//============================================================================
+CrossSectionRegressionNode::~CrossSectionRegressionNode() noexcept {}
+
+//============================================================================
+Result<SharedPtr<CrossSectionRegressionNode>, AtlasException>
+CrossSectionRegressionNode::make(
+    SharedPtr<StrategyBufferOpNode> parent,
+    Vector<SharedPtr<StrategyBufferOpNode>> factors,
+    CrossSectionOutputType output, bool intercept, size_t factor,
+    Option<SharedPtr<StrategyBufferOpNode>> weights) noexcept {
+  if (factors.empty()) {
+    return Err("Cross section regression requires at least one factor");
+  }
+  size_t cols = factors.size() + (intercept ? 1 : 0);
+  if (factor >= cols) {
+    return Err("Factor index " + std::to_string(factor) +
+               " out of range for " + std::to_string(cols) + " coefficients");
+  }
+  return std::make_shared<CrossSectionRegressionNode>(
+      std::move(parent), std::move(factors), output, intercept, factor,
+      std::move(weights));
+}
+
+//============================================================================
+SharedPtr<CrossSectionRegressionNode> CrossSectionRegressionNode::pyMake(
+    SharedPtr<StrategyBufferOpNode> parent,
+    Vector<SharedPtr<StrategyBufferOpNode>> factors,
+    CrossSectionOutputType output, bool intercept, size_t factor,
+    Option<SharedPtr<StrategyBufferOpNode>> weights) {
+  auto result = make(std::move(parent), std::move(factors), output, intercept,
+                     factor, std::move(weights));
+  if (!result) {
+    throw std::runtime_error(result.error().what());
+  }
+  return *result;
+}
+
+//============================================================================
+bool CrossSectionRegressionNode::fit(
+    LinAlg::EigenRef<LinAlg::EigenVectorXd> y) noexcept {
+  size_t offset = m_intercept ? 1 : 0;
+  if (m_intercept) {
+    m_exposures.col(0).setOnes();
+  }
+  for (size_t k = 0; k < m_factors.size(); ++k) {
+    auto col = m_exposures.col(k + offset);
+    auto values = m_factors[k]->read(col);
+    if (values.data() != col.data()) {
+      col = values;
+    }
+  }
+  if (m_weights) {
+    auto values = (*m_weights)->read(m_weight_buffer);
+    if (values.data() != m_weight_buffer.data()) {
+      m_weight_buffer = values;
+    }
+  } else {
+    m_weight_buffer.setOnes();
+  }
+
+  // assets outside the fit get a zero weight and zero row so they drop out
+  // of the normal equations, the zero weight marks them for the output
+  size_t valid = 0;
+  for (Eigen::Index i = 0; i < m_exposures.rows(); ++i) {
+    double w = m_weight_buffer(i);
+    if (w > 0.0 && std::isfinite(y(i)) && m_exposures.row(i).allFinite()) {
+      ++valid;
+      continue;
+    }
+    m_weight_buffer(i) = 0.0;
+    m_exposures.row(i).setZero();
+    y(i) = 0.0;
+  }
+  if (valid < static_cast<size_t>(m_exposures.cols())) {
+    return false;
+  }
+
+  m_weighted_exposures =
+      m_exposures.array().colwise() * m_weight_buffer.array();
+  m_gram.noalias() = m_weighted_exposures.transpose() * m_exposures;
+  m_moment.noalias() = m_weighted_exposures.transpose() * y;
+  m_ldlt.compute(m_gram);
+  if (m_ldlt.info() != Eigen::Success) {
+    return false;
+  }
+
+  // collinear exposures leave a zero pivot, the solve would return one of
+  // infinitely many fits
+  auto pivots = m_ldlt.vectorD().cwiseAbs();
+  double tolerance = pivots.maxCoeff() * std::numeric_limits<double>::epsilon() *
+                     static_cast<double>(m_gram.rows());
+  if (!(pivots.minCoeff() > tolerance)) {
+    return false;
+  }
+  m_factor_returns = m_ldlt.solve(m_moment);
+  return true;
+}
+
+//============================================================================
+void CrossSectionRegressionNode::evaluate(
+    LinAlg::EigenRef<LinAlg::EigenVectorXd> target) noexcept {
+  auto values = m_parent->read(target);
+  if (values.data() != target.data()) {
+    target = values;
+  }
+  if (!fit(target)) {
+    m_factor_returns.setConstant(std::numeric_limits<double>::quiet_NaN());
+    target.setConstant(std::numeric_limits<double>::quiet_NaN());
+    return;
+  }
+
+  // the second pass statistics take one cross section per step however many
+  // times the node is read within it
+  size_t idx = getCurrentIdx();
+  if (m_fit_idx != idx) {
+    m_fit_idx = idx;
+    m_factor_return_sum += m_factor_returns;
+    m_factor_return_sum_sq += m_factor_returns.cwiseAbs2();
+    ++m_fit_count;
+  }
+
+  switch (m_output) {
+  case CrossSectionOutputType::RESIDUAL:
+    target.noalias() -= m_exposures * m_factor_returns;
+    break;
+  case CrossSectionOutputType::FITTED:
+    target.noalias() = m_exposures * m_factor_returns;
+    break;
+  case CrossSectionOutputType::FACTOR_RETURN:
+    target.setConstant(m_factor_returns(m_factor));
+    break;
+  }
+  for (Eigen::Index i = 0; i < target.size(); ++i) {
+    if (m_weight_buffer(i) == 0.0) {
+      target(i) = std::numeric_limits<double>::quiet_NaN();
+    }
+  }
+}
+
+//============================================================================
+LinAlg::EigenVectorXd
+CrossSectionRegressionNode::getMeanFactorReturns() const noexcept {
+  if (m_fit_count == 0) {
+    return LinAlg::EigenVectorXd::Constant(
+        m_factor_return_sum.size(), std::numeric_limits<double>::quiet_NaN());
+  }
+  return m_factor_return_sum / static_cast<double>(m_fit_count);
+}
+
+//============================================================================
+LinAlg::EigenVectorXd
+CrossSectionRegressionNode::getFactorReturnTStats() const noexcept {
+  // Fama-MacBeth t-statistic, the mean factor return over its standard
+  // error from the time series of the per step estimates
+  double n = static_cast<double>(m_fit_count);
+  if (m_fit_count < 2) {
+    return LinAlg::EigenVectorXd::Constant(
+        m_factor_return_sum.size(), std::numeric_limits<double>::quiet_NaN());
+  }
+  LinAlg::EigenVectorXd mean = m_factor_return_sum / n;
+  LinAlg::EigenVectorXd variance =
+      (m_factor_return_sum_sq - n * mean.cwiseAbs2()) / (n - 1.0);
+  return mean.array() / (variance.array().max(0.0) / n).sqrt();
+}
+
+//============================================================================
+bool CrossSectionRegressionNode::isSame(
+    StrategyBufferOpNode const *other) const noexcept {
+  if (other->getType() != NodeType::REGRESSION) {
+    return false;
+  }
+  auto ptr = static_cast<CrossSectionRegressionNode const *>(other);
+  if (m_output != ptr->m_output || m_intercept != ptr->m_intercept ||
+      m_factor != ptr->m_factor || m_factors.size() != ptr->m_factors.size() ||
+      m_weights.has_value() != ptr->m_weights.has_value() ||
+      !m_parent->isSame(ptr->m_parent.get())) {
+    return false;
+  }
+  for (size_t k = 0; k < m_factors.size(); ++k) {
+    if (!m_factors[k]->isSame(ptr->m_factors[k].get())) {
+      return false;
+    }
+  }
+  return !m_weights || (*m_weights)->isSame(ptr->m_weights->get());
+}
+
+//============================================================================
+void CrossSectionRegressionNode::reset() noexcept {
+  m_parent->reset();
+  for (auto &node : m_factors) {
+    node->reset();
+  }
+  if (m_weights) {
+    (*m_weights)->reset();
+  }
+  m_factor_returns.setConstant(std::numeric_limits<double>::quiet_NaN());
+  m_factor_return_sum.setZero();
+  m_factor_return_sum_sq.setZero();
+  m_fit_count = 0;
+  m_fit_idx = std::nullopt;
+}
+
+//============================================================================
+void CrossSectionRegressionNode::optimize(ASTOptimizer &optimizer) noexcept {
+  // the fit reads every asset of every input
+  optimizer.visit(*m_parent);
+  for (auto &node : m_factors) {
+    optimizer.visit(*node);
+  }
+  if (m_weights) {
+    optimizer.visit(**m_weights);
+  }
+}
+
+//============================================================================
+bool CrossSectionRegressionNode::inputsDirty() noexcept {
+  if (m_parent->isDirty() || (m_weights && (*m_weights)->isDirty())) {
+    return true;
+  }
+  for (auto &node : m_factors) {
+    if (node->isDirty()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace AST
+
+} // namespace Atlas
@@ -0,0 +1,117 @@
+#pragma once
+#ifdef ATLAS_EXPORTS
+#define ATLAS_API __declspec(dllexport)
+#else
+#define ATLAS_API __declspec(dllimport)
+#endif
+#include "standard/AtlasCore.hpp"
+#include "standard/AtlasEnums.hpp"
+#include "ast/BaseNode.hpp"
+#include "ast/StrategyBufferNode.hpp"
+#include "standard/AtlasLinAlg.hpp"
+
+namespace Atlas {
+
+namespace AST {
+
+//============================================================================
+/// <summary>
+/// Cross sectional regression of a signal on K factor exposures at every
+/// step, the first pass of a Fama-MacBeth regression. The exposures are read
+/// into a preallocated assets x K matrix and the weighted normal equations
+/// are solved with an LDLT factorization whose storage is reused across
+/// steps, O(assets * K^2) per step. Assets with a NaN signal, exposure or
+/// weight, or a non positive weight, are left out of the fit and are NaN in
+/// the output. The output is the residual (the factor neutral signal), the
+/// fitted value, or one factor's return broadcast to every fitted asset.
+/// Each step's factor returns are accumulated for the second pass, their
+/// time series mean and t-statistic.
+/// </summary>
+class CrossSectionRegressionNode final : public StrategyBufferOpNode {
+private:
+  SharedPtr<StrategyBufferOpNode> m_parent;
+  Vector<SharedPtr<StrategyBufferOpNode>> m_factors;
+  Option<SharedPtr<StrategyBufferOpNode>> m_weights;
+  CrossSectionOutputType m_output;
+  bool m_intercept;
+  size_t m_factor;
+  size_t m_warmup;
+
+  /// <summary>
+  /// Exposures of every asset, with a leading column of ones when the fit
+  /// has an intercept
+  /// </summary>
+  LinAlg::EigenMatrixXd m_exposures;
+  LinAlg::EigenMatrixXd m_weighted_exposures;
+  LinAlg::EigenVectorXd m_weight_buffer;
+  LinAlg::EigenMatrixXd m_gram;
+  LinAlg::EigenVectorXd m_moment;
+  Eigen::LDLT<LinAlg::EigenMatrixXd> m_ldlt;
+
+  /// <summary>
+  /// Factor returns of the last fit and the running sums of the fitted steps
+  /// </summary>
+  LinAlg::EigenVectorXd m_factor_returns;
+  LinAlg::EigenVectorXd m_factor_return_sum;
+  LinAlg::EigenVectorXd m_factor_return_sum_sq;
+  size_t m_fit_count = 0;
+  Option<size_t> m_fit_idx = std::nullopt;
+
+  [[nodiscard]] bool fit(LinAlg::EigenRef<LinAlg::EigenVectorXd> y) noexcept;
+
+public:
+  ATLAS_API CrossSectionRegressionNode(
+      SharedPtr<StrategyBufferOpNode> parent,
+      Vector<SharedPtr<StrategyBufferOpNode>> factors,
+      CrossSectionOutputType output, bool intercept, size_t factor,
+      Option<SharedPtr<StrategyBufferOpNode>> weights) noexcept;
+  ATLAS_API ~CrossSectionRegressionNode() noexcept;
+
+  /// <summary>
+  /// Regress the parent on the factors. The factor index selects the factor
+  /// return output, counting the intercept first when there is one. The
+  /// optional weights node gives each asset's regression weight.
+  /// </summary>
+  ATLAS_API [[nodiscard]] static Result<SharedPtr<CrossSectionRegressionNode>,
+                                        AtlasException>
+  make(SharedPtr<StrategyBufferOpNode> parent,
+       Vector<SharedPtr<StrategyBufferOpNode>> factors,
+       CrossSectionOutputType output = CrossSectionOutputType::RESIDUAL,
+       bool intercept = true, size_t factor = 0,
+       Option<SharedPtr<StrategyBufferOpNode>> weights = std::nullopt) noexcept;
+
+  ATLAS_API [[nodiscard]] static SharedPtr<CrossSectionRegressionNode>
+  pyMake(SharedPtr<StrategyBufferOpNode> parent,
+         Vector<SharedPtr<StrategyBufferOpNode>> factors,
+         CrossSectionOutputType output = CrossSectionOutputType::RESIDUAL,
+         bool intercept = true, size_t factor = 0,
+         Option<SharedPtr<StrategyBufferOpNode>> weights = std::nullopt);
+
+  /// <summary>
+  /// Factor returns of the last step, NaN if it could not be fit
+  /// </summary>
+  ATLAS_API [[nodiscard]] LinAlg::EigenVectorXd const &
+  getFactorReturns() const noexcept {
+    return m_factor_returns;
+  }
+  ATLAS_API [[nodiscard]] LinAlg::EigenVectorXd
+  getMeanFactorReturns() const noexcept;
+  ATLAS_API [[nodiscard]] LinAlg::EigenVectorXd
+  getFactorReturnTStats() const noexcept;
+  ATLAS_API [[nodiscard]] size_t getFitCount() const noexcept {
+    return m_fit_count;
+  }
+
+  [[nodiscard]] size_t getWarmup() const noexcept override { return m_warmup; }
+  [[nodiscard]] bool
+  isSame(StrategyBufferOpNode const *other) const noexcept override;
+  void reset() noexcept override;
+  void optimize(ASTOptimizer &optimizer) noexcept override;
+  bool inputsDirty() noexcept override;
+  void
+  evaluate(LinAlg::EigenRef<LinAlg::EigenVectorXd> target) noexcept override;
+};
+
+} // namespace AST
+
+} // namespace Atlas
@@ -53,46 +53,125 @@ void CovarianceNode::evaluateChild() noexcept {
 
 //============================================================================
 IncrementalCovarianceNode::IncrementalCovarianceNode(
-    Exchange &exchange, SharedPtr<TriggerNode> trigger,
-    size_t lookback_window) noexcept
-    : CovarianceNodeBase(exchange, trigger, lookback_window) {
+    Exchange &exchange, SharedPtr<TriggerNode> trigger, size_t lookback_window,
+    Option<size_t> recompute_interval) noexcept
+    : CovarianceNodeBase(exchange, trigger, lookback_window),
+      m_recompute_interval(
+          std::max<size_t>(recompute_interval.value_or(lookback_window), 1)) {
   size_t row_count = exchange.getAssetCount();
-  m_sum.resize(row_count, row_count);
-  m_sum.setZero();
+  m_mean.resize(row_count);
+  m_mean.setZero();
+  m_delta.resize(row_count);
+  m_delta.setZero();
+  m_centered.resize(row_count, lookback_window);
+  m_centered.setZero();
   m_sum_product.resize(row_count, row_count);
   m_sum_product.setZero();
-  m_product_buffer.resize(row_count, row_count);
-  m_product_buffer.setZero();
   enableIncremental();
 }
 
 //============================================================================
 IncrementalCovarianceNode::~IncrementalCovarianceNode() noexcept {}
 
+//============================================================================
+void IncrementalCovarianceNode::add(
+    LinAlg::EigenConstColView<double> const &returns) noexcept {
+  double n = static_cast<double>(m_count);
+  m_delta = returns - m_mean;
+  m_mean += m_delta / (n + 1.0);
+  m_sum_product.selfadjointView<Eigen::Lower>().rankUpdate(m_delta,
+                                                          n / (n + 1.0));
+  ++m_count;
+}
+
+//============================================================================
+void IncrementalCovarianceNode::remove(
+    LinAlg::EigenConstColView<double> const &returns) noexcept {
+  double n = static_cast<double>(m_count);
+  m_delta = returns - m_mean;
+  m_mean -= m_delta / (n - 1.0);
+  m_sum_product.selfadjointView<Eigen::Lower>().rankUpdate(m_delta,
+                                                          -n / (n - 1.0));
+  --m_count;
+}
+
+//============================================================================
+void IncrementalCovarianceNode::recompute() noexcept {
+  size_t idx = m_exchange.currentIdx();
+  auto const &returns_block =
+      m_exchange.getMarketReturnsBlock(idx + 1 - m_count, idx);
+  auto centered = m_centered.leftCols(m_count);
+  m_mean = returns_block.rowwise().mean();
+  centered = returns_block.colwise() - m_mean;
+  m_sum_product.setZero();
+  m_sum_product.selfadjointView<Eigen::Lower>().rankUpdate(centered);
+  m_steps_since_recompute = 0;
+}
+
+//============================================================================
+void IncrementalCovarianceNode::stepChild() noexcept {
+  add(m_exchange.getMarketReturns());
+  if (m_count > m_lookback_window) {
+    remove(m_exchange.getMarketReturns(-static_cast<int>(m_lookback_window)));
+  }
+  if (++m_steps_since_recompute >= m_recompute_interval && m_count > 1) {
+    recompute();
+  }
+}
+
 //============================================================================
 void IncrementalCovarianceNode::evaluateChild() noexcept {
-  assert(false);
-  /*
-  auto returns = m_exchange.getMarketReturns().transpose();
-  m_sum.rowwise() += returns;
-
-  m_product_buffer = returns.replicate(returns.cols(),1);
-  m_product_buffer = m_product_buffer.transpose().lazyProduct(m_product_buffer);
-  m_sum_product += m_product_buffer;
-
-  if (m_exchange.currentIdx() >= m_lookback_window)
-  {
-          int row_offset = -1 * static_cast<int>(m_lookback_window);
-          returns = m_exchange.getMarketReturns(row_offset).transpose();
-          m_sum.rowwise() -= returns;
-          m_product_buffer = returns.replicate(returns.cols(), 1);
-          m_product_buffer =
-  m_product_buffer.transpose().lazyProduct(m_product_buffer); m_sum_product -=
-  m_product_buffer;
+  if (m_count < 2) {
+    return;
+  }
+  m_covariance = m_sum_product.selfadjointView<Eigen::Lower>();
+  m_covariance /= static_cast<double>(m_count - 1);
+}
+
+//============================================================================
+EWMACovarianceNode::EWMACovarianceNode(Exchange &exchange,
+                                       SharedPtr<TriggerNode> trigger,
+                                       size_t lookback_window) noexcept
+    : CovarianceNodeBase(exchange, trigger, lookback_window),
+      m_alpha(2.0 / (static_cast<double>(lookback_window) + 1.0)) {
+  size_t row_count = exchange.getAssetCount();
+  m_mean.resize(row_count);
+  m_mean.setZero();
+  m_delta.resize(row_count);
+  m_delta.setZero();
+  m_state.resize(row_count, row_count);
+  m_state.setZero();
+}
+
+//============================================================================
+EWMACovarianceNode::~EWMACovarianceNode() noexcept {}
+
+//============================================================================
+void EWMACovarianceNode::stepChild() noexcept {
+  auto returns = m_exchange.getMarketReturns();
+  if (!m_has_mean) {
+    m_mean = returns;
+    m_has_mean = true;
+    return;
   }
-  m_covariance = (m_sum_product - (m_sum * m_sum.transpose()) /
-  double(m_lookback_window)) / double(m_lookback_window - 1);
-  */
+  m_delta = returns - m_mean;
+  m_mean += m_alpha * m_delta;
+  // only the lower triangle is maintained, it is mirrored on evaluate
+  m_state.triangularView<Eigen::Lower>() *= (1.0 - m_alpha);
+  m_state.selfadjointView<Eigen::Lower>().rankUpdate(
+      m_delta, (1.0 - m_alpha) * m_alpha);
+}
+
+//============================================================================
+void EWMACovarianceNode::evaluateChild() noexcept {
+  m_covariance = m_state.selfadjointView<Eigen::Lower>();
+}
+
+//============================================================================
+void EWMACovarianceNode::resetChild() noexcept {
+  m_has_mean = false;
+  m_mean.setZero();
+  m_state.setZero();
 }
 
 //============================================================================
@@ -100,10 +179,10 @@ void CovarianceNode::resetChild() noexcept { m_centered_returns.setZero(); }
 
 //============================================================================
 void IncrementalCovarianceNode::resetChild() noexcept {
-  m_counter = 0;
-  m_sum.setZero();
+  m_count = 0;
+  m_steps_since_recompute = 0;
+  m_mean.setZero();
   m_sum_product.setZero();
-  m_product_buffer.setZero();
 }
 
 //============================================================================
@@ -115,6 +194,7 @@ void CovarianceNodeBase::reset() noexcept {
 
 //============================================================================
 void CovarianceNodeBase::evaluate() noexcept {
+  stepChild();
   if (!m_trigger->evaluate()) {
     return;
   }
@@ -35,6 +35,12 @@ public:
   void reset() noexcept;
   virtual void evaluateChild() noexcept = 0;
   virtual void resetChild() noexcept = 0;
+
+  /// <summary>
+  /// Called on every exchange step before the trigger is checked, for nodes
+  /// whose state must observe every return and not only triggered steps
+  /// </summary>
+  virtual void stepChild() noexcept {}
   void evaluate() noexcept override;
   bool getIsCached() const noexcept { return m_cached; }
   size_t getWarmup() const noexcept override { return m_warmup; }
@@ -72,18 +78,36 @@ public:
 };
 
 //============================================================================
+/// <summary>
+/// Rolling sample covariance of the market returns over the lookback window,
+/// maintained with Welford style rank one updates. Each step adds the newest
+/// return vector and removes the one leaving the window, O(N^2) however long
+/// the window is. Only the lower triangle of the centered sum of products is
+/// kept, it is mirrored on evaluate. To bound the drift of the rolling sums
+/// the state is recomputed exactly from the window every recompute interval
+/// steps, by default once per lookback window.
+/// </summary>
 class IncrementalCovarianceNode : public CovarianceNodeBase {
   friend class Exchange;
 
 private:
-  size_t m_counter = 0;
-  LinAlg::EigenMatrixXd m_sum;
-  LinAlg::EigenMatrixXd m_product_buffer;
+  size_t m_count = 0;
+  size_t m_recompute_interval;
+  size_t m_steps_since_recompute = 0;
+  LinAlg::EigenVectorXd m_mean;
+  LinAlg::EigenVectorXd m_delta;
+  LinAlg::EigenMatrixXd m_centered;
   LinAlg::EigenMatrixXd m_sum_product;
 
+  void add(LinAlg::EigenConstColView<double> const &returns) noexcept;
+  void remove(LinAlg::EigenConstColView<double> const &returns) noexcept;
+  void recompute() noexcept;
+
 public:
-  IncrementalCovarianceNode(Exchange &exchange, SharedPtr<TriggerNode> trigger,
-                            size_t lookback_window) noexcept;
+  IncrementalCovarianceNode(
+      Exchange &exchange, SharedPtr<TriggerNode> trigger,
+      size_t lookback_window,
+      Option<size_t> recompute_interval = std::nullopt) noexcept;
   ~IncrementalCovarianceNode() noexcept;
 
   template <typename... Arg>
@@ -95,6 +119,44 @@ public:
     return std::make_shared<EnableMakeShared>(std::forward<Arg>(arg)...);
   }
 
+  void stepChild() noexcept override;
+  void evaluateChild() noexcept override;
+  void resetChild() noexcept override;
+};
+
+//============================================================================
+/// <summary>
+/// Exponentially weighted covariance of the market returns with span equal to
+/// the lookback window. The state is a rank one update per step,
+/// S = (1 - alpha) * (S + alpha * d * d^T) with d the deviation of the returns
+/// from their exponentially weighted mean, and is copied out when triggered.
+/// </summary>
+class EWMACovarianceNode : public CovarianceNodeBase {
+  friend class Exchange;
+
+private:
+  double m_alpha;
+  bool m_has_mean = false;
+  LinAlg::EigenVectorXd m_mean;
+  LinAlg::EigenVectorXd m_delta;
+  LinAlg::EigenMatrixXd m_state;
+
+  EWMACovarianceNode(Exchange &exchange, SharedPtr<TriggerNode> trigger,
+                     size_t lookback_window) noexcept;
+
+public:
+  ~EWMACovarianceNode() noexcept;
+
+  template <typename... Arg>
+  SharedPtr<EWMACovarianceNode> static make(Arg &&...arg) {
+    struct EnableMakeShared : public EWMACovarianceNode {
+      EnableMakeShared(Arg &&...arg)
+          : EWMACovarianceNode(std::forward<Arg>(arg)...) {}
+    };
+    return std::make_shared<EnableMakeShared>(std::forward<Arg>(arg)...);
+  }
+
+  void stepChild() noexcept override;
   void evaluateChild() noexcept override;
   void resetChild() noexcept override;
 };
@@ -1,4 +1,6 @@
 #include "ast/AllocationNode.hpp"
+#include "ast/AssetNode.hpp"
+#include "ast/ASTOptimizer.hpp"
 #include "exchange/Exchange.hpp"
 
 namespace Atlas {
@@ -27,6 +29,167 @@ void StrategyBufferOpNode::setTakeFromCache(bool v) noexcept {
   }
 }
 
+//============================================================================
+void StrategyBufferOpNode::evaluateHistory(
+    LinAlg::EigenRef<LinAlg::EigenMatrixXd> target) noexcept {
+  assert(isPathIndependent());
+  if (m_batch_cached) {
+    target = m_cache;
+    return;
+  }
+  evaluateBatch(target);
+}
+
+//============================================================================
+bool StrategyBufferOpNode::isPathIndependent() const noexcept {
+  Set<StrategyBufferOpNode const *> visiting;
+  return isPathIndependent(visiting);
+}
+
+//============================================================================
+bool StrategyBufferOpNode::cacheHistory() noexcept {
+  if (!isPathIndependent()) {
+    return false;
+  }
+  fillHistory();
+  return true;
+}
+
+//============================================================================
+void StrategyBufferOpNode::fillHistory() noexcept {
+  if (m_batch_cached) {
+    return;
+  }
+  enableCache(true);
+  evaluateBatch(m_cache);
+
+  // match the step loop, which leaves the cache zeroed during warmup
+  size_t warmup = std::min(getWarmup(), static_cast<size_t>(m_cache.cols()));
+  m_cache.leftCols(warmup).setZero();
+  m_batch_cached = true;
+}
+
+//============================================================================
+Option<LinAlg::EigenRef<const LinAlg::EigenVectorXd>>
+StrategyBufferOpNode::view() noexcept {
+  if (m_batch_cached) {
+    return cacheColumn();
+  }
+  return std::nullopt;
+}
+
+//============================================================================
+LinAlg::EigenRef<const LinAlg::EigenVectorXd>
+StrategyBufferOpNode::read(
+    LinAlg::EigenRef<LinAlg::EigenVectorXd> buffer) noexcept {
+  // borrow the node's existing buffer if it has one, only fall back to
+  // evaluating into the caller's buffer when the value has to be computed
+  if (auto v = view()) {
+    return *v;
+  }
+
+  // shared nodes read again within the same step, by another consumer or by
+  // another strategy's thread, reuse the first evaluation
+  std::unique_lock<std::mutex> lock(m_read_mutex, std::defer_lock);
+  if (m_shared) {
+    lock.lock();
+  }
+  size_t idx = m_exchange.currentIdx();
+  size_t generation = m_exchange.readGeneration();
+
+  // another thread may overwrite the output once the lock is released, hand
+  // shared nodes' callers a copy instead
+  auto reuse = [&]() -> LinAlg::EigenRef<const LinAlg::EigenVectorXd> {
+    if (!m_shared) {
+      return m_last_output;
+    }
+    buffer = m_last_output;
+    return buffer;
+  };
+  if (m_last_output_gen && *m_last_output_gen == generation) {
+    return reuse();
+  }
+
+  // reuse the previous step's output if none of the inputs changed since
+  bool dirty = isDirtyLocked(idx, generation);
+  if (!dirty && m_last_output_gen && *m_last_output_gen + 1 == generation &&
+      m_last_output_idx + 1 == idx) {
+    m_last_output_gen = generation;
+    m_last_output_idx = idx;
+    cacheOutput(m_last_output);
+    return reuse();
+  }
+  evaluate(buffer);
+  ++m_evaluate_count;
+
+  // only start copying the output once the node has been clean at least
+  // once, nodes that change every step never pay for it
+  m_track_changes |= !dirty;
+  if (m_track_changes || m_memoize) {
+    m_last_output = buffer;
+    m_last_output_gen = generation;
+    m_last_output_idx = idx;
+  }
+  return buffer;
+}
+
+//============================================================================
+bool StrategyBufferOpNode::isDirty() noexcept {
+  std::unique_lock<std::mutex> lock(m_read_mutex, std::defer_lock);
+  if (m_shared) {
+    lock.lock();
+  }
+  return isDirtyLocked(m_exchange.currentIdx(), m_exchange.readGeneration());
+}
+
+//============================================================================
+bool StrategyBufferOpNode::isDirtyLocked(size_t idx,
+                                         size_t generation) noexcept {
+  // nodes are shared across the graph, only walk the inputs once per read
+  // generation
+  if (m_dirty_gen && *m_dirty_gen == generation) {
+    return m_dirty;
+  }
+  m_dirty = idx == 0 || inputsDirty();
+  m_dirty_gen = generation;
+  return m_dirty;
+}
+
+//============================================================================
+void StrategyBufferOpNode::setActiveAssets(
+    Option<Vector<size_t>> lanes) noexcept {
+  m_inactive_assets.clear();
+  if (lanes) {
+    size_t asset_count = m_exchange.getAssetCount();
+    auto it = lanes->begin();
+    for (size_t i = 0; i < asset_count; ++i) {
+      if (it != lanes->end() && *it == i) {
+        ++it;
+        continue;
+      }
+      m_inactive_assets.push_back(i);
+    }
+  }
+  m_active_assets = std::move(lanes);
+}
+
+//============================================================================
+void StrategyBufferOpNode::clearInactiveAssets(
+    LinAlg::EigenRef<LinAlg::EigenVectorXd> target) const noexcept {
+  target(m_inactive_assets)
+      .setConstant(std::numeric_limits<double>::quiet_NaN());
+}
+
+//============================================================================
+void StrategyBufferOpNode::invalidateHistory() noexcept {
+  m_batch_cached = false;
+  m_last_output_gen = std::nullopt;
+  m_dirty_gen = std::nullopt;
+  for (auto child : m_children) {
+    child->invalidateHistory();
+  }
+}
+
 //============================================================================
 bool StrategyBufferOpNode::sameParents(
     Vector<ASTNode *> const &parents) const noexcept {
@@ -55,6 +218,29 @@ void StrategyBufferOpNode::enableCache(bool v) noexcept {
   }
 }
 
+//============================================================================
+void StrategyBufferOpNode::cacheOutput(
+    LinAlg::EigenRef<const LinAlg::EigenVectorXd> const &output) noexcept {
+  if (hasCache()) {
+    cacheColumn() = output;
+  }
+  if (m_lag_buffer.cols()) {
+    size_t col_idx = m_exchange.currentIdx() % m_lag_buffer.cols();
+    m_lag_buffer.col(col_idx) = output;
+  }
+}
+
+//============================================================================
+LinAlg::EigenRef<LinAlg::EigenVectorXd>
+StrategyBufferOpNode::lagColumn(size_t lag) noexcept {
+  size_t col_idx = m_exchange.currentIdx() - lag;
+  if (hasCache()) {
+    return m_cache.col(col_idx);
+  }
+  assert(lag < static_cast<size_t>(m_lag_buffer.cols()));
+  return m_lag_buffer.col(col_idx % m_lag_buffer.cols());
+}
+
 //============================================================================
 LinAlg::EigenRef<LinAlg::EigenVectorXd>
 StrategyBufferOpNode::cacheColumn(Option<size_t> col) noexcept {
@@ -77,8 +263,18 @@ StrategyBufferOpNode::cacheColumn(Option<size_t> col) noexcept {
 
 //============================================================================
 SharedPtr<StrategyBufferOpNode> StrategyBufferOpNode::lag(size_t lag) noexcept {
-  enableCache(true);
   auto lag_node = std::make_shared<LagNode>(this, lag);
+
+  // lags of the same node share one buffer, holding the current step and
+  // as many steps back as the largest lag reads. exchange reads need none as
+  // the exchange already holds their history.
+  auto source = lag_node->m_source;
+  size_t cols = lag_node->m_source_lag + 1;
+  if (source->getType() != NodeType::ASSET_READ &&
+      static_cast<size_t>(source->m_lag_buffer.cols()) < cols) {
+    source->m_lag_buffer.resize(m_exchange.getAssetCount(), cols);
+    source->m_lag_buffer.setZero();
+  }
   return lag_node;
 }
 
@@ -113,27 +309,125 @@ void StrategyBufferOpNode::addChild(StrategyBufferOpNode *child) noexcept {
   m_children.push_back(std::move(child));
 }
 
+//============================================================================
+void StrategyBufferOpNode::removeChild(StrategyBufferOpNode *child) noexcept {
+  m_children.erase(std::remove(m_children.begin(), m_children.end(), child),
+                   m_children.end());
+}
+
+//============================================================================
+StrategyBufferOpNode::~StrategyBufferOpNode() noexcept {
+  for (auto &input : m_child_of) {
+    input->removeChild(this);
+  }
+}
+
+//============================================================================
+void StrategyBufferOpNode::addInput(
+    SharedPtr<StrategyBufferOpNode> const &input) noexcept {
+  input->addChild(this);
+  m_child_of.push_back(input);
+}
+
+//============================================================================
+void StrategyBufferOpNode::replaceInput(
+    StrategyBufferOpNode *input,
+    SharedPtr<StrategyBufferOpNode> replacement) noexcept {
+  input->removeChild(this);
+  auto it = std::find_if(
+      m_child_of.begin(), m_child_of.end(),
+      [input](auto const &registered) { return registered.get() == input; });
+  if (it != m_child_of.end()) {
+    m_child_of.erase(it);
+  }
+  addInput(replacement);
+}
+
 //============================================================================
 LagNode::LagNode(StrategyBufferOpNode *parent, size_t lag) noexcept
     : StrategyBufferOpNode(NodeType::LAG, parent->getExchange(), parent),
-      m_lag(lag), m_parent(parent) {
-  assert(parent->cache().cols() > 1);
+      m_lag(lag), m_parent(parent), m_source(parent), m_source_lag(lag) {
+  // lags and exchange reads are only ever viewed, never evaluated, so they
+  // do not fill a buffer of their own. a lag of a lag reads the first node
+  // that is evaluated further back and a lag of a read reads the exchange.
+  while (m_source->getType() == NodeType::LAG) {
+    auto inner = static_cast<LagNode const *>(m_source);
+    m_source_lag += inner->m_lag;
+    m_source = inner->m_parent;
+  }
+  // lags are built from the parent itself which only holds a raw this, the
+  // edge is registered whenever the parent is owned by a shared pointer
+  if (auto shared = parent->weak_from_this().lock()) {
+    addInput(shared);
+  }
 }
 
 //============================================================================
 void LagNode::evaluate(
     LinAlg::EigenRef<LinAlg::EigenVectorXd> target) noexcept {
-  size_t col_idx = m_exchange.currentIdx();
-  if (col_idx < m_lag) {
-    target.setConstant(std::numeric_limits<float>::quiet_NaN());
+  if (auto v = view()) {
+    target = *v;
     return;
   }
-  assert(target.rows() == m_parent->cache().rows());
-  target = m_parent->cache().col(col_idx - m_lag);
+  target.setConstant(std::numeric_limits<float>::quiet_NaN());
+}
+
+//============================================================================
+bool LagNode::isPathIndependent(
+    Set<StrategyBufferOpNode const *> &visiting) const noexcept {
+  // a lag swapped into its own parent's inputs makes the parent recursive in
+  // time, reaching the lag again while checking the parent ends the cycle
+  if (!visiting.insert(this).second) {
+    return false;
+  }
+  bool path_independent = m_parent->isPathIndependent(visiting);
+  visiting.erase(this);
+  return path_independent;
 }
 
 //============================================================================
-void LagNode::reset() noexcept { m_parent->reset(); }
+void LagNode::evaluateBatch(
+    LinAlg::EigenRef<LinAlg::EigenMatrixXd> target) noexcept {
+  m_parent->evaluateHistory(target);
+  size_t cols = static_cast<size_t>(target.cols());
+  size_t lag = std::min(m_lag, cols);
+  for (size_t i = cols; i-- > lag;) {
+    target.col(i) = target.col(i - lag);
+  }
+  target.leftCols(lag).setConstant(std::numeric_limits<double>::quiet_NaN());
+}
+
+//============================================================================
+Option<LinAlg::EigenRef<const LinAlg::EigenVectorXd>> LagNode::view() noexcept {
+  size_t col_idx = m_exchange.currentIdx();
+  if (m_source->getType() == NodeType::ASSET_READ) {
+    auto read = static_cast<AssetReadNode const *>(m_source);
+    size_t offset = std::abs(read->getRowOffset()) + m_source_lag;
+    if (col_idx < offset) {
+      return std::nullopt;
+    }
+    return m_exchange.getSlice(read->getColumn(), -static_cast<int>(offset));
+  }
+  if (col_idx < m_source_lag) {
+    return std::nullopt;
+  }
+  return m_source->lagColumn(m_source_lag);
+}
+
+//============================================================================
+void LagNode::reset() noexcept {
+  // the buffer wraps around, clear it so the next run reads zeros during the
+  // parent's warmup as it would from a full cache
+  m_source->m_lag_buffer.setZero();
+  m_parent->reset();
+}
+
+//============================================================================
+void LagNode::optimize(ASTOptimizer &optimizer) noexcept {
+  // the lag reads from the parent's cache so the parent itself can not be
+  // swapped out, only its inputs
+  optimizer.visit(*m_parent);
+}
 
 //============================================================================
 size_t LagNode::getWarmup() const noexcept {
@@ -146,7 +440,7 @@ bool LagNode::isSame(StrategyBufferOpNode const* other) const noexcept {
     return false;
   }
   auto other_lag = static_cast<LagNode const*>(other);
-  return m_lag == other_lag->m_lag;
+  return m_lag == other_lag->m_lag && m_parent->isSame(other_lag->m_parent);
 }
 
 } // namespace AST
@@ -4,6 +4,8 @@
 #else
 #define ATLAS_API __declspec(dllimport)
 #endif
+#include <mutex>
+
 #include "standard/AtlasCore.hpp"
 #include "standard/AtlasLinAlg.hpp"
 #include "ast/BaseNode.hpp"
@@ -14,12 +16,68 @@ namespace AST {
 
 //============================================================================
 class StrategyBufferOpNode
-    : public OpperationNode<void, LinAlg::EigenRef<LinAlg::EigenVectorXd>> {
+    : public OpperationNode<void, LinAlg::EigenRef<LinAlg::EigenVectorXd>>,
+      public std::enable_shared_from_this<StrategyBufferOpNode> {
   friend class Exchange;
+  friend class ASTOptimizer;
+  friend class LagNode;
 
 private:
   Vector<StrategyBufferOpNode*> m_children;
+
+  // inputs the node has registered itself as a child of, held so that they
+  // outlive the node's destructor which removes it from each of them
+  Vector<SharedPtr<StrategyBufferOpNode>> m_child_of;
+  bool m_batch_cached = false;
+
+  // ring of the node's last outputs read by its lag nodes, column i % cols
+  // holds the output at exchange index i. sized by the largest lag so a node
+  // without a full cache only keeps the history its lags can reach.
+  LinAlg::EigenMatrixXd m_lag_buffer;
+
+  // output of the last evaluation through read(), kept once the node has
+  // been seen to be clean so that unchanged steps can reuse it. keyed by the
+  // exchange's read generation so that a grid swapping nodes within a step
+  // never sees the output of another cell.
+  LinAlg::EigenVectorXd m_last_output;
+  Option<size_t> m_last_output_gen = std::nullopt;
+  size_t m_last_output_idx = 0;
+  bool m_track_changes = false;
+
+  // set by the optimizer on pure nodes with more than one consumer so that
+  // repeated reads within a step evaluate the node once
+  bool m_memoize = false;
+  Option<size_t> m_dirty_gen = std::nullopt;
+  bool m_dirty = true;
+
+  // guards the reuse state above and the evaluation itself, only taken when
+  // the optimizer has seen the node in the AST of more than one strategy as
+  // those may step in parallel. inputs are always locked after their
+  // consumers so the DAG can not deadlock.
+  std::mutex m_read_mutex;
+  bool m_shared = false;
+  StrategyNode const *m_owner = nullptr;
+  size_t m_evaluate_count = 0;
+  [[nodiscard]] bool isDirtyLocked(size_t idx, size_t generation) noexcept;
+
+  // sorted asset lanes read by the node's consumers, set by the optimizer
+  // when they are a strict subset of the exchange. nullopt for every lane.
+  // the remaining lanes are written as NaN so that a reader that does not
+  // honour the restriction never sees a stale value.
+  Option<Vector<size_t>> m_active_assets = std::nullopt;
+  Vector<size_t> m_inactive_assets;
+  bool m_assets_restricted = false;
+  void setActiveAssets(Option<Vector<size_t>> lanes) noexcept;
   void setTakeFromCache(bool v) noexcept;
+  [[nodiscard]] bool cacheHistory() noexcept;
+
+  // fill the cache over the full history without checking that the node is
+  // path independent, the caller must have done so
+  void fillHistory() noexcept;
+  void replaceInput(StrategyBufferOpNode *input,
+                    SharedPtr<StrategyBufferOpNode> replacement) noexcept;
+  [[nodiscard]] LinAlg::EigenRef<LinAlg::EigenVectorXd>
+  lagColumn(size_t lag) noexcept;
 
 protected:
   Exchange &m_exchange;
@@ -39,17 +97,76 @@ protected:
 
 
   void enableCache(bool v = true) noexcept;
+
+  // register the node as a child of the input so that history invalidation
+  // and the batch cache walk reach it, undone when the node is destroyed
+  void addInput(SharedPtr<StrategyBufferOpNode> const &input) noexcept;
   [[nodiscard]] bool sameParents(Vector<ASTNode *> const &parent) const noexcept;
   [[nodiscard]] bool hasCache() const noexcept { return m_cache.cols() > 1; }
   [[nodiscard]] LinAlg::EigenRef<LinAlg::EigenVectorXd>
   cacheColumn(Option<size_t> col = std::nullopt) noexcept;
 
+  // store the node's output for the current step in its cache and lag
+  // buffer, if it has either
+  void cacheOutput(LinAlg::EigenRef<const LinAlg::EigenVectorXd> const &output) noexcept;
+  [[nodiscard]] bool isBatchCached() const noexcept { return m_batch_cached; }
+  [[nodiscard]] Option<Vector<size_t>> const &activeAssets() const noexcept {
+    return m_active_assets;
+  }
+  void clearInactiveAssets(
+      LinAlg::EigenRef<LinAlg::EigenVectorXd> target) const noexcept;
+  void invalidateHistory() noexcept;
+
+  // evaluate the node over the full exchange history, column i of the
+  // assets x timestamps target holds the node's value at exchange index i.
+  // only called on nodes where isPathIndependent() is true.
+  virtual void
+  evaluateBatch(LinAlg::EigenRef<LinAlg::EigenMatrixXd> target) noexcept {
+    assert(false);
+  }
+
+  // return a read only view of an existing buffer holding the node's value at
+  // the current step (an exchange column, observer state or cache column).
+  // nodes that compute their value return nullopt and are evaluated instead.
+  virtual Option<LinAlg::EigenRef<const LinAlg::EigenVectorXd>> view() noexcept;
+
+  // whether the node's output may differ from the previous step. time
+  // dependent nodes such as observers and lags keep the default, nodes that
+  // are a pure function of their inputs are dirty if any input is.
+  virtual bool inputsDirty() noexcept { return true; }
+
+  // the lanes of the node's inputs needed to compute the given output lanes,
+  // nullopt for every lane. by default any output may depend on every input
+  // lane, nodes computing lane i only from lane i of their inputs pass the
+  // lanes through so that their inputs can skip the others.
+  virtual Option<Vector<size_t>>
+  inputAssets(Option<Vector<size_t>> const &lanes) const noexcept {
+    return std::nullopt;
+  }
+
+  // visit the node's inputs with the optimizer before the first step so they
+  // can be rewritten in place. Nodes without inputs have nothing to visit.
+  virtual void optimize(ASTOptimizer &optimizer) noexcept {}
+
 public:
-  virtual ~StrategyBufferOpNode() = default;
+  virtual ~StrategyBufferOpNode() noexcept;
   virtual size_t refreshWarmup() noexcept { return 0; }
+  // whether the node's value over the full history can be computed without
+  // stepping the exchange. visiting holds the lags on the path being checked
+  // so that a lag fed back into its own parent's inputs ends the walk.
+  virtual bool isPathIndependent(
+      Set<StrategyBufferOpNode const *> &visiting) const noexcept {
+    return false;
+  }
+  [[nodiscard]] bool isPathIndependent() const noexcept;
+  void evaluateHistory(LinAlg::EigenRef<LinAlg::EigenMatrixXd> target) noexcept;
+  [[nodiscard]] LinAlg::EigenRef<const LinAlg::EigenVectorXd>
+  read(LinAlg::EigenRef<LinAlg::EigenVectorXd> buffer) noexcept;
+  [[nodiscard]] bool isDirty() noexcept;
   virtual [[nodiscard]] bool
   isSame(StrategyBufferOpNode const* other) const noexcept = 0;
   void addChild(StrategyBufferOpNode *child) noexcept;
+  void removeChild(StrategyBufferOpNode *child) noexcept;
   [[nodiscard]] size_t getAssetCount() const noexcept;
   [[nodiscard]] size_t getCurrentIdx() const noexcept;
   [[nodiscard]] Option<AllocationBaseNode *> getAllocationNode() const noexcept;
@@ -60,6 +177,11 @@ public:
   getAssetCacheSlice(size_t asset_index) const noexcept;
   ATLAS_API auto const &cache() noexcept { return m_cache; }
   ATLAS_API uintptr_t address() const noexcept {return reinterpret_cast<uintptr_t>(this); }
+
+  // number of times read() had to evaluate the node
+  ATLAS_API size_t getEvaluateCount() const noexcept {
+    return m_evaluate_count;
+  }
 };
 
 //============================================================================
@@ -81,11 +203,18 @@ public:
 
 //============================================================================
 class LagNode : public StrategyBufferOpNode {
+  friend class StrategyBufferOpNode;
+
 private:
   size_t m_lag;
   size_t m_lag_cache_idx = 0;
   StrategyBufferOpNode *m_parent;
 
+  // first node up the chain of lags that is evaluated, read m_source_lag
+  // steps back
+  StrategyBufferOpNode *m_source;
+  size_t m_source_lag;
+
 public:
   LagNode(StrategyBufferOpNode *parent, size_t lag) noexcept;
   ATLAS_API ~LagNode() noexcept {}
@@ -96,6 +225,12 @@ public:
   ATLAS_API void
   evaluate(LinAlg::EigenRef<LinAlg::EigenVectorXd> target) noexcept override;
   ATLAS_API void reset() noexcept override;
+  [[nodiscard]] bool isPathIndependent(
+      Set<StrategyBufferOpNode const *> &visiting) const noexcept override;
+  void
+  evaluateBatch(LinAlg::EigenRef<LinAlg::EigenMatrixXd> target) noexcept override;
+  Option<LinAlg::EigenRef<const LinAlg::EigenVectorXd>> view() noexcept override;
+  void optimize(ASTOptimizer &optimizer) noexcept override;
 };
 
 } // namespace AST
@@ -5,6 +5,7 @@
 #include "ast/ExchangeNode.hpp"
 #include "ast/RiskNode.hpp"
 #include "ast/StrategyNode.hpp"
+#include "ast/ASTOptimizer.hpp"
 
 namespace Atlas {
 
@@ -77,6 +78,11 @@ void StrategyNode::reset() noexcept {
   m_allocation->reset();
 }
 
+//============================================================================
+void StrategyNode::optimize(ASTOptimizer &optimizer) noexcept {
+  optimizer.visit(*m_allocation);
+}
+
 //============================================================================
 void StrategyNode::setTracer(SharedPtr<Tracer> tracer) noexcept {
   m_allocation->setTracer(tracer);
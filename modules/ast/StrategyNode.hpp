@@ -22,6 +22,7 @@ namespace AST
 class StrategyNode final : OpperationNode<bool, LinAlg::EigenRef<LinAlg::EigenVectorXd>>
 {
 	friend class Strategy;
+	friend class ASTOptimizer;
 private:
 	SharedPtr<AllocationBaseNode> m_allocation;
 	Option<SharedPtr<AllocationWeightNode>> m_alloc_weight;
@@ -30,6 +31,7 @@ private:
 
 	[[nodiscard]] size_t refreshWarmup() noexcept;
 	void reset() noexcept;
+	void optimize(ASTOptimizer& optimizer) noexcept;
 	void setTracer(SharedPtr<Tracer> tracer) noexcept;
 	void setCommissionManager(SharedPtr<CommisionManager> manager) noexcept;
 	void enableCopyWeightsBuffer() noexcept;
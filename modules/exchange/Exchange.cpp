@@ -139,9 +139,27 @@ Result<bool, AtlasException> Exchange::build() noexcept {
     }
   }
   m_impl->assets.clear();
+  buildColumnChanges();
   return true;
 }
 
+//============================================================================
+void Exchange::buildColumnChanges() noexcept {
+  size_t col_count = m_impl->headers.size();
+  size_t timestamp_count = m_impl->timestamps.size();
+  m_impl->column_changed.resize(col_count, timestamp_count);
+  m_impl->column_changed.setConstant(true);
+  for (size_t t = 1; t < timestamp_count; t++) {
+    for (size_t c = 0; c < col_count; c++) {
+      auto prev = m_impl->data.col((t - 1) * col_count + c).array();
+      auto curr = m_impl->data.col(t * col_count + c).array();
+      // NaN to NaN is treated as unchanged
+      bool same = ((prev == curr) || (prev.isNaN() && curr.isNaN())).all();
+      m_impl->column_changed(c, t) = !same;
+    }
+  }
+}
+
 //============================================================================
 void Exchange::reset() noexcept {
   if (m_impl->current_index == m_impl->timestamps.size()) {
@@ -150,6 +168,7 @@ void Exchange::reset() noexcept {
 
   m_impl->current_index = 0;
   m_impl->current_timestamp = 0;
+  invalidateReads();
 
   // Reset strategies
   for (auto &strategy : m_impl->registered_strategies) {
@@ -169,15 +188,7 @@ void Exchange::reset() noexcept {
                      }),
       m_impl->registered_triggers.end());
 
-  for (auto it = m_impl->ast_cache.begin(); it != m_impl->ast_cache.end();
-       /* no increment here */) {
-    auto const &[name, node] = *it;
-    if (node.use_count() == 1) {
-      it = m_impl->ast_cache.erase(it);
-    } else {
-      ++it;
-    }
-  }
+  cleanupCaches();
 
   m_impl->asset_observers.erase(std::remove_if(m_impl->asset_observers.begin(),
                                                m_impl->asset_observers.end(),
@@ -233,6 +244,7 @@ void Exchange::step(Int64 global_time) noexcept {
                   trigger->step();
                 });
   m_impl->current_index++; // cov node valls currentIdx on first step
+  invalidateReads();
   std::for_each(m_impl->covariance_nodes.begin(),
                 m_impl->covariance_nodes.end(),
                 [](auto &node_pair) { node_pair.second->evaluate(); });
@@ -276,6 +288,13 @@ SharedPtr<AST::AssetObserverNode> Exchange::registerObserver(
       return node;
     }
   }
+  // observers of the same parent read it from a single shared history
+  for (auto const &node : m_impl->asset_observers) {
+    if (node->m_parent == observer->m_parent) {
+      observer->shareHistory(*node);
+      break;
+    }
+  }
   m_impl->asset_observers.push_back(observer);
   return observer;
 }
@@ -290,6 +309,32 @@ Exchange::getASTCache() const noexcept {
   return std::move(cache);
 }
 
+//============================================================================
+Vector<String> Exchange::cleanupObservers(
+    Set<AST::StrategyBufferOpNode const *> const &candidates) noexcept {
+  // remove candidate observers the exchange is holding the only reference
+  // to, observers registered by the user but not yet used are kept. Removing
+  // an observer releases its parent, which may itself be an observer that is
+  // now unused, so repeat until nothing else is removed.
+  Vector<String> removed;
+  auto &observers = m_impl->asset_observers;
+  while (true) {
+    auto it = std::stable_partition(
+        observers.begin(), observers.end(), [&](const auto &observer) {
+          return observer.use_count() > 1 ||
+                 !candidates.contains(observer.get());
+        });
+    if (it == observers.end()) {
+      break;
+    }
+    for (auto removed_it = it; removed_it != observers.end(); ++removed_it) {
+      removed.push_back((*removed_it)->getId().value_or("unnamed"));
+    }
+    observers.erase(it, observers.end());
+  }
+  return removed;
+}
+
 //============================================================================
 void Exchange::cleanupCovarianceNodes() noexcept {
   Vector<String> keysToRemove; // Store keys of nodes to remove
@@ -345,29 +390,233 @@ void Exchange::setExchangeOffset(size_t _offset) noexcept {
   m_impl->setExchangeOffset(_offset);
 }
 
+//============================================================================
+void Exchange::setCacheBudget(size_t bytes) noexcept {
+  m_impl->cache_budget = bytes;
+}
+
+//============================================================================
+Option<size_t> Exchange::getCacheBudget() const noexcept {
+  return m_impl->cache_budget;
+}
+
+//============================================================================
+Option<size_t> Exchange::getCacheBudgetRemaining() const noexcept {
+  if (!m_impl->cache_budget) {
+    return std::nullopt;
+  }
+  size_t budget = *m_impl->cache_budget;
+  return budget > m_impl->cache_reserved ? budget - m_impl->cache_reserved : 0;
+}
+
+//============================================================================
+size_t Exchange::cacheBytes() const noexcept {
+  return getAssetCount() * m_impl->timestamps.size() * sizeof(double);
+}
+
+//============================================================================
+bool Exchange::reserveCache(size_t bytes) noexcept {
+  auto remaining = getCacheBudgetRemaining();
+  if (!remaining || *remaining < bytes) {
+    return false;
+  }
+  m_impl->cache_reserved += bytes;
+  return true;
+}
+
+//============================================================================
+void Exchange::cleanupCaches() noexcept {
+  // drop the caches the exchange is holding the only reference to, the
+  // ones materialized by the optimizer return their bytes to the budget
+  for (auto it = m_impl->ast_cache.begin(); it != m_impl->ast_cache.end();
+       /* no increment here */) {
+    auto const &[name, node] = *it;
+    if (node.use_count() > 1) {
+      ++it;
+      continue;
+    }
+    if (name.starts_with("auto_cache_")) {
+      m_impl->cache_reserved -= std::min(m_impl->cache_reserved, cacheBytes());
+    }
+    it = m_impl->ast_cache.erase(it);
+  }
+}
+
 //============================================================================
 void Exchange::enableNodeCache(String const &name,
                                SharedPtr<AST::StrategyBufferOpNode> node,
                                bool eager) noexcept {
-  // resize the node's cache buffer to store evaluated target buffers
-  node->enableCache();
-  m_impl->ast_cache[name] = node;
+  enableNodeCaches({{name, std::move(node)}}, eager);
+}
 
-  if (!eager) {
+//============================================================================
+void Exchange::enableNodeCaches(
+    HashMap<String, SharedPtr<AST::StrategyBufferOpNode>> const &nodes,
+    bool eager) noexcept {
+  Vector<SharedPtr<AST::StrategyBufferOpNode>> pending;
+  for (auto const &[name, node] : nodes) {
+    // resize the node's cache buffer to store evaluated target buffers
+    node->enableCache();
+    m_impl->ast_cache[name] = node;
+
+    // the cache can be read from outside the graph so every lane is computed
+    node->setActiveAssets(std::nullopt);
+    pending.push_back(node);
+  }
+  if (eager) {
+    precomputeCaches(pending);
+  }
+}
+
+//============================================================================
+void Exchange::precomputeCaches(
+    Vector<SharedPtr<AST::StrategyBufferOpNode>> const &nodes) noexcept {
+  // order the nodes so that a node is filled after every other requested
+  // node it reads from. consumers are reachable through m_children, the
+  // level of a node is the length of the longest chain of requested nodes
+  // feeding into it.
+  HashMap<AST::StrategyBufferOpNode *, size_t> level;
+  for (auto const &node : nodes) {
+    level[node.get()] = 0;
+  }
+  HashMap<AST::StrategyBufferOpNode *, Vector<AST::StrategyBufferOpNode *>>
+      consumers;
+  for (auto const &node : nodes) {
+    Set<AST::StrategyBufferOpNode *> seen;
+    Vector<AST::StrategyBufferOpNode *> stack(node->m_children.begin(),
+                                              node->m_children.end());
+    while (!stack.empty()) {
+      auto child = stack.back();
+      stack.pop_back();
+      if (!seen.insert(child).second) {
+        continue;
+      }
+      if (child != node.get() && level.contains(child)) {
+        consumers[node.get()].push_back(child);
+      }
+      stack.insert(stack.end(), child->m_children.begin(),
+                   child->m_children.end());
+    }
+  }
+
+  // requested nodes on a cycle through a lag have no order between them and
+  // are left at the level they reached
+  HashMap<AST::StrategyBufferOpNode *, size_t> in_degree;
+  for (auto const &[node, node_consumers] : consumers) {
+    for (auto consumer : node_consumers) {
+      in_degree[consumer]++;
+    }
+  }
+  Vector<AST::StrategyBufferOpNode *> order;
+  for (auto const &node : nodes) {
+    if (!in_degree[node.get()]) {
+      order.push_back(node.get());
+    }
+  }
+  for (size_t i = 0; i < order.size(); i++) {
+    for (auto consumer : consumers[order[i]]) {
+      level[consumer] = std::max(level[consumer], level[order[i]] + 1);
+      if (--in_degree[consumer] == 0) {
+        order.push_back(consumer);
+      }
+    }
+  }
+  for (auto const &node : nodes) {
+    if (in_degree[node.get()]) {
+      order.push_back(node.get());
+    }
+  }
+  std::stable_sort(order.begin(), order.end(), [&](auto a, auto b) {
+    return level[a] < level[b];
+  });
+
+  // nodes that only depend on exchange data are computed over the entire
+  // history at once without stepping the exchange. path independence walks
+  // the graph so it is decided for every node before any is filled.
+  Vector<AST::StrategyBufferOpNode *> stepped;
+  Set<AST::StrategyBufferOpNode *> path_independent;
+  for (auto node : order) {
+    if (node->isPathIndependent()) {
+      path_independent.insert(node);
+    } else {
+      stepped.push_back(node);
+    }
+  }
+
+  // nodes on the same level do not read each other, so a level is filled in
+  // parallel unless two of its nodes read an input without a cache, which
+  // both would evaluate at once
+  auto sharesInput = [](Vector<AST::StrategyBufferOpNode *> const &batch) {
+    Set<AST::StrategyBufferOpNode *> reached;
+    for (auto node : batch) {
+      Set<AST::StrategyBufferOpNode *> seen;
+      Vector<AST::StrategyBufferOpNode *> stack;
+      for (auto const &input : node->m_child_of) {
+        stack.push_back(input.get());
+      }
+      while (!stack.empty()) {
+        auto input = stack.back();
+        stack.pop_back();
+        if (input->m_batch_cached || !seen.insert(input).second) {
+          continue;
+        }
+        if (!reached.insert(input).second) {
+          return true;
+        }
+        for (auto const &next : input->m_child_of) {
+          stack.push_back(next.get());
+        }
+      }
+    }
+    return false;
+  };
+  size_t begin = 0;
+  while (begin < order.size()) {
+    size_t end = begin;
+    Vector<AST::StrategyBufferOpNode *> batch;
+    while (end < order.size() && level[order[end]] == level[order[begin]]) {
+      if (path_independent.contains(order[end])) {
+        batch.push_back(order[end]);
+      }
+      end++;
+    }
+    bool parallel = batch.size() > 1 && !sharesInput(batch);
+#pragma omp parallel for if (parallel)
+    for (int i = 0; i < static_cast<int>(batch.size()); i++) {
+      batch[i]->fillHistory();
+    }
+    begin = end;
+  }
+  if (stepped.empty()) {
     return;
   }
 
+  // every other node is filled in a single pass over the timeline, stepping
+  // the triggers and observers once for all of them. nodes are memoized for
+  // the pass so that a requested node read by a later one is evaluated once
+  // per step.
   assert(m_impl->current_index == 0);
+  Vector<bool> memoize;
+  for (auto node : stepped) {
+    memoize.push_back(node->m_memoize);
+    node->m_memoize = true;
+  }
   LinAlg::EigenVectorXd buffer;
   buffer.resize(m_impl->asset_id_map.size());
-  buffer.setZero();
   for (size_t i = 0; i < m_impl->timestamps.size(); i++) {
     step(m_impl->timestamps[i]);
-    if (currentIdx() < node->getWarmup()) {
-      continue;
+    for (auto node : stepped) {
+      if (currentIdx() < node->getWarmup()) {
+        continue;
+      }
+      buffer.setZero();
+      node->cacheColumn() = node->read(buffer);
     }
-    node->evaluate(buffer);
-    node->cacheColumn() = buffer;
+  }
+  for (size_t i = 0; i < stepped.size(); i++) {
+    stepped[i]->m_memoize = memoize[i];
+    stepped[i]->m_last_output_gen = std::nullopt;
+    stepped[i]->m_dirty_gen = std::nullopt;
   }
   reset();
 }
@@ -396,6 +645,17 @@ Option<String> Exchange::getDatetimeFormat() const noexcept {
   return m_impl->datetime_format;
 }
 
+//============================================================================
+bool Exchange::columnChanged(size_t column, int row_offset) const noexcept {
+  size_t offset = static_cast<size_t>(abs(row_offset));
+  size_t idx = currentIdx();
+  if (idx < offset) {
+    return true;
+  }
+  assert(column < static_cast<size_t>(m_impl->column_changed.rows()));
+  return m_impl->column_changed(column, idx - offset);
+}
+
 //============================================================================
 LinAlg::EigenConstColView<double>
 Exchange::getSlice(size_t column, int row_offset) const noexcept {
@@ -410,6 +670,16 @@ Exchange::getSlice(size_t column, int row_offset) const noexcept {
   return m_impl->data.col(idx);
 }
 
+//============================================================================
+LinAlg::EigenConstStridedView
+Exchange::getColumnHistory(size_t column) const noexcept {
+  assert(column < m_impl->col_count);
+  size_t rows = static_cast<size_t>(m_impl->data.rows());
+  return LinAlg::EigenConstStridedView(
+      m_impl->data.data() + column * rows, rows, m_impl->timestamps.size(),
+      Eigen::OuterStride<>(rows * m_impl->col_count));
+}
+
 //============================================================================
 Exchange::~Exchange() {}
 
@@ -418,12 +688,29 @@ void Exchange::registerAllocator(Allocator *strategy) noexcept {
   m_impl->registered_strategies.push_back(strategy);
 }
 
+//============================================================================
+void Exchange::unregisterAllocator(Allocator *strategy) noexcept {
+  auto &strategies = m_impl->registered_strategies;
+  strategies.erase(std::remove(strategies.begin(), strategies.end(), strategy),
+                   strategies.end());
+}
+
 //============================================================================
 size_t Exchange::currentIdx() const noexcept {
   assert(m_impl->current_index > 0);
   return (m_impl->current_index - 1);
 }
 
+//============================================================================
+size_t Exchange::readGeneration() const noexcept {
+  return m_impl->read_generation.load(std::memory_order_acquire);
+}
+
+//============================================================================
+void Exchange::invalidateReads() noexcept {
+  m_impl->read_generation.fetch_add(1, std::memory_order_acq_rel);
+}
+
 //============================================================================
 Option<SharedPtr<AST::AssetObserverNode>>
 Exchange::getObserver(String const &id) noexcept {
@@ -460,7 +747,8 @@ LinAlg::EigenVectorXd const &Exchange::getReturnsScalar() const noexcept {
 SharedPtr<AST::CovarianceNodeBase>
 Exchange::getCovarianceNode(String const &id,
                             SharedPtr<AST::TriggerNode> trigger,
-                            size_t lookback, CovarianceType type) noexcept {
+                            size_t lookback, CovarianceType type,
+                            Option<size_t> recompute_interval) noexcept {
   // free and covariance nodes not being used and register the trigger
   // if it is not already registered
   cleanupCovarianceNodes();
@@ -479,7 +767,11 @@ Exchange::getCovarianceNode(String const &id,
     node = AST::CovarianceNode::make(*this, trigger, lookback);
     break;
   case CovarianceType::INCREMENTAL:
-    node = AST::IncrementalCovarianceNode::make(*this, trigger, lookback);
+    node = AST::IncrementalCovarianceNode::make(*this, trigger, lookback,
+                                                recompute_interval);
+    break;
+  case CovarianceType::EWMA:
+    node = AST::EWMACovarianceNode::make(*this, trigger, lookback);
     break;
   }
   m_impl->covariance_nodes[id] = node;
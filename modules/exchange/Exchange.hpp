@@ -21,6 +21,8 @@ class Exchange
 	friend class AST::AssetReadNode;
 	friend class AST::TriggerNode;
 	friend class AST::StrategyBufferOpNode;
+	friend class AST::ASTOptimizer;
+	friend class AST::StrategyGrid;
 private:
 	UniquePtr<ExchangeImpl> m_impl;
 	String m_name;
@@ -31,6 +33,9 @@ private:
 	[[nodiscard]] Result<bool,AtlasException> init() noexcept;
 	[[nodiscard]] Result<bool,AtlasException> validate() noexcept;
 	[[nodiscard]] Result<bool,AtlasException> build() noexcept;
+	void buildColumnChanges() noexcept;
+	[[nodiscard]] bool reserveCache(size_t bytes) noexcept;
+	[[nodiscard]] size_t cacheBytes() const noexcept;
 
 	[[nodiscard]] SharedPtr<AST::TriggerNode> registerTrigger(SharedPtr<AST::TriggerNode>&& trigger) noexcept;
 	void reset() noexcept;
@@ -38,7 +43,12 @@ private:
 	void step(Int64 global_time) noexcept;
 	void cleanupCovarianceNodes() noexcept;
 	void cleanupTriggerNodes() noexcept;
+	void cleanupCaches() noexcept;
+	[[nodiscard]] Vector<String> cleanupObservers(Set<AST::StrategyBufferOpNode const*> const& candidates) noexcept;
 	void setExchangeOffset(size_t _offset) noexcept;
+	void precomputeCaches(Vector<SharedPtr<AST::StrategyBufferOpNode>> const& nodes) noexcept;
+	[[nodiscard]] size_t readGeneration() const noexcept;
+	void invalidateReads() noexcept;
 
 public:
 	Exchange(
@@ -64,14 +74,17 @@ public:
 	Exchange& operator=(Exchange&&) = delete;
 
 	void registerAllocator(Allocator *strategy) noexcept;
+	void unregisterAllocator(Allocator *strategy) noexcept;
 	auto const& getSource() const noexcept{return m_source;}
-	size_t currentIdx() const noexcept;
+	ATLAS_API size_t currentIdx() const noexcept;
 	Option<SharedPtr<AST::StrategyBufferOpNode>> getSameFromCache(SharedPtr<AST::StrategyBufferOpNode> a) noexcept;
 	LinAlg::EigenMatrixXd const& getData() const noexcept;
 	LinAlg::EigenVectorXd const& getReturnsScalar() const noexcept;
 	LinAlg::EigenBlockView<double> getMarketReturnsBlock(size_t start_idex, size_t end_idx) const noexcept;
-	LinAlg::EigenConstColView<double> getSlice(size_t column, int row_offset) const noexcept;
-	Option<size_t> getColumnIndex(String const& column) const noexcept;
+	ATLAS_API LinAlg::EigenConstColView<double> getSlice(size_t column, int row_offset) const noexcept;
+	LinAlg::EigenConstStridedView getColumnHistory(size_t column) const noexcept;
+	[[nodiscard]] bool columnChanged(size_t column, int row_offset) const noexcept;
+	ATLAS_API Option<size_t> getColumnIndex(String const& column) const noexcept;
 	Option<size_t> getCloseIndex() const noexcept;
 	Option<String> getDatetimeFormat() const noexcept;
 	size_t getExchangeOffset() const noexcept;
@@ -81,7 +94,8 @@ public:
 		String const& id,
 		SharedPtr<AST::TriggerNode> trigger,
 		size_t lookback,
-		CovarianceType type
+		CovarianceType type,
+		Option<size_t> recompute_interval = std::nullopt
 	) noexcept;
 
 	ATLAS_API void registerModel(SharedPtr<Model::ModelBase> model) noexcept;
@@ -99,6 +113,10 @@ public:
 	ATLAS_API Int64 getCurrentTimestamp() const noexcept;
 	ATLAS_API Vector<Int64> const& getTimestamps() const noexcept;
 	ATLAS_API void enableNodeCache(String const& name, SharedPtr<AST::StrategyBufferOpNode> p, bool eager = false) noexcept;
+	ATLAS_API void enableNodeCaches(HashMap<String, SharedPtr<AST::StrategyBufferOpNode>> const& nodes, bool eager = true) noexcept;
+	ATLAS_API void setCacheBudget(size_t bytes) noexcept;
+	ATLAS_API Option<size_t> getCacheBudget() const noexcept;
+	ATLAS_API Option<size_t> getCacheBudgetRemaining() const noexcept;
 };
 
 }
\ No newline at end of file
@@ -211,6 +211,7 @@ ExchangeMap::cleanup() noexcept
 	{
 		exchange->cleanupCovarianceNodes();
 		exchange->cleanupTriggerNodes();
+		exchange->cleanupCaches();
 	}
 }
 
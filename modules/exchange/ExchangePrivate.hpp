@@ -1,4 +1,6 @@
 #pragma once
+#include <atomic>
+
 #include "unordered_dense.h"
 #include <Eigen/Dense>
 #include "standard/AtlasCore.hpp"
@@ -60,11 +62,21 @@ public:
   Eigen::MatrixXd data;
   Eigen::MatrixXd returns;
   Eigen::VectorXd returns_scalar;
+  // col_count x timestamps mask, true if any asset's value in the column
+  // differs from the previous timestamp
+  Eigen::Matrix<bool, Eigen::Dynamic, Eigen::Dynamic> column_changed;
   Option<String> datetime_format = std::nullopt;
+  // bytes available to caches materialized by the AST optimizer and the
+  // bytes currently held by them, refunded when their strategy is removed
+  Option<size_t> cache_budget = std::nullopt;
+  size_t cache_reserved = 0;
   size_t exchange_offset = 0;
   size_t col_count = 0;
   size_t close_index = 0;
   size_t current_index = 0;
+  // bumped on every step and whenever a grid swaps nodes or parameters in
+  // the middle of one, reads reuse node outputs of the same generation only
+  std::atomic<size_t> read_generation = 0;
 
   ExchangeImpl() noexcept { data = Eigen::MatrixXd::Zero(0, 0); }
 
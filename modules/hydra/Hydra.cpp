@@ -5,6 +5,7 @@
 #include "strategy/Allocator.hpp"
 #include "strategy/MetaStrategy.hpp"
 #include "hydra/Hydra.hpp"
+#include "standard/AtlasSerialize.hpp"
 
 namespace Atlas {
 
@@ -289,6 +290,16 @@ SharedPtr<MetaStrategy> Hydra::pyAddStrategy(SharedPtr<MetaStrategy> Allocator,
   return m_impl->m_strategies.back();
 }
 
+//============================================================================
+Vector<SharedPtr<Strategy>>
+Hydra::pyAddStrategySpec(String const &spec, SharedPtr<MetaStrategy> parent) {
+  auto res = deserialize_strategies(spec, *this, std::move(parent));
+  if (!res) {
+    throw std::exception(res.error().what());
+  }
+  return std::move(*res);
+}
+
 //============================================================================
 SharedPtr<Exchange> Hydra::pyGetExchange(String const &name) const {
   auto res = getExchange(name);
@@ -61,6 +61,10 @@ public:
   pyAddStrategy(SharedPtr<MetaStrategy> Allocator,
                 bool replace_if_exists = false);
 
+  //============================================================================
+  ATLAS_API Vector<SharedPtr<Strategy>>
+  pyAddStrategySpec(String const &spec, SharedPtr<MetaStrategy> parent);
+
   //============================================================================
   ATLAS_API SharedPtr<Exchange> pyGetExchange(String const &name) const;
   ATLAS_API Vector<AtlasException> const& getExceptions() const noexcept;
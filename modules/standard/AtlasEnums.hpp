@@ -24,7 +24,36 @@ inline TradeLimitType &operator&=(TradeLimitType &lhs, unsigned int rhs) {
 }
 
 //============================================================================
-enum class CovarianceType { FULL, INCREMENTAL };
+enum class CovarianceType { FULL, INCREMENTAL, EWMA };
+
+//============================================================================
+enum class EWMAParamType { SPAN = 0, HALF_LIFE = 1, WILDER = 2 };
+
+//============================================================================
+enum class RegressionOutputType {
+  BETA = 0,
+  ALPHA = 1,
+  RESIDUAL_VOLATILITY = 2,
+  R_SQUARED = 3
+};
+
+//============================================================================
+enum class KalmanModelType { LOCAL_LEVEL = 0, LOCAL_TREND = 1 };
+
+//============================================================================
+enum class KalmanOutputType { LEVEL = 0, SLOPE = 1 };
+
+//============================================================================
+enum class MACDOutputType { LINE = 0, SIGNAL = 1, HISTOGRAM = 2 };
+
+//============================================================================
+enum class BollingerOutputType { UPPER = 0, LOWER = 1, PERCENT_B = 2 };
+
+//============================================================================
+enum class ADXOutputType { ADX = 0, PLUS_DI = 1, MINUS_DI = 2 };
+
+//============================================================================
+enum class CrossSectionOutputType { RESIDUAL = 0, FITTED = 1, FACTOR_RETURN = 2 };
 
 //============================================================================
 enum class WeightScaleType {
@@ -33,6 +33,8 @@ using EigenConstColView = Eigen::Block<Eigen::Matrix<T, -1, -1, 0, -1, -1>, -1,
  template <typename T>
 using EigenConstRowView = Eigen::Block<Eigen::Matrix<T, -1, -1, 0, -1, -1>, 1, -1, false>;
 
+ using EigenConstStridedView = Eigen::Map<const EigenMatrixXd, 0, Eigen::OuterStride<>>;
+
  template <typename T>
 using EigenBlockView = Eigen::Block<Eigen::Matrix<T, -1, -1, 0, -1, -1>, -1, -1, true>;
 
@@ -12,6 +12,18 @@
 #include "hydra/Hydra.hpp"
 #include "exchange/Exchange.hpp"
 #include "exchange/ExchangeMap.hpp"
+#include "ast/AllocationNode.hpp"
+#include "ast/AssetLogical.hpp"
+#include "ast/AssetNode.hpp"
+#include "ast/ExchangeNode.hpp"
+#include "ast/GroupNode.hpp"
+#include "ast/HelperNodes.hpp"
+#include "ast/IndicatorNode.hpp"
+#include "ast/ObserverNode.hpp"
+#include "ast/RegressionNode.hpp"
+#include "ast/StrategyNode.hpp"
+#include "strategy/MetaStrategy.hpp"
+#include "strategy/Strategy.hpp"
 
 namespace Atlas 
 {
@@ -182,4 +194,930 @@ serialize_exchange_map(
 }
 
 
-}
\ No newline at end of file
+
+//============================================================================
+// A strategy spec is a json object, or a list of them, of the form
+//
+//	{
+//		"name": "momentum",
+//		"exchange": "test",
+//		"portfolio_weight": 1.0,
+//		"warmup": 20,
+//		"trigger": {"type": "periodic", "frequency": 5},
+//		"nodes": {
+//			"close": {"type": "read", "column": "close"},
+//			"prev": {"type": "read", "column": "close", "offset": -1},
+//			"change": {"type": "op", "op": "subtract", "left": "close", "right": "prev"},
+//			"mean": {"type": "observer", "observer": "mean", "parent": "change", "window": 20},
+//			"ev": {"type": "exchange_view", "parent": "mean",
+//				"filters": [{"type": "greater_than", "value": 0.0}]}
+//		},
+//		"allocation": {"signal": "ev", "type": "uniform"}
+//	}
+//
+// Nodes refer to their inputs by name and may be listed in any order.
+// Strategies are all built before any is added so a bad spec adds nothing.
+// Equal nodes are built once and shared by the strategies of a spec.
+//============================================================================
+
+namespace
+{
+
+//============================================================================
+struct SpecContext
+{
+	SharedPtr<Exchange> exchange;
+	rapidjson::Value const& nodes;
+	HashMap<String, SharedPtr<AST::StrategyBufferOpNode>> built;
+	Set<String> building;
+
+	// nodes built by every strategy of the spec on this exchange, an equal
+	// node is taken from here so inputs are the same pointers across
+	// strategies and the observers over them dedup on the exchange
+	Vector<SharedPtr<AST::StrategyBufferOpNode>>& shared;
+};
+
+
+//============================================================================
+Result<String, AtlasException>
+spec_string(rapidjson::Value const& spec, char const* key) noexcept
+{
+	if (!spec.HasMember(key) || !spec[key].IsString())
+	{
+		return Err(AtlasException("Expected string " + String(key)));
+	}
+	return String(spec[key].GetString());
+}
+
+
+//============================================================================
+Result<double, AtlasException>
+spec_double(rapidjson::Value const& spec, char const* key) noexcept
+{
+	if (!spec.HasMember(key) || !spec[key].IsNumber())
+	{
+		return Err(AtlasException("Expected number " + String(key)));
+	}
+	return spec[key].GetDouble();
+}
+
+
+//============================================================================
+Option<double>
+spec_optional_double(rapidjson::Value const& spec, char const* key) noexcept
+{
+	if (!spec.HasMember(key) || !spec[key].IsNumber())
+	{
+		return std::nullopt;
+	}
+	return spec[key].GetDouble();
+}
+
+
+//============================================================================
+template <typename T>
+Result<T, AtlasException>
+spec_enum(
+	String const& value,
+	std::initializer_list<std::pair<char const*, T>> values) noexcept
+{
+	for (auto const& [name, type] : values)
+	{
+		if (value == name)
+		{
+			return type;
+		}
+	}
+	return Err(AtlasException("Unknown spec value: " + value));
+}
+
+
+//============================================================================
+Result<AST::AssetOpType, AtlasException>
+spec_op(rapidjson::Value const& spec) noexcept
+{
+	ATLAS_ASSIGN_OR_RETURN(op, spec_string(spec, "op"));
+	return spec_enum<AST::AssetOpType>(op, {
+		{"add", AST::AssetOpType::ADD},
+		{"subtract", AST::AssetOpType::SUBTRACT},
+		{"multiply", AST::AssetOpType::MULTIPLY},
+		{"divide", AST::AssetOpType::DIVIDE}
+	});
+}
+
+
+//============================================================================
+Result<SharedPtr<AST::StrategyBufferOpNode>, AtlasException>
+spec_node(SpecContext& ctx, String const& name) noexcept;
+
+
+//============================================================================
+Result<SharedPtr<AST::StrategyBufferOpNode>, AtlasException>
+spec_input(SpecContext& ctx, rapidjson::Value const& spec, char const* key) noexcept
+{
+	ATLAS_ASSIGN_OR_RETURN(name, spec_string(spec, key));
+	return spec_node(ctx, name);
+}
+
+
+//============================================================================
+Result<Option<size_t>, AtlasException>
+spec_benchmark(SpecContext& ctx, rapidjson::Value const& spec) noexcept
+{
+	// optional asset id whose lane of the right input is used for every asset
+	if (!spec.HasMember("benchmark"))
+	{
+		return Option<size_t>(std::nullopt);
+	}
+	ATLAS_ASSIGN_OR_RETURN(benchmark_id, spec_string(spec, "benchmark"));
+	auto const& asset_map = ctx.exchange->getAssetMap();
+	auto it = asset_map.find(benchmark_id);
+	if (it == asset_map.end())
+	{
+		return Err(AtlasException("Unknown benchmark asset: " + benchmark_id));
+	}
+	return Option<size_t>(it->second);
+}
+
+
+//============================================================================
+Result<SharedPtr<AST::StrategyBufferOpNode>, AtlasException>
+spec_ewma_observer(SpecContext& ctx, rapidjson::Value const& spec, String const& kind) noexcept
+{
+	// decay given as "span" or "half_life" in place of a window
+	EWMAParamType param_type = EWMAParamType::SPAN;
+	auto param = spec_optional_double(spec, "span");
+	if (!param)
+	{
+		param = spec_optional_double(spec, "half_life");
+		param_type = EWMAParamType::HALF_LIFE;
+	}
+	if (!param || *param <= 0)
+	{
+		return Err(AtlasException("EWMA observer requires a positive span or half_life"));
+	}
+	SharedPtr<AST::AssetObserverNode> observer;
+	if (kind == "ewma_covariance")
+	{
+		ATLAS_ASSIGN_OR_RETURN(left, spec_input(ctx, spec, "left"));
+		ATLAS_ASSIGN_OR_RETURN(right, spec_input(ctx, spec, "right"));
+		ATLAS_ASSIGN_OR_RETURN(benchmark, spec_benchmark(ctx, spec));
+		observer = std::make_shared<AST::EWMACovarianceObserverNode>(std::nullopt, left, right, *param, param_type, benchmark);
+		return ctx.exchange->registerObserver(std::move(observer));
+	}
+
+	ATLAS_ASSIGN_OR_RETURN(parent, spec_input(ctx, spec, "parent"));
+	if (kind == "ewma_mean")
+	{
+		observer = std::make_shared<AST::EWMAMeanObserverNode>(std::nullopt, parent, *param, param_type);
+	}
+	else if (kind == "ewma_variance")
+	{
+		observer = std::make_shared<AST::EWMAVarianceObserverNode>(std::nullopt, parent, *param, param_type);
+	}
+	else if (kind == "ewma_volatility")
+	{
+		observer = std::make_shared<AST::EWMAVolatilityObserverNode>(std::nullopt, parent, *param, param_type);
+	}
+	else if (kind == "ewma_zscore")
+	{
+		observer = std::make_shared<AST::EWMAZScoreObserverNode>(std::nullopt, parent, *param, param_type);
+	}
+	else
+	{
+		return Err(AtlasException("Unknown observer: " + kind));
+	}
+	return ctx.exchange->registerObserver(std::move(observer));
+}
+
+
+//============================================================================
+Result<SharedPtr<AST::StrategyBufferOpNode>, AtlasException>
+spec_kalman_observer(SpecContext& ctx, rapidjson::Value const& spec, String const& kind) noexcept
+{
+	// noise variances in place of a window, the slope noise only applies to
+	// the local trend model
+	ATLAS_ASSIGN_OR_RETURN(parent, spec_input(ctx, spec, "parent"));
+	ATLAS_ASSIGN_OR_RETURN(process_noise, spec_double(spec, "process_noise"));
+	ATLAS_ASSIGN_OR_RETURN(observation_noise, spec_double(spec, "observation_noise"));
+	double slope_noise = spec_optional_double(spec, "slope_noise").value_or(0.0);
+	if (process_noise < 0 || observation_noise <= 0 || slope_noise < 0)
+	{
+		return Err(AtlasException("Kalman filter requires non negative noise and positive observation_noise"));
+	}
+	KalmanOutputType output = KalmanOutputType::LEVEL;
+	if (spec.HasMember("output"))
+	{
+		ATLAS_ASSIGN_OR_RETURN(output_name, spec_string(spec, "output"));
+		ATLAS_ASSIGN_OR_RETURN(output_type, spec_enum<KalmanOutputType>(output_name, {
+			{"level", KalmanOutputType::LEVEL},
+			{"slope", KalmanOutputType::SLOPE}
+		}));
+		output = output_type;
+	}
+	auto model = kind == "local_trend" ? KalmanModelType::LOCAL_TREND : KalmanModelType::LOCAL_LEVEL;
+	SharedPtr<AST::AssetObserverNode> observer = std::make_shared<AST::KalmanFilterObserverNode>(
+		std::nullopt, parent, model, process_noise, observation_noise, slope_noise, output
+	);
+	return ctx.exchange->registerObserver(std::move(observer));
+}
+
+
+//============================================================================
+Result<SharedPtr<AST::StrategyBufferOpNode>, AtlasException>
+spec_indicator_observer(SpecContext& ctx, rapidjson::Value const& spec, String const& kind) noexcept
+{
+	// bar indicators read "high", "low" and "close", the others a "parent"
+	SharedPtr<AST::AssetObserverNode> observer;
+	if (kind == "macd")
+	{
+		ATLAS_ASSIGN_OR_RETURN(parent, spec_input(ctx, spec, "parent"));
+		auto fast = spec_optional_double(spec, "fast").value_or(12);
+		auto slow = spec_optional_double(spec, "slow").value_or(26);
+		auto signal = spec_optional_double(spec, "signal").value_or(9);
+		if (fast < 1 || slow < 1 || signal < 1)
+		{
+			return Err(AtlasException("MACD spans must be positive"));
+		}
+		MACDOutputType output = MACDOutputType::LINE;
+		if (spec.HasMember("output"))
+		{
+			ATLAS_ASSIGN_OR_RETURN(output_name, spec_string(spec, "output"));
+			ATLAS_ASSIGN_OR_RETURN(output_type, spec_enum<MACDOutputType>(output_name, {
+				{"line", MACDOutputType::LINE},
+				{"signal", MACDOutputType::SIGNAL},
+				{"histogram", MACDOutputType::HISTOGRAM}
+			}));
+			output = output_type;
+		}
+		observer = std::make_shared<AST::MacdObserverNode>(
+			std::nullopt, parent, static_cast<size_t>(fast), static_cast<size_t>(slow), static_cast<size_t>(signal), output
+		);
+		return ctx.exchange->registerObserver(std::move(observer));
+	}
+	if (kind == "true_range")
+	{
+		ATLAS_ASSIGN_OR_RETURN(high, spec_input(ctx, spec, "high"));
+		ATLAS_ASSIGN_OR_RETURN(low, spec_input(ctx, spec, "low"));
+		ATLAS_ASSIGN_OR_RETURN(close, spec_input(ctx, spec, "close"));
+		observer = std::make_shared<AST::TrueRangeObserverNode>(std::nullopt, high, low, close);
+		return ctx.exchange->registerObserver(std::move(observer));
+	}
+
+	ATLAS_ASSIGN_OR_RETURN(window_value, spec_double(spec, "window"));
+	if (window_value < 1)
+	{
+		return Err(AtlasException("Indicator window must be positive"));
+	}
+	size_t window = static_cast<size_t>(window_value);
+	if (kind == "rsi")
+	{
+		ATLAS_ASSIGN_OR_RETURN(parent, spec_input(ctx, spec, "parent"));
+		observer = std::make_shared<AST::RsiObserverNode>(std::nullopt, parent, window);
+	}
+	else if (kind == "bollinger")
+	{
+		ATLAS_ASSIGN_OR_RETURN(parent, spec_input(ctx, spec, "parent"));
+		double num_std = spec_optional_double(spec, "num_std").value_or(2.0);
+		BollingerOutputType output = BollingerOutputType::PERCENT_B;
+		if (spec.HasMember("output"))
+		{
+			ATLAS_ASSIGN_OR_RETURN(output_name, spec_string(spec, "output"));
+			ATLAS_ASSIGN_OR_RETURN(output_type, spec_enum<BollingerOutputType>(output_name, {
+				{"upper", BollingerOutputType::UPPER},
+				{"lower", BollingerOutputType::LOWER},
+				{"percent_b", BollingerOutputType::PERCENT_B}
+			}));
+			output = output_type;
+		}
+		observer = std::make_shared<AST::BollingerObserverNode>(std::nullopt, parent, window, num_std, output);
+	}
+	else
+	{
+		ATLAS_ASSIGN_OR_RETURN(high, spec_input(ctx, spec, "high"));
+		ATLAS_ASSIGN_OR_RETURN(low, spec_input(ctx, spec, "low"));
+		ATLAS_ASSIGN_OR_RETURN(close, spec_input(ctx, spec, "close"));
+		if (kind == "stochastic")
+		{
+			observer = std::make_shared<AST::StochasticObserverNode>(std::nullopt, high, low, close, window);
+		}
+		else
+		{
+			ADXOutputType output = ADXOutputType::ADX;
+			if (spec.HasMember("output"))
+			{
+				ATLAS_ASSIGN_OR_RETURN(output_name, spec_string(spec, "output"));
+				ATLAS_ASSIGN_OR_RETURN(output_type, spec_enum<ADXOutputType>(output_name, {
+					{"adx", ADXOutputType::ADX},
+					{"plus_di", ADXOutputType::PLUS_DI},
+					{"minus_di", ADXOutputType::MINUS_DI}
+				}));
+				output = output_type;
+			}
+			observer = std::make_shared<AST::AdxObserverNode>(std::nullopt, high, low, close, window, output);
+		}
+	}
+	return ctx.exchange->registerObserver(std::move(observer));
+}
+
+
+//============================================================================
+Result<SharedPtr<AST::StrategyBufferOpNode>, AtlasException>
+spec_observer(SpecContext& ctx, rapidjson::Value const& spec) noexcept
+{
+	ATLAS_ASSIGN_OR_RETURN(kind, spec_string(spec, "observer"));
+	if (kind.starts_with("ewma_"))
+	{
+		return spec_ewma_observer(ctx, spec, kind);
+	}
+	if (kind == "local_level" || kind == "local_trend")
+	{
+		return spec_kalman_observer(ctx, spec, kind);
+	}
+	if (kind == "rsi" || kind == "macd" || kind == "bollinger" || kind == "stochastic" || kind == "adx" || kind == "true_range")
+	{
+		return spec_indicator_observer(ctx, spec, kind);
+	}
+	ATLAS_ASSIGN_OR_RETURN(window_value, spec_double(spec, "window"));
+	if (window_value < 1)
+	{
+		return Err(AtlasException("Observer window must be positive"));
+	}
+	size_t window = static_cast<size_t>(window_value);
+	SharedPtr<AST::AssetObserverNode> observer;
+	if (kind == "covariance" || kind == "correlation")
+	{
+		ATLAS_ASSIGN_OR_RETURN(left, spec_input(ctx, spec, "left"));
+		ATLAS_ASSIGN_OR_RETURN(right, spec_input(ctx, spec, "right"));
+		if (kind == "covariance")
+		{
+			observer = std::make_shared<AST::CovarianceObserverNode>(std::nullopt, left, right, window);
+		}
+		else
+		{
+			observer = std::make_shared<AST::CorrelationObserverNode>(std::nullopt, left, right, window);
+		}
+	}
+	else if (kind == "beta" || kind == "alpha" || kind == "residual_volatility" || kind == "r_squared")
+	{
+		// regression of left on the right input, or on one benchmark asset of it
+		ATLAS_ASSIGN_OR_RETURN(left, spec_input(ctx, spec, "left"));
+		ATLAS_ASSIGN_OR_RETURN(right, spec_input(ctx, spec, "right"));
+		ATLAS_ASSIGN_OR_RETURN(benchmark, spec_benchmark(ctx, spec));
+		ATLAS_ASSIGN_OR_RETURN(output, spec_enum<RegressionOutputType>(kind, {
+			{"beta", RegressionOutputType::BETA},
+			{"alpha", RegressionOutputType::ALPHA},
+			{"residual_volatility", RegressionOutputType::RESIDUAL_VOLATILITY},
+			{"r_squared", RegressionOutputType::R_SQUARED}
+		}));
+		observer = std::make_shared<AST::RollingRegressionObserverNode>(std::nullopt, left, right, window, output, benchmark);
+	}
+	else
+	{
+		ATLAS_ASSIGN_OR_RETURN(parent, spec_input(ctx, spec, "parent"));
+		if (kind == "sum")
+		{
+			observer = std::make_shared<AST::SumObserverNode>(std::nullopt, parent, window);
+		}
+		else if (kind == "mean")
+		{
+			observer = std::make_shared<AST::MeanObserverNode>(std::nullopt, parent, window);
+		}
+		else if (kind == "max")
+		{
+			observer = std::make_shared<AST::MaxObserverNode>(std::nullopt, parent, window);
+		}
+		else if (kind == "ts_argmax")
+		{
+			observer = std::make_shared<AST::TsArgMaxObserverNode>(std::nullopt, parent, window);
+		}
+		else if (kind == "min")
+		{
+			observer = std::make_shared<AST::MinObserverNode>(std::nullopt, parent, window);
+		}
+		else if (kind == "ts_argmin")
+		{
+			observer = std::make_shared<AST::TsArgMinObserverNode>(std::nullopt, parent, window);
+		}
+		else if (kind == "variance")
+		{
+			observer = std::make_shared<AST::VarianceObserverNode>(std::nullopt, parent, window);
+		}
+		else if (kind == "linear_decay")
+		{
+			observer = std::make_shared<AST::LinearDecayNode>(std::nullopt, parent, window);
+		}
+		else if (kind == "skewness")
+		{
+			observer = std::make_shared<AST::SkewnessObserverNode>(std::nullopt, parent, window);
+		}
+		else if (kind == "kurtosis")
+		{
+			observer = std::make_shared<AST::KurtosisObserverNode>(std::nullopt, parent, window);
+		}
+		else if (kind == "quantile")
+		{
+			ATLAS_ASSIGN_OR_RETURN(quantile, spec_double(spec, "quantile"));
+			observer = std::make_shared<AST::QuantileObserverNode>(std::nullopt, parent, window, quantile);
+		}
+		else if (kind == "median")
+		{
+			observer = std::make_shared<AST::MedianObserverNode>(std::nullopt, parent, window);
+		}
+		else if (kind == "ts_rank")
+		{
+			observer = std::make_shared<AST::TsRankObserverNode>(std::nullopt, parent, window);
+		}
+		else
+		{
+			return Err(AtlasException("Unknown observer: " + kind));
+		}
+	}
+	// an equal observer already on the exchange is returned in its place
+	return ctx.exchange->registerObserver(std::move(observer));
+}
+
+
+//============================================================================
+Result<SharedPtr<AST::StrategyBufferOpNode>, AtlasException>
+spec_exchange_view(SpecContext& ctx, rapidjson::Value const& spec) noexcept
+{
+	ATLAS_ASSIGN_OR_RETURN(parent, spec_input(ctx, spec, "parent"));
+	Option<SharedPtr<AST::ExchangeViewNode>> left_view = std::nullopt;
+	if (spec.HasMember("left_view"))
+	{
+		ATLAS_ASSIGN_OR_RETURN(left, spec_input(ctx, spec, "left_view"));
+		if (left->getType() != AST::NodeType::EXCHANGE_VIEW)
+		{
+			return Err(AtlasException("left_view must be an exchange_view"));
+		}
+		left_view = std::static_pointer_cast<AST::ExchangeViewNode>(left);
+	}
+	auto view = std::make_shared<AST::ExchangeViewNode>(ctx.exchange, parent, left_view);
+	if (spec.HasMember("filters"))
+	{
+		if (!spec["filters"].IsArray())
+		{
+			return Err(AtlasException("Expected filters to be an array"));
+		}
+		for (auto const& filter : spec["filters"].GetArray())
+		{
+			ATLAS_ASSIGN_OR_RETURN(filter_name, spec_string(filter, "type"));
+			ATLAS_ASSIGN_OR_RETURN(filter_type, spec_enum<AST::ExchangeViewFilterType>(filter_name, {
+				{"greater_than", AST::ExchangeViewFilterType::GREATER_THAN},
+				{"less_than", AST::ExchangeViewFilterType::LESS_THAN},
+				{"equal_to", AST::ExchangeViewFilterType::EQUAL_TO}
+			}));
+			ATLAS_ASSIGN_OR_RETURN(value, spec_double(filter, "value"));
+			view->setFilter(filter_type, value, spec_optional_double(filter, "value_inplace"));
+		}
+	}
+	if (spec.HasMember("assets"))
+	{
+		if (!spec["assets"].IsArray())
+		{
+			return Err(AtlasException("Expected assets to be an array"));
+		}
+		Vector<String> assets;
+		for (auto const& asset : spec["assets"].GetArray())
+		{
+			if (!asset.IsString())
+			{
+				return Err(AtlasException("Expected assets to be strings"));
+			}
+			assets.push_back(asset.GetString());
+		}
+		ATLAS_ASSIGN_OR_RETURN(res, view->setAssets(assets));
+	}
+	if (spec.HasMember("as_signal") && spec["as_signal"].IsBool())
+	{
+		view->asSignal(spec["as_signal"].GetBool());
+	}
+	return view;
+}
+
+
+//============================================================================
+Result<SharedPtr<AST::StrategyBufferOpNode>, AtlasException>
+spec_group(SpecContext& ctx, rapidjson::Value const& spec) noexcept
+{
+	ATLAS_ASSIGN_OR_RETURN(parent, spec_input(ctx, spec, "parent"));
+	ATLAS_ASSIGN_OR_RETURN(op_name, spec_string(spec, "op"));
+	ATLAS_ASSIGN_OR_RETURN(op, spec_enum<AST::GroupOpType>(op_name, {
+		{"demean", AST::GroupOpType::DEMEAN},
+		{"zscore", AST::GroupOpType::ZSCORE},
+		{"rank", AST::GroupOpType::RANK},
+		{"winsorize", AST::GroupOpType::WINSORIZE}
+	}));
+	double param = spec_optional_double(spec, "param").value_or(3.0);
+	if (!spec.HasMember("groups"))
+	{
+		return Err(AtlasException("Missing spec key: groups"));
+	}
+	if (spec["groups"].IsString())
+	{
+		ATLAS_ASSIGN_OR_RETURN(group_node, spec_input(ctx, spec, "groups"));
+		return AST::GroupNormalizeNode::make(parent, group_node, op, param);
+	}
+	if (!spec["groups"].IsArray())
+	{
+		return Err(AtlasException("Expected groups to be an array or a node name"));
+	}
+	Vector<Int64> groups;
+	for (auto const& group : spec["groups"].GetArray())
+	{
+		if (!group.IsInt64())
+		{
+			return Err(AtlasException("Expected group ids to be integers"));
+		}
+		groups.push_back(group.GetInt64());
+	}
+	ATLAS_ASSIGN_OR_RETURN(node, AST::GroupNormalizeNode::make(parent, std::move(groups), op, param));
+	return node;
+}
+
+
+//============================================================================
+Result<SharedPtr<AST::StrategyBufferOpNode>, AtlasException>
+spec_regression(SpecContext& ctx, rapidjson::Value const& spec) noexcept
+{
+	ATLAS_ASSIGN_OR_RETURN(parent, spec_input(ctx, spec, "parent"));
+	if (!spec.HasMember("factors") || !spec["factors"].IsArray())
+	{
+		return Err(AtlasException("Expected factors to be an array of node names"));
+	}
+	Vector<SharedPtr<AST::StrategyBufferOpNode>> factors;
+	for (auto const& factor : spec["factors"].GetArray())
+	{
+		if (!factor.IsString())
+		{
+			return Err(AtlasException("Expected factors to be an array of node names"));
+		}
+		ATLAS_ASSIGN_OR_RETURN(node, spec_node(ctx, factor.GetString()));
+		factors.push_back(node);
+	}
+	auto output = CrossSectionOutputType::RESIDUAL;
+	if (spec.HasMember("output"))
+	{
+		ATLAS_ASSIGN_OR_RETURN(output_name, spec_string(spec, "output"));
+		ATLAS_ASSIGN_OR_RETURN(output_type, spec_enum<CrossSectionOutputType>(output_name, {
+			{"residual", CrossSectionOutputType::RESIDUAL},
+			{"fitted", CrossSectionOutputType::FITTED},
+			{"factor_return", CrossSectionOutputType::FACTOR_RETURN}
+		}));
+		output = output_type;
+	}
+	bool intercept = true;
+	if (spec.HasMember("intercept") && spec["intercept"].IsBool())
+	{
+		intercept = spec["intercept"].GetBool();
+	}
+	size_t factor = static_cast<size_t>(spec_optional_double(spec, "factor").value_or(0));
+	Option<SharedPtr<AST::StrategyBufferOpNode>> weights = std::nullopt;
+	if (spec.HasMember("weights"))
+	{
+		ATLAS_ASSIGN_OR_RETURN(weight_node, spec_input(ctx, spec, "weights"));
+		weights = weight_node;
+	}
+	ATLAS_ASSIGN_OR_RETURN(node, AST::CrossSectionRegressionNode::make(
+		parent, std::move(factors), output, intercept, factor, weights
+	));
+	return node;
+}
+
+
+//============================================================================
+Result<SharedPtr<AST::StrategyBufferOpNode>, AtlasException>
+spec_build(SpecContext& ctx, rapidjson::Value const& spec) noexcept
+{
+	ATLAS_ASSIGN_OR_RETURN(type, spec_string(spec, "type"));
+	if (type == "read")
+	{
+		ATLAS_ASSIGN_OR_RETURN(column, spec_string(spec, "column"));
+		if (spec.HasMember("offset") && !spec["offset"].IsNumber())
+		{
+			return Err(AtlasException("Expected number offset"));
+		}
+		double offset = spec_optional_double(spec, "offset").value_or(0);
+		if (!(offset <= 0) || offset != std::floor(offset) || offset < std::numeric_limits<int>::min())
+		{
+			return Err(AtlasException("Expected offset to be a non positive integer"));
+		}
+		ATLAS_ASSIGN_OR_RETURN(read, AST::AssetReadNode::make(column, static_cast<int>(offset), *ctx.exchange));
+		return read;
+	}
+	if (type == "scaler")
+	{
+		ATLAS_ASSIGN_OR_RETURN(parent, spec_input(ctx, spec, "parent"));
+		ATLAS_ASSIGN_OR_RETURN(op, spec_op(spec));
+		ATLAS_ASSIGN_OR_RETURN(scale, spec_double(spec, "scale"));
+		return std::make_shared<AST::AssetScalerNode>(parent, op, scale);
+	}
+	if (type == "op")
+	{
+		ATLAS_ASSIGN_OR_RETURN(left, spec_input(ctx, spec, "left"));
+		ATLAS_ASSIGN_OR_RETURN(right, spec_input(ctx, spec, "right"));
+		ATLAS_ASSIGN_OR_RETURN(op, spec_op(spec));
+		ATLAS_ASSIGN_OR_RETURN(node, AST::AssetOpNode::make(left, right, op));
+		return node;
+	}
+	if (type == "function")
+	{
+		ATLAS_ASSIGN_OR_RETURN(parent, spec_input(ctx, spec, "parent"));
+		ATLAS_ASSIGN_OR_RETURN(func_name, spec_string(spec, "function"));
+		ATLAS_ASSIGN_OR_RETURN(func_type, spec_enum<AST::AssetFunctionType>(func_name, {
+			{"sign", AST::AssetFunctionType::SIGN},
+			{"power", AST::AssetFunctionType::POWER},
+			{"abs", AST::AssetFunctionType::ABS},
+			{"log", AST::AssetFunctionType::LOG}
+		}));
+		return std::make_shared<AST::AssetFunctionNode>(
+			parent, func_type, spec_optional_double(spec, "param")
+		);
+	}
+	if (type == "if")
+	{
+		ATLAS_ASSIGN_OR_RETURN(left, spec_input(ctx, spec, "left"));
+		ATLAS_ASSIGN_OR_RETURN(right, spec_input(ctx, spec, "right"));
+		ATLAS_ASSIGN_OR_RETURN(comp_name, spec_string(spec, "comp"));
+		ATLAS_ASSIGN_OR_RETURN(comp_type, spec_enum<AST::AssetCompType>(comp_name, {
+			{"equal", AST::AssetCompType::EQUAL},
+			{"not_equal", AST::AssetCompType::NOT_EQUAL},
+			{"greater", AST::AssetCompType::GREATER},
+			{"less", AST::AssetCompType::LESS},
+			{"greater_equal", AST::AssetCompType::GREATER_EQUAL},
+			{"less_equal", AST::AssetCompType::LESS_EQUAL}
+		}));
+		return std::make_shared<AST::AssetIfNode>(left, comp_type, right);
+	}
+	if (type == "comp")
+	{
+		ATLAS_ASSIGN_OR_RETURN(left, spec_input(ctx, spec, "left"));
+		ATLAS_ASSIGN_OR_RETURN(right, spec_input(ctx, spec, "right"));
+		ATLAS_ASSIGN_OR_RETURN(true_eval, spec_input(ctx, spec, "true"));
+		ATLAS_ASSIGN_OR_RETURN(false_eval, spec_input(ctx, spec, "false"));
+		ATLAS_ASSIGN_OR_RETURN(logical_name, spec_string(spec, "logical"));
+		ATLAS_ASSIGN_OR_RETURN(logical_type, spec_enum<LogicalType>(logical_name, {
+			{"and", LogicalType::AND},
+			{"or", LogicalType::OR}
+		}));
+		return std::make_shared<AST::AssetCompNode>(
+			left, logical_type, right, true_eval, false_eval
+		);
+	}
+	if (type == "lag")
+	{
+		ATLAS_ASSIGN_OR_RETURN(parent, spec_input(ctx, spec, "parent"));
+		ATLAS_ASSIGN_OR_RETURN(lag, spec_double(spec, "lag"));
+		if (lag < 0)
+		{
+			return Err(AtlasException("Lag must not be negative"));
+		}
+		return parent->lag(static_cast<size_t>(lag));
+	}
+	if (type == "observer")
+	{
+		return spec_observer(ctx, spec);
+	}
+	if (type == "exchange_view")
+	{
+		return spec_exchange_view(ctx, spec);
+	}
+	if (type == "group")
+	{
+		return spec_group(ctx, spec);
+	}
+	if (type == "regression")
+	{
+		return spec_regression(ctx, spec);
+	}
+	return Err(AtlasException("Unknown node type: " + type));
+}
+
+
+//============================================================================
+Result<SharedPtr<AST::StrategyBufferOpNode>, AtlasException>
+spec_node(SpecContext& ctx, String const& name) noexcept
+{
+	if (auto it = ctx.built.find(name); it != ctx.built.end())
+	{
+		return it->second;
+	}
+	if (!ctx.nodes.HasMember(name.c_str()) || !ctx.nodes[name.c_str()].IsObject())
+	{
+		return Err(AtlasException("Unknown node: " + name));
+	}
+	if (!ctx.building.insert(name).second)
+	{
+		return Err(AtlasException("Cycle in spec at node: " + name));
+	}
+	auto node = spec_build(ctx, ctx.nodes[name.c_str()]);
+	ctx.building.erase(name);
+	if (!node)
+	{
+		return Err(AtlasException(name + ": " + node.error().what()));
+	}
+
+	// reuse an equal node whose cache is already held by the exchange or
+	// that an earlier strategy of the spec built
+	auto built = *node;
+	if (auto same = ctx.exchange->getSameFromCache(built))
+	{
+		built = *same;
+	}
+	else
+	{
+		auto it = std::find_if(ctx.shared.begin(), ctx.shared.end(), [&](auto const& other) {
+			return other == built || other->isSame(built.get());
+		});
+		if (it != ctx.shared.end())
+		{
+			built = *it;
+		}
+		else
+		{
+			ctx.shared.push_back(built);
+		}
+	}
+	ctx.built[name] = built;
+	return built;
+}
+
+
+//============================================================================
+Result<SharedPtr<AST::AllocationBaseNode>, AtlasException>
+spec_allocation(SpecContext& ctx, rapidjson::Value const& spec) noexcept
+{
+	double epsilon = spec_optional_double(spec, "epsilon").value_or(0.0);
+	ATLAS_ASSIGN_OR_RETURN(type_name, spec_string(spec, "type"));
+	if (type_name == "fixed")
+	{
+		if (!spec.HasMember("weights") || !spec["weights"].IsObject())
+		{
+			return Err(AtlasException("Expected weights for fixed allocation"));
+		}
+		Vector<std::pair<String, double>> weights;
+		for (auto const& weight : spec["weights"].GetObject())
+		{
+			weights.push_back({weight.name.GetString(), weight.value.GetDouble()});
+		}
+		ATLAS_ASSIGN_OR_RETURN(fixed, AST::FixedAllocationNode::make(weights, ctx.exchange.get(), epsilon));
+		return fixed;
+	}
+	ATLAS_ASSIGN_OR_RETURN(type, spec_enum<AST::AllocationType>(type_name, {
+		{"uniform", AST::AllocationType::UNIFORM},
+		{"conditional_split", AST::AllocationType::CONDITIONAL_SPLIT},
+		{"nlargest", AST::AllocationType::NLARGEST},
+		{"nsmallest", AST::AllocationType::NSMALLEST},
+		{"nextreme", AST::AllocationType::NEXTREME}
+	}));
+	ATLAS_ASSIGN_OR_RETURN(signal, spec_input(ctx, spec, "signal"));
+	ATLAS_ASSIGN_OR_RETURN(allocation, AST::AllocationNode::make(
+		signal, type, spec_optional_double(spec, "alloc_param"), epsilon
+	));
+	return allocation;
+}
+
+
+//============================================================================
+Result<SharedPtr<Strategy>, AtlasException>
+spec_strategy(
+	rapidjson::Value const& spec,
+	Hydra& hydra,
+	SharedPtr<MetaStrategy> const& parent,
+	HashMap<String, Vector<SharedPtr<AST::StrategyBufferOpNode>>>& shared) noexcept
+{
+	ATLAS_ASSIGN_OR_RETURN(name, spec_string(spec, "name"));
+	ATLAS_ASSIGN_OR_RETURN(exchange_id, spec_string(spec, "exchange"));
+	ATLAS_ASSIGN_OR_RETURN(exchange, hydra.getExchange(exchange_id));
+	if (!spec.HasMember("nodes") || !spec["nodes"].IsObject())
+	{
+		return Err(AtlasException(name + ": expected nodes object"));
+	}
+	if (!spec.HasMember("allocation") || !spec["allocation"].IsObject())
+	{
+		return Err(AtlasException(name + ": expected allocation object"));
+	}
+
+	SpecContext ctx{exchange, spec["nodes"], {}, {}, shared[exchange_id]};
+	auto allocation = spec_allocation(ctx, spec["allocation"]);
+	if (!allocation)
+	{
+		return Err(AtlasException(name + ": " + allocation.error().what()));
+	}
+	auto ast = std::make_shared<AST::StrategyNode>(*allocation);
+
+	if (spec.HasMember("trigger") && spec["trigger"].IsObject())
+	{
+		auto const& trigger = spec["trigger"];
+		ATLAS_ASSIGN_OR_RETURN(trigger_type, spec_string(trigger, "type"));
+		try
+		{
+			if (trigger_type == "periodic")
+			{
+				ATLAS_ASSIGN_OR_RETURN(frequency, spec_double(trigger, "frequency"));
+				ast->setTrigger(AST::PeriodicTriggerNode::make(exchange, static_cast<size_t>(frequency)));
+			}
+			else if (trigger_type == "monthly")
+			{
+				bool eom = trigger.HasMember("eom") && trigger["eom"].IsBool() && trigger["eom"].GetBool();
+				ast->setTrigger(AST::StrategyMonthlyRunnerNode::make(exchange, eom));
+			}
+			else
+			{
+				return Err(AtlasException(name + ": unknown trigger " + trigger_type));
+			}
+		}
+		catch (std::exception const& e)
+		{
+			return Err(AtlasException(name + ": " + e.what()));
+		}
+	}
+	if (auto warmup = spec_optional_double(spec, "warmup"))
+	{
+		ast->setWarmupOverride(static_cast<size_t>(*warmup));
+	}
+
+	double portfolio_weight = spec_optional_double(spec, "portfolio_weight").value_or(1.0);
+	return std::make_shared<SpecStrategy>(name, exchange, parent, portfolio_weight, ast);
+}
+
+}
+
+
+//============================================================================
+Result<Vector<SharedPtr<Strategy>>, AtlasException>
+deserialize_strategies(
+	String const& spec,
+	Hydra& hydra,
+	SharedPtr<MetaStrategy> parent
+) noexcept
+{
+	rapidjson::Document doc;
+	doc.Parse(spec.c_str());
+	if (doc.HasParseError())
+	{
+		return Err(AtlasException("Failed to parse strategy spec"));
+	}
+	rapidjson::Value const* strategies = &doc;
+	if (doc.IsObject() && doc.HasMember("strategies"))
+	{
+		strategies = &doc["strategies"];
+	}
+
+	Vector<SharedPtr<Strategy>> built;
+	HashMap<String, Vector<SharedPtr<AST::StrategyBufferOpNode>>> shared;
+	auto build = [&](rapidjson::Value const& strategy_spec) -> Result<bool, AtlasException>
+	{
+		if (!strategy_spec.IsObject())
+		{
+			return Err(AtlasException("Expected strategy spec object"));
+		}
+		ATLAS_ASSIGN_OR_RETURN(strategy, spec_strategy(strategy_spec, hydra, parent, shared));
+		built.push_back(std::move(strategy));
+		return true;
+	};
+	if (strategies->IsArray())
+	{
+		built.reserve(strategies->Size());
+		for (auto const& strategy_spec : strategies->GetArray())
+		{
+			ATLAS_ASSIGN_OR_RETURN(res, build(strategy_spec));
+		}
+	}
+	else
+	{
+		ATLAS_ASSIGN_OR_RETURN(res, build(*strategies));
+	}
+
+	// every strategy is built and every name checked before the first is
+	// added, so a bad spec leaves the parent untouched. The strategies built
+	// before the error unregister from their exchange when dropped.
+	Set<String> names;
+	for (auto const& strategy : parent->getStrategies())
+	{
+		names.insert(strategy->getName());
+	}
+	for (auto const& strategy : built)
+	{
+		if (!names.insert(strategy->getName()).second)
+		{
+			return Err(AtlasException("Allocator already exists: " + strategy->getName()));
+		}
+	}
+	for (auto const& strategy : built)
+	{
+		// with the names checked only the first add can fail, on an exception
+		// the parent already holds
+		auto res = parent->addStrategy(strategy, false);
+		if (!res)
+		{
+			assert(strategy == built.front());
+			return Err(res.error());
+		}
+	}
+	return built;
+}
+
+
+}
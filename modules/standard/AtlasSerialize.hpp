@@ -30,6 +30,18 @@ namespace Atlas
 ) noexcept;
 
 
+//============================================================================
+// Build strategies from a json spec describing each strategy's AST and add
+// them to parent in a single call, see deserialize_strategies in the source
+// for the format. Observers and triggers are registered with the exchange so
+// equal ones are shared with existing strategies.
+ ATLAS_API Result<Vector<SharedPtr<Strategy>>, AtlasException> deserialize_strategies(
+	String const& spec,
+	Hydra& hydra,
+	SharedPtr<MetaStrategy> parent
+) noexcept;
+
+
 }
 
 namespace Atlas
@@ -79,5 +79,8 @@ class TriggerNode;
 class TradeLimitNode;
 class AllocationWeightNode;
 class AllocationBaseNode;
+class ASTOptimizer;
+class ASTCodegen;
+class NativeLibrary;
 } // namespace AST
 } // namespace Atlas
\ No newline at end of file
@@ -50,7 +50,7 @@ size_t Allocator::getAssetCount() const noexcept {
 }
 
 //============================================================================
-Allocator::~Allocator() noexcept {}
+Allocator::~Allocator() noexcept { m_exchange.unregisterAllocator(this); }
 
 //============================================================================
 Allocator::Allocator(String name, Exchange &exchange,
@@ -49,18 +49,18 @@ protected:
   Exchange &m_exchange;
 
   void takeException(Vector<AtlasException> &exceptions) noexcept;
-  void setException(AtlasException const &exception) noexcept;
+  ATLAS_API void setException(AtlasException const &exception) noexcept;
   Option <AtlasException> getException() noexcept;
   [[nodiscard]] size_t getAssetCount() const noexcept;
   void lateRebalance(
       LinAlg::EigenRef<LinAlg::EigenVectorXd> target_weights_buffer) noexcept;
-  void evaluate(LinAlg::EigenRef<LinAlg::EigenVectorXd> const
-                    &target_weights_buffer) noexcept;
+  ATLAS_API void evaluate(LinAlg::EigenRef<LinAlg::EigenVectorXd> const
+                              &target_weights_buffer) noexcept;
   void validate(
       LinAlg::EigenRef<LinAlg::EigenVectorXd> target_weights_buffer) noexcept;
 
 public:
-  virtual ~Allocator() noexcept;
+  ATLAS_API virtual ~Allocator() noexcept;
   ATLAS_API Allocator(String name, Exchange &exchange,
                       Option<SharedPtr<Allocator>>,
                       double cash_weight) noexcept;
@@ -76,7 +76,8 @@ public:
       LinAlg::EigenRef<LinAlg::EigenVectorXd> target_weights_buffer) noexcept;
   virtual void step(LinAlg::EigenRef<LinAlg::EigenVectorXd>
                         target_weights_buffer) noexcept = 0;
-  [[nodiscard]] Option<SharedPtr<Allocator>> getParent() const noexcept;
+  ATLAS_API [[nodiscard]] Option<SharedPtr<Allocator>>
+  getParent() const noexcept;
   [[nodiscard]] virtual size_t getWarmup() const noexcept = 0;
 
   ATLAS_API [[nodiscard]] Result<bool, AtlasException>
@@ -71,11 +71,12 @@ MetaStrategy::getAllocationBuffer(Allocator const *strategy) const noexcept {
 MetaStrategy::~MetaStrategy() noexcept {}
 
 //============================================================================
-SharedPtr<Allocator> MetaStrategy::pyAddStrategy(SharedPtr<Allocator> allocator,
-                                                 bool replace_if_exists) {
+Result<SharedPtr<Allocator>, AtlasException>
+MetaStrategy::addStrategy(SharedPtr<Allocator> allocator,
+                          bool replace_if_exists) noexcept {
   if (m_impl->strategy_map.contains(allocator->getName())) {
     if (!replace_if_exists) {
-      throw std::runtime_error("Allocator already exists");
+      return Err("Allocator already exists");
     }
     // find the Allocator and replace it in the vector
     auto idx = m_impl->strategy_map[allocator->getName()];
@@ -88,7 +89,7 @@ SharedPtr<Allocator> MetaStrategy::pyAddStrategy(SharedPtr<Allocator> allocator,
   allocator->load();
   auto exception_opt = getException();
   if (exception_opt) {
-		throw std::runtime_error(exception_opt.value().what());
+		return Err(exception_opt.value().what());
 	}
 
   m_impl->strategy_map[allocator->getName()] = m_impl->child_strategies.size();
@@ -106,6 +107,16 @@ SharedPtr<Allocator> MetaStrategy::pyAddStrategy(SharedPtr<Allocator> allocator,
   return m_impl->child_strategies.back();
 }
 
+//============================================================================
+SharedPtr<Allocator> MetaStrategy::pyAddStrategy(SharedPtr<Allocator> allocator,
+                                                 bool replace_if_exists) {
+  auto res = addStrategy(std::move(allocator), replace_if_exists);
+  if (!res) {
+    throw std::runtime_error(res.error().what());
+  }
+  return *res;
+}
+
 //============================================================================
 void MetaStrategy::step() noexcept {
   if (!m_impl->child_strategies.size()) {
@@ -37,9 +37,12 @@ public:
   Vector<SharedPtr<Allocator>> getStrategies() const noexcept;
   ATLAS_API const LinAlg::EigenRef<const LinAlg::EigenVectorXd>
   getAllocationBuffer() const noexcept override;
-  const LinAlg::EigenRef<const LinAlg::EigenVectorXd>
+  ATLAS_API const LinAlg::EigenRef<const LinAlg::EigenVectorXd>
   getAllocationBuffer(Allocator const *strategy) const noexcept;
 
+  ATLAS_API [[nodiscard]] Result<SharedPtr<Allocator>, AtlasException>
+  addStrategy(SharedPtr<Allocator> allocator,
+              bool replace_if_exists = false) noexcept;
   ATLAS_API SharedPtr<Allocator> pyAddStrategy(SharedPtr<Allocator> allocator,
                                                bool replace_if_exists = false);
 };
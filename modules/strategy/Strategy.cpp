@@ -4,6 +4,8 @@
 #include "exchange/Exchange.hpp"
 #include "ast/StrategyNode.hpp"
 #include "ast/Optimize.hpp"
+#include "ast/ASTOptimizer.hpp"
+#include "ast/ASTCodegen.hpp"
 #include "hydra/Commissions.hpp"
 
 #include "strategy/MetaStrategy.hpp"
@@ -20,6 +22,8 @@ public:
   SharedPtr<AST::StrategyNode> m_ast;
   Option<SharedPtr<CommisionManager>> m_commision_manager;
   Option<SharedPtr<AST::StrategyGrid>> m_grid;
+  Vector<String> m_optimizer_report;
+  Option<SharedPtr<AST::NativeLibrary>> m_native = std::nullopt;
 
   StrategyImpl(SharedPtr<AST::StrategyNode> ast) noexcept
       : m_ast(std::move(ast)) {}
@@ -49,6 +53,12 @@ void Strategy::load()  {
 		return;
 	}
   m_impl = std::make_unique<StrategyImpl>(std::move(ast));
+
+  // simplify the AST before the first step, nodes are evaluated every step so
+  // any node folded away here is saved for the lifetime of the strategy
+  AST::ASTOptimizer optimizer(m_exchange);
+  optimizer.optimize(*m_impl->m_ast);
+  m_impl->m_optimizer_report = optimizer.getReport();
   m_impl->m_ast->setTracer(m_tracer);
 }
 
@@ -64,6 +74,112 @@ Strategy::getAllocationBuffer() const noexcept {
   return meta_strategy->getAllocationBuffer(this);
 }
 
+//============================================================================
+Vector<String> const &Strategy::getOptimizerReport() const noexcept {
+  return m_impl->m_optimizer_report;
+}
+
+//============================================================================
+static Option<AST::AllocationNode *>
+signalAllocation(AST::AllocationBaseNode *allocation) noexcept {
+  // fixed allocations have no signal to compile
+  if (allocation->getType() == AST::AllocationType::FIXED) {
+    return std::nullopt;
+  }
+  return static_cast<AST::AllocationNode *>(allocation);
+}
+
+//============================================================================
+Result<String, AtlasException> Strategy::generateNative() const noexcept {
+  auto allocation = signalAllocation(m_impl->m_ast->m_allocation.get());
+  if (!allocation) {
+    return Err("Strategy allocation has no signal");
+  }
+  AST::ASTCodegen codegen(m_exchange);
+  return codegen.generate(*(*allocation)->getExchangeView());
+}
+
+//============================================================================
+Result<bool, AtlasException>
+Strategy::loadNative(String const &library_path) noexcept {
+  // grids swap parameters that are compiled in as constants
+  if (m_impl->m_grid) {
+    return Err("Native strategies can not be used with a grid");
+  }
+  auto allocation = signalAllocation(m_impl->m_ast->m_allocation.get());
+  if (!allocation) {
+    return Err("Strategy allocation has no signal");
+  }
+  auto library = AST::NativeLibrary::load(library_path);
+  if (!library) {
+    return Err(library.error().what());
+  }
+  (*allocation)->setNativeLibrary(*library);
+  m_impl->m_native = std::move(*library);
+  return true;
+}
+
+//============================================================================
+Result<bool, AtlasException>
+Strategy::compileNative(String const &library_path,
+                        String const &include_dir, Option<String> compiler,
+                        Option<Vector<String>> flags) noexcept {
+  auto source = generateNative();
+  if (!source) {
+    return Err(source.error().what());
+  }
+  auto native_compiler = AST::NativeCompiler::platformDefault();
+  if (compiler) {
+    native_compiler.compiler = std::move(*compiler);
+  }
+  if (flags) {
+    native_compiler.flags = std::move(*flags);
+  }
+  auto res = AST::ASTCodegen::compile(*source, library_path, include_dir,
+                                      native_compiler);
+  if (!res) {
+    return res;
+  }
+  return loadNative(library_path);
+}
+
+//============================================================================
+void Strategy::unloadNative() noexcept {
+  if (auto allocation = signalAllocation(m_impl->m_ast->m_allocation.get())) {
+    (*allocation)->setNativeLibrary(std::nullopt);
+  }
+  m_impl->m_native = std::nullopt;
+}
+
+//============================================================================
+String Strategy::pyGenerateNative() const {
+  auto res = generateNative();
+  if (!res) {
+    throw std::runtime_error(res.error().what());
+  }
+  return *res;
+}
+
+//============================================================================
+void Strategy::pyLoadNative(String const &library_path) {
+  auto res = loadNative(library_path);
+  if (!res) {
+    throw std::runtime_error(res.error().what());
+  }
+}
+
+//============================================================================
+void Strategy::pyCompileNative(String const &library_path,
+                               String const &include_dir,
+                               Option<String> compiler,
+                               Option<Vector<String>> flags) {
+  auto res = compileNative(library_path, include_dir, std::move(compiler),
+                           std::move(flags));
+  if (!res) {
+    throw std::runtime_error(res.error().what());
+  }
+}
+
 //============================================================================
 Option<SharedPtr<AST::StrategyGrid>> Strategy::getGrid() const noexcept {
   return m_impl->m_grid;
@@ -78,8 +194,15 @@ Strategy::setGridDimmensions(
   if (m_impl->m_grid) {
     return Err("Grid already set");
   }
-  m_impl->m_grid = std::make_shared<AST::StrategyGrid>(
-      this, m_exchange, std::move(dimensions), grid_type);
+  if (m_impl->m_native) {
+    return Err("Grid can not be set on a native strategy");
+  }
+  auto grid = AST::StrategyGrid::make(this, m_exchange, std::move(dimensions),
+                                      grid_type);
+  if (!grid) {
+    return Err(grid.error().what());
+  }
+  m_impl->m_grid = std::move(*grid);
   return m_impl->m_grid.value();
 }
 
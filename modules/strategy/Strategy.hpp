@@ -55,6 +55,28 @@ public:
   getGrid() const noexcept;
   [[nodiscard]] ATLAS_API SharedPtr<CommisionManager>
   initCommissionManager() noexcept;
+  [[nodiscard]] ATLAS_API Vector<String> const &
+  getOptimizerReport() const noexcept;
+
+  // emit C++ source for the strategy's signal, see AST::ASTCodegen
+  [[nodiscard]] ATLAS_API Result<String, AtlasException>
+  generateNative() const noexcept;
+  // evaluate the signal with the atlas_signal function of a compiled
+  // library instead of the AST. unloadNative returns to the AST.
+  [[nodiscard]] ATLAS_API Result<bool, AtlasException>
+  loadNative(String const &library_path) noexcept;
+  // compiler and flags default to AST::NativeCompiler::platformDefault
+  [[nodiscard]] ATLAS_API Result<bool, AtlasException>
+  compileNative(String const &library_path, String const &include_dir,
+                Option<String> compiler = std::nullopt,
+                Option<Vector<String>> flags = std::nullopt) noexcept;
+  ATLAS_API void unloadNative() noexcept;
+  ATLAS_API String pyGenerateNative() const;
+  ATLAS_API void pyLoadNative(String const &library_path);
+  ATLAS_API void pyCompileNative(String const &library_path,
+                                 String const &include_dir,
+                                 Option<String> compiler = std::nullopt,
+                                 Option<Vector<String>> flags = std::nullopt);
 
   ATLAS_API
   [[nodiscard]] Result<SharedPtr<AST::StrategyGrid const>, AtlasException>
@@ -69,4 +91,25 @@ public:
       Option<GridType> grid_type = std::nullopt);
 };
 
+//============================================================================
+/// <summary>
+/// Strategy over an AST built before construction, used by strategies loaded
+/// from a declarative spec where there is no Python subclass to build it
+/// </summary>
+class SpecStrategy final : public Strategy {
+private:
+  SharedPtr<AST::StrategyNode> m_ast;
+
+public:
+  ATLAS_API SpecStrategy(String name, SharedPtr<Exchange> exchange,
+                         SharedPtr<Allocator> parent, double portfolio_weight,
+                         SharedPtr<AST::StrategyNode> ast) noexcept
+      : Strategy(std::move(name), std::move(exchange), std::move(parent),
+                 portfolio_weight),
+        m_ast(std::move(ast)) {}
+  ATLAS_API SharedPtr<AST::StrategyNode> loadAST() noexcept override {
+    return m_ast;
+  }
+};
+
 } // namespace Atlas
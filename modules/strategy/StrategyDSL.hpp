@@ -0,0 +1,454 @@
+#pragma once
+#ifdef ATLAS_EXPORTS
+#define ATLAS_API __declspec(dllexport)
+#else
+#define ATLAS_API __declspec(dllimport)
+#endif
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <functional>
+#include <numeric>
+
+#include "standard/AtlasCore.hpp"
+#include "standard/AtlasLinAlg.hpp"
+#include "exchange/Exchange.hpp"
+#include "strategy/Allocator.hpp"
+#include "strategy/MetaStrategy.hpp"
+
+//============================================================================
+// Compile time strategy expressions for C++ embedders. A strategy is composed
+// from value types, i.e.
+//
+//   using namespace Atlas::DSL;
+//   auto change = (Read<"close">() - Read<"close", -1>()) / Read<"close", -1>();
+//   auto strategy = makeStrategy("momentum", exchange, meta, 1.0,
+//                                Uniform(NLargest(Mean(change, 20), 10)));
+//   meta->addStrategy(strategy);
+//
+// The whole expression is a single object, evaluating it allocates nothing
+// and involves no virtual calls. Buffers held by stateful expressions are
+// sized once when the strategy is loaded.
+//============================================================================
+
+namespace Atlas {
+
+namespace DSL {
+
+//============================================================================
+template <size_t N> struct FixedString {
+  char value[N];
+
+  constexpr FixedString(char const (&str)[N]) noexcept {
+    std::copy_n(str, N, value);
+  }
+  [[nodiscard]] String str() const { return String(value, N - 1); }
+};
+
+//============================================================================
+// An expression computes one value per asset at the current exchange step.
+// bind resolves names against the exchange and sizes any state, step
+// advances stateful expressions by one exchange step, and eval returns the
+// current value as an Eigen array expression over the assets.
+template <typename T>
+concept Expression = requires(T t, T const ct, Exchange &exchange) {
+  { t.bind(exchange) } -> std::same_as<Result<bool, AtlasException>>;
+  { ct.warmup() } -> std::convertible_to<size_t>;
+  t.step(exchange);
+  t.reset();
+  ct.eval(exchange);
+};
+
+//============================================================================
+template <FixedString Column, int RowOffset = 0> class Read {
+private:
+  size_t m_column = 0;
+
+public:
+  Result<bool, AtlasException> bind(Exchange &exchange) noexcept {
+    auto column = exchange.getColumnIndex(Column.str());
+    if (!column) {
+      return Err<AtlasException>("Column not found: " + Column.str());
+    }
+    m_column = *column;
+    return true;
+  }
+  [[nodiscard]] size_t warmup() const noexcept {
+    return static_cast<size_t>(std::abs(RowOffset));
+  }
+  void step(Exchange &) noexcept {}
+  void reset() noexcept {}
+  [[nodiscard]] auto eval(Exchange const &exchange) const noexcept {
+    return exchange.getSlice(m_column, RowOffset).array();
+  }
+};
+
+//============================================================================
+template <Expression Left, Expression Right, typename Op> class Binary {
+private:
+  Left m_left;
+  Right m_right;
+
+public:
+  constexpr Binary(Left left, Right right) noexcept
+      : m_left(std::move(left)), m_right(std::move(right)) {}
+
+  Result<bool, AtlasException> bind(Exchange &exchange) noexcept {
+    auto res = m_left.bind(exchange);
+    if (!res) {
+      return res;
+    }
+    return m_right.bind(exchange);
+  }
+  [[nodiscard]] size_t warmup() const noexcept {
+    return std::max<size_t>(m_left.warmup(), m_right.warmup());
+  }
+  void step(Exchange &exchange) noexcept {
+    m_left.step(exchange);
+    m_right.step(exchange);
+  }
+  void reset() noexcept {
+    m_left.reset();
+    m_right.reset();
+  }
+  [[nodiscard]] auto eval(Exchange const &exchange) const noexcept {
+    return m_left.eval(exchange).binaryExpr(m_right.eval(exchange), Op{});
+  }
+};
+
+//============================================================================
+template <Expression Inner, typename Op> class Unary {
+private:
+  Inner m_inner;
+  double m_param;
+
+public:
+  constexpr Unary(Inner inner, double param = 0.0) noexcept
+      : m_inner(std::move(inner)), m_param(param) {}
+
+  Result<bool, AtlasException> bind(Exchange &exchange) noexcept {
+    return m_inner.bind(exchange);
+  }
+  [[nodiscard]] size_t warmup() const noexcept { return m_inner.warmup(); }
+  void step(Exchange &exchange) noexcept { m_inner.step(exchange); }
+  void reset() noexcept { m_inner.reset(); }
+  [[nodiscard]] auto eval(Exchange const &exchange) const noexcept {
+    return m_inner.eval(exchange).unaryExpr(
+        [param = m_param](double x) { return Op{}(x, param); });
+  }
+};
+
+//============================================================================
+template <typename Cmp> struct CompareOp {
+  double operator()(double a, double b) const noexcept {
+    return Cmp{}(a, b) ? 1.0 : 0.0;
+  }
+};
+struct AbsOp {
+  double operator()(double x, double) const noexcept { return std::abs(x); }
+};
+struct LogOp {
+  double operator()(double x, double) const noexcept { return std::log(x); }
+};
+struct PowOp {
+  double operator()(double x, double p) const noexcept {
+    return std::pow(x, p);
+  }
+};
+struct SignOp {
+  double operator()(double x, double) const noexcept {
+    return static_cast<double>((0.0 < x) - (x < 0.0));
+  }
+};
+
+//============================================================================
+template <Expression L, Expression R> constexpr auto operator+(L l, R r) {
+  return Binary<L, R, std::plus<double>>(std::move(l), std::move(r));
+}
+template <Expression L, Expression R> constexpr auto operator-(L l, R r) {
+  return Binary<L, R, std::minus<double>>(std::move(l), std::move(r));
+}
+template <Expression L, Expression R> constexpr auto operator*(L l, R r) {
+  return Binary<L, R, std::multiplies<double>>(std::move(l), std::move(r));
+}
+template <Expression L, Expression R> constexpr auto operator/(L l, R r) {
+  return Binary<L, R, std::divides<double>>(std::move(l), std::move(r));
+}
+template <Expression L, Expression R> constexpr auto operator>(L l, R r) {
+  return Binary<L, R, CompareOp<std::greater<double>>>(std::move(l),
+                                                       std::move(r));
+}
+template <Expression L, Expression R> constexpr auto operator<(L l, R r) {
+  return Binary<L, R, CompareOp<std::less<double>>>(std::move(l),
+                                                    std::move(r));
+}
+template <Expression E> constexpr auto operator+(E e, double s) {
+  return Unary<E, std::plus<double>>(std::move(e), s);
+}
+template <Expression E> constexpr auto operator-(E e, double s) {
+  return Unary<E, std::minus<double>>(std::move(e), s);
+}
+template <Expression E> constexpr auto operator*(E e, double s) {
+  return Unary<E, std::multiplies<double>>(std::move(e), s);
+}
+template <Expression E> constexpr auto operator/(E e, double s) {
+  return Unary<E, std::divides<double>>(std::move(e), s);
+}
+template <Expression E> constexpr auto abs(E e) {
+  return Unary<E, AbsOp>(std::move(e));
+}
+template <Expression E> constexpr auto log(E e) {
+  return Unary<E, LogOp>(std::move(e));
+}
+template <Expression E> constexpr auto sign(E e) {
+  return Unary<E, SignOp>(std::move(e));
+}
+template <Expression E> constexpr auto pow(E e, double p) {
+  return Unary<E, PowOp>(std::move(e), p);
+}
+
+//============================================================================
+// rolling mean of an expression over a fixed window, the observer
+// equivalent of the AST's mean observer
+template <Expression Inner> class Mean {
+private:
+  Inner m_inner;
+  size_t m_window;
+  size_t m_slot = 0;
+  LinAlg::EigenMatrixXd m_history;
+  LinAlg::EigenVectorXd m_sum;
+  LinAlg::EigenVectorXd m_value;
+
+public:
+  constexpr Mean(Inner inner, size_t window) noexcept
+      : m_inner(std::move(inner)), m_window(std::max<size_t>(window, 1)) {}
+
+  Result<bool, AtlasException> bind(Exchange &exchange) noexcept {
+    size_t assets = exchange.getAssetCount();
+    m_history.setZero(assets, m_window);
+    m_sum.setZero(assets);
+    m_value.setZero(assets);
+    return m_inner.bind(exchange);
+  }
+  [[nodiscard]] size_t warmup() const noexcept {
+    return m_inner.warmup() + m_window - 1;
+  }
+  void step(Exchange &exchange) noexcept {
+    m_inner.step(exchange);
+    if (exchange.currentIdx() < m_inner.warmup()) {
+      return;
+    }
+    auto column = m_history.col(m_slot);
+    m_sum -= column;
+    column = m_inner.eval(exchange).matrix();
+    m_sum += column;
+    m_slot = (m_slot + 1) % m_window;
+    m_value = m_sum / static_cast<double>(m_window);
+  }
+  void reset() noexcept {
+    m_inner.reset();
+    m_slot = 0;
+    m_history.setZero();
+    m_sum.setZero();
+    m_value.setZero();
+  }
+  [[nodiscard]] auto eval(Exchange const &) const noexcept {
+    return m_value.array();
+  }
+};
+
+//============================================================================
+// keep the count largest or smallest non NaN values across assets, every
+// other asset is NaN. The selection buffers are sized once in bind.
+template <Expression Inner, bool Largest> class Rank {
+private:
+  Inner m_inner;
+  size_t m_count;
+  Vector<size_t> m_indices;
+  LinAlg::EigenVectorXd m_value;
+
+public:
+  constexpr Rank(Inner inner, size_t count) noexcept
+      : m_inner(std::move(inner)), m_count(count) {}
+
+  Result<bool, AtlasException> bind(Exchange &exchange) noexcept {
+    size_t assets = exchange.getAssetCount();
+    if (m_count == 0 || m_count > assets) {
+      return Err<AtlasException>("Rank count must be in [1, asset count]");
+    }
+    m_indices.reserve(assets);
+    m_value.setZero(assets);
+    return m_inner.bind(exchange);
+  }
+  [[nodiscard]] size_t warmup() const noexcept { return m_inner.warmup(); }
+  void step(Exchange &exchange) noexcept {
+    m_inner.step(exchange);
+    if (exchange.currentIdx() < m_inner.warmup()) {
+      return;
+    }
+    m_value = m_inner.eval(exchange).matrix();
+    m_indices.clear();
+    for (size_t i = 0; i < static_cast<size_t>(m_value.size()); ++i) {
+      if (!std::isnan(m_value(i))) {
+        m_indices.push_back(i);
+      }
+    }
+    if (m_indices.size() <= m_count) {
+      return;
+    }
+    auto nth = m_indices.begin() + m_count;
+    std::nth_element(m_indices.begin(), nth, m_indices.end(),
+                     [this](size_t a, size_t b) {
+                       return Largest ? m_value(a) > m_value(b)
+                                      : m_value(a) < m_value(b);
+                     });
+    for (auto it = nth; it != m_indices.end(); ++it) {
+      m_value(*it) = std::numeric_limits<double>::quiet_NaN();
+    }
+  }
+  void reset() noexcept {
+    m_inner.reset();
+    m_value.setZero();
+  }
+  [[nodiscard]] auto eval(Exchange const &) const noexcept {
+    return m_value.array();
+  }
+};
+
+template <Expression E> constexpr auto NLargest(E e, size_t count) {
+  return Rank<E, true>(std::move(e), count);
+}
+template <Expression E> constexpr auto NSmallest(E e, size_t count) {
+  return Rank<E, false>(std::move(e), count);
+}
+
+//============================================================================
+// equal weight to every asset with a non NaN signal, matching
+// AllocationType::UNIFORM
+template <Expression Signal> class Uniform {
+private:
+  Signal m_signal;
+
+public:
+  constexpr Uniform(Signal signal) noexcept : m_signal(std::move(signal)) {}
+
+  Result<bool, AtlasException> bind(Exchange &exchange) noexcept {
+    return m_signal.bind(exchange);
+  }
+  [[nodiscard]] size_t warmup() const noexcept { return m_signal.warmup(); }
+  void step(Exchange &exchange) noexcept { m_signal.step(exchange); }
+  void reset() noexcept { m_signal.reset(); }
+  void allocate(Exchange const &exchange,
+                LinAlg::EigenRef<LinAlg::EigenVectorXd> target) noexcept {
+    target = m_signal.eval(exchange).matrix();
+    double count =
+        static_cast<double>((target.array() == target.array()).count());
+    double c = count > 0 ? 1.0 / count : 0.0;
+    for (auto &weight : target) {
+      weight = std::isnan(weight) ? 0.0 : c;
+    }
+  }
+};
+
+//============================================================================
+// long assets with a signal above the threshold and short those below,
+// matching AllocationType::CONDITIONAL_SPLIT
+template <Expression Signal> class ConditionalSplit {
+private:
+  Signal m_signal;
+  double m_threshold;
+
+public:
+  constexpr ConditionalSplit(Signal signal, double threshold) noexcept
+      : m_signal(std::move(signal)), m_threshold(threshold) {}
+
+  Result<bool, AtlasException> bind(Exchange &exchange) noexcept {
+    return m_signal.bind(exchange);
+  }
+  [[nodiscard]] size_t warmup() const noexcept { return m_signal.warmup(); }
+  void step(Exchange &exchange) noexcept { m_signal.step(exchange); }
+  void reset() noexcept { m_signal.reset(); }
+  void allocate(Exchange const &exchange,
+                LinAlg::EigenRef<LinAlg::EigenVectorXd> target) noexcept {
+    target = m_signal.eval(exchange).matrix();
+    double count =
+        static_cast<double>((target.array() == target.array()).count());
+    double c = count > 0 ? 1.0 / count : 0.0;
+    for (auto &weight : target) {
+      if (weight > m_threshold) {
+        weight = c;
+      } else if (weight < m_threshold) {
+        weight = -c;
+      } else {
+        weight = 0.0;
+      }
+    }
+  }
+};
+
+//============================================================================
+// an allocator evaluating a compile time expression, added to a MetaStrategy
+// next to AST strategies
+template <typename Allocation> class StaticStrategy final : public Allocator {
+private:
+  Allocation m_allocation;
+
+  void step(LinAlg::EigenRef<LinAlg::EigenVectorXd>
+                target_weights_buffer) noexcept override {
+    // update the portfolio with the market returns of the step, then advance
+    // the stateful expressions even during warmup so their windows fill
+    evaluate(target_weights_buffer);
+    m_step_call = false;
+    m_allocation.step(m_exchange);
+    if (m_exchange.currentIdx() < m_allocation.warmup()) {
+      // no allocation this step, let the held weights drift with the asset
+      // returns as Strategy::step does when its AST takes no action
+      lateRebalance(target_weights_buffer);
+      return;
+    }
+    m_allocation.allocate(m_exchange, target_weights_buffer);
+  }
+  void reset() noexcept override { m_allocation.reset(); }
+  void load() override {
+    auto res = m_allocation.bind(m_exchange);
+    if (!res) {
+      setException(res.error());
+    }
+  }
+  void enableCopyWeightsBuffer() noexcept override {}
+  [[nodiscard]] size_t getWarmup() const noexcept override {
+    return m_allocation.warmup();
+  }
+
+public:
+  StaticStrategy(String name, SharedPtr<Exchange> exchange,
+                 SharedPtr<Allocator> parent, double portfolio_weight,
+                 Allocation allocation) noexcept
+      : Allocator(std::move(name), *exchange, parent, portfolio_weight),
+        m_allocation(std::move(allocation)) {
+    m_portfolio_weight = portfolio_weight;
+  }
+
+  const LinAlg::EigenRef<const LinAlg::EigenVectorXd>
+  getAllocationBuffer() const noexcept override {
+    auto parent = getParent();
+    assert(parent);
+    auto meta_strategy = static_cast<MetaStrategy *>(parent.value().get());
+    return meta_strategy->getAllocationBuffer(this);
+  }
+};
+
+//============================================================================
+template <typename Allocation>
+SharedPtr<StaticStrategy<Allocation>>
+makeStrategy(String name, SharedPtr<Exchange> exchange,
+             SharedPtr<Allocator> parent, double portfolio_weight,
+             Allocation allocation) {
+  return std::make_shared<StaticStrategy<Allocation>>(
+      std::move(name), std::move(exchange), std::move(parent),
+      portfolio_weight, std::move(allocation));
+}
+
+} // namespace DSL
+
+} // namespace Atlas